@@ -155,6 +155,73 @@ sint8 ipc_queue_push(struct ipc_queue *queue, const void *buf)
 	return err;
 }
 
+sint8 ipc_queue_push_multi(struct ipc_queue *queue, const void *buf,
+		uint16 num)
+{
+	uint32 write; /* cache write index for thread-safety */
+	uint32 read; /* cache read index for thread-safety */
+	uint32 used;
+	uint16 i;
+	const uint8 *src = (const uint8 *)buf;
+	void *dst;
+	sint8 err = -IPC_SHM_E_INVAL;
+
+	if ((queue != NULL) && (buf != NULL) && (num != 0u)) {
+		write = queue->push_ring->write;
+
+		/* read indexes of push/pop rings are swapped (interference freedom) */
+		read = queue->pop_ring->read;
+
+		if ((read >= queue->elem_num) || (write >= queue->elem_num)) {
+			/* Check if read and write are valid value */
+			err = -IPC_SHM_E_INVAL;
+		} else {
+			used = ((write + queue->elem_num) - read) % queue->elem_num;
+
+			/* check if queue has room for all elements (1 sentinel) */
+			if ((used + num) >= queue->elem_num) {
+				err = -IPC_SHM_E_NOMEM;
+			} else {
+				/* copy all elements before publishing them */
+				for (i = 0u; i < num; i++) {
+					dst = &queue->push_ring->data[write * queue->elem_size];
+					ipc_memcpy(dst, &src[i * queue->elem_size],
+							queue->elem_size);
+					write = (write + 1u) % queue->elem_num;
+				}
+
+				/* publish all elements with a single write index update */
+				queue->push_ring->write = write;
+
+				err = IPC_SHM_E_OK;
+			}
+		}
+	}
+
+	return err;
+}
+
+uint16 ipc_queue_count(struct ipc_queue *queue)
+{
+	uint32 write; /* cache write index for thread-safety */
+	uint32 read; /* cache read index for thread-safety */
+	uint16 count = 0u;
+
+	if ((queue != NULL) && (queue->elem_num != 0u)) {
+		write = queue->pop_ring->write;
+
+		/* read indexes of push/pop rings are swapped (interference freedom) */
+		read = queue->push_ring->read;
+
+		if ((read < queue->elem_num) && (write < queue->elem_num)) {
+			count = (uint16)(((write + queue->elem_num) - read)
+					% queue->elem_num);
+		}
+	}
+
+	return count;
+}
+
 /**
  * ipc_queue_sync_index() - synchronize queue read/write index with remote memory
  * @queue:                  [IN] queue pointer
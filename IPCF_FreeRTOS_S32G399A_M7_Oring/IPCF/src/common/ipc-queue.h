@@ -129,6 +129,22 @@ void ipc_queue_free(struct ipc_queue *queue);
 sint8 ipc_queue_push(struct ipc_queue *queue, const void *buf);
 
 
+/**
+ * ipc_queue_push_multi() - pushes several elements into the queue at once
+ * @queue:            [IN] queue pointer
+ * @buf:              [IN] pointer to array of elements to be pushed
+ * @num:              [IN] number of elements
+ *
+ * All elements are copied into the push ring before the write index is
+ * updated, so remote pops either none or all of them are visible to it.
+ * Nothing is pushed if the queue doesn't have room for all elements.
+ *
+ * Return:	IPC_SHM_E_OK on success, error code otherwise
+ */
+sint8 ipc_queue_push_multi(struct ipc_queue *queue, const void *buf,
+		uint16 num);
+
+
 /**
  * ipc_queue_pop() - removes element from queue
  * @queue:           [IN] queue pointer
@@ -142,6 +158,19 @@ sint8 ipc_queue_push(struct ipc_queue *queue, const void *buf);
 sint8 ipc_queue_pop(struct ipc_queue *queue, void *buf);
 
 
+/**
+ * ipc_queue_count() - number of elements available to be popped
+ * @queue:           [IN] queue pointer
+ *
+ * Non-destructive snapshot of the pop ring occupancy. Since the pop ring write
+ * index is owned by remote, the result is a lower bound that can only grow
+ * until the next local pop operation.
+ *
+ * Return:	number of elements in pop ring, 0 if queue is invalid
+ */
+uint16 ipc_queue_count(struct ipc_queue *queue);
+
+
 /**
  * ipc_queue_check_integrity() - check if the sentinel was not overwritten
  * @queue:	[IN] queue pointer
@@ -20,6 +20,7 @@ extern "C"{
 #include "ipc-os.h"
 #include "ipc-hw.h"
 #include "ipc-queue.h"
+#include "ipc-util.h"
 
 /*
  * SOURCE FILE VERSION INFORMATION
@@ -103,6 +104,23 @@ extern "C"{
 #error "Software Version Numbers of ipc-shm.c and ipc-queue.h are different"
 #endif
 
+/* Check if ipc-shm.c file and ipc-util.h file are of the same vendor */
+#if (IPC_SHM_VENDOR_ID_C != IPC_UTIL_VENDOR_ID)
+	#error "ipc-shm.c and ipc-util.h have different vendor IDs"
+#endif
+/* Check if ipc-shm.c file and ipc-util.h file are of the same Autosar version */
+#if ((IPC_SHM_AR_RELEASE_MAJOR_VERSION_C != IPC_UTIL_AR_RELEASE_MAJOR_VERSION) || \
+	(IPC_SHM_AR_RELEASE_MINOR_VERSION_C != IPC_UTIL_AR_RELEASE_MINOR_VERSION) || \
+	(IPC_SHM_AR_RELEASE_REVISION_VERSION_C != IPC_UTIL_AR_RELEASE_REVISION_VERSION))
+	#error "AutoSar Version Numbers of ipc-shm.c and ipc-util.h are different"
+#endif
+/* Check if ipc-shm.c file and ipc-util.h file are of the same software version */
+#if ((IPC_SHM_SW_MAJOR_VERSION_C != IPC_UTIL_SW_MAJOR_VERSION) || \
+	(IPC_SHM_SW_MINOR_VERSION_C != IPC_UTIL_SW_MINOR_VERSION) || \
+	(IPC_SHM_SW_PATCH_VERSION_C != IPC_UTIL_SW_PATCH_VERSION))
+#error "Software Version Numbers of ipc-shm.c and ipc-util.h are different"
+#endif
+
 /* magic number to indicate the driver is initialized */
 #define IPC_SHM_STATE_READY 0x3252455646435049ULL
 #define IPC_SHM_STATE_CLEAR 0u
@@ -112,6 +130,14 @@ extern "C"{
 /* Indicates that the unmanaged channel initialization is done */
 #define IPC_UCHAN_INIT_DONE              0x55435049UL
 
+/*
+ * BD data_size flag telling that next BD in channel queue continues the message.
+ * Remote driver must know this flag: a driver without chain support (e.g. the
+ * stock A53 Linux ipc-shm) misreads it as part of the data size, so
+ * ipc_shm_tx_chain() may only be used when the A53 side has matching support.
+ */
+#define IPC_SHM_BD_CHAIN_MORE  0x80000000UL
+
 /* flag telling if buffer is from remote OS */
 #define IPC_BUFFER_FROM_LOCAL  0u
 #define IPC_BUFFER_FROM_REMOTE 1u
@@ -159,6 +185,8 @@ struct ipc_shm_bd {
  * @local_pool_addr:  address of local buffer pool
  * @remote_pool_addr: address of remote buffer pool
  * @bd_queue:         queue containing BDs of free buffers
+ * @num_spare:        number of acquired local buffers given back unused
+ * @spare_ids:        ids of those buffers, reused before popping bd_queue
  *
  * bd_queue has two rings: one for pushing BDs (release ring) and one for
  * popping BDs (acquire ring).
@@ -178,6 +206,8 @@ struct ipc_shm_pool {
 	uintptr local_pool_addr;
 	uintptr remote_pool_addr;
 	struct ipc_queue bd_queue;
+	uint16 num_spare;
+	uint16 spare_ids[IPC_SHM_MAX_SPARE_BUFS];
 };
 
 /**
@@ -187,6 +217,11 @@ struct ipc_shm_pool {
  * @pools:     buffer pools private data
  * @rx_cb:     receive callback
  * @cb_arg:    optional receive callback argument
+ * @rx_batch_cb:   optional batched receive callback (replaces rx_cb)
+ * @rx_chain_cb:   optional chained message receive callback
+ * @credit_cb:     tx credits replenished callback
+ * @credit_cb_arg: optional tx credits callback argument
+ * @credit_size:   buffer size the sender is waiting for (0 when not armed)
  *
  * bd_queue has two rings: one for pushing BDs (Tx ring) and one for popping
  * BDs (Rx ring).
@@ -204,6 +239,14 @@ struct ipc_managed_channel {
 	void (*rx_cb)(void *cb_arg, const uint8 instance, uint8 chan_id,
 			void *buf, uint32 size);
 	void *cb_arg;
+	void (*rx_batch_cb)(void *cb_arg, const uint8 instance, uint8 chan_id,
+			const struct ipc_shm_buf *bufs, uint32 num_bufs);
+	void (*rx_chain_cb)(void *cb_arg, const uint8 instance, uint8 chan_id,
+			const struct ipc_shm_chain *chain);
+	void (*credit_cb)(void *cb_arg, const uint8 instance, uint8 chan_id,
+			uint32 credits);
+	void *credit_cb_arg;
+	volatile uint32 credit_size;
 };
 
 /**
@@ -273,12 +316,20 @@ struct ipc_shm_global {
  * @num_channels: number of shared memory channels
  * @channels:     ipc channels private data
  * @global:       local global data shared with remote
+ * @rx_batch:     buffers collected for batched receive callbacks
+ * @rx_chain:     chained message being received
+ *
+ * Rx of an instance is done either from softirq or from polling, never both,
+ * and channels are processed one at a time, so one batch array per instance is
+ * enough and keeps it off the softirq stack.
  */
 struct ipc_shm_priv {
 	uint32 shm_size;
 	uint8 num_channels;
 	struct ipc_shm_channel channels[IPC_SHM_MAX_CHANNELS];
 	struct ipc_shm_global *global;
+	struct ipc_shm_buf rx_batch[IPC_SHM_RX_BATCH_SIZE];
+	struct ipc_shm_chain rx_chain;
 };
 
 /* ipc shm private data */
@@ -374,6 +425,227 @@ static sint8 ipc_check_mchan_integrity(struct ipc_managed_channel *mchan)
 	return err;
 }
 
+/**
+ * ipc_mchan_count_credits() - count Tx credits advertised by remote
+ * @chan:     managed channel private data
+ * @mem_size: minimum buffer size a credit must cover
+ *
+ * Remote advertises Tx credits by pushing BDs of free buffers into the pool
+ * release rings (our acquire rings) when it finishes processing a received
+ * buffer, so the credits of a pool are the number of BDs pending in its
+ * acquire ring. Only pools that accommodate mem_size are counted.
+ *
+ * Return: number of buffers that can be acquired without failure
+ */
+static uint32 ipc_mchan_count_credits(struct ipc_managed_channel *chan,
+		uint32 mem_size)
+{
+	uint32 credits = 0u;
+	uint16 pool_id;
+
+	for (pool_id = 0; pool_id < chan->num_pools; pool_id++) {
+		/* check if pool buf size covers the requested size */
+		if (mem_size > chan->pools[pool_id].buf_size)
+			continue;
+
+		credits += ipc_queue_count(&chan->pools[pool_id].bd_queue)
+			+ chan->pools[pool_id].num_spare;
+	}
+
+	return credits;
+}
+
+/**
+ * ipc_mchan_arm_credit_cb() - request notification when credits are available
+ * @chan:     managed channel private data
+ * @mem_size: buffer size the sender is waiting for
+ *
+ * Keeps the smallest requested size so that every waiting sender is notified.
+ */
+static void ipc_mchan_arm_credit_cb(struct ipc_managed_channel *chan,
+		uint32 mem_size)
+{
+	uint32 armed_size = chan->credit_size;
+
+	if ((chan->credit_cb != NULL) && (mem_size != 0u)
+			&& ((armed_size == 0u) || (mem_size < armed_size))) {
+		chan->credit_size = mem_size;
+	}
+}
+
+/**
+ * ipc_mchan_credit_check() - notify sender waiting for Tx credits of a channel
+ * @instance: instance id
+ * @chan:     managed channel private data
+ * @chan_id:  channel index
+ *
+ * A credit callback is invoked once per arming, then the channel is disarmed
+ * until the next failed acquire or empty credits query.
+ */
+static void ipc_mchan_credit_check(const uint8 instance,
+		struct ipc_managed_channel *chan, uint8 chan_id)
+{
+	uint32 armed_size = chan->credit_size;
+	uint32 credits;
+
+	if ((armed_size != 0u) && (chan->credit_cb != NULL)) {
+		credits = ipc_mchan_count_credits(chan, armed_size);
+		if (credits != 0u) {
+			/* disarm before calling back so the callback can re-arm */
+			chan->credit_size = 0u;
+			chan->credit_cb(chan->credit_cb_arg, instance, chan_id,
+					credits);
+		}
+	}
+}
+
+/**
+ * ipc_shm_credit_check() - notify senders waiting for Tx credits
+ * @instance: instance id
+ *
+ * Called from Rx softirq after remote cache lines have been invalidated.
+ */
+static void ipc_shm_credit_check(const uint8 instance)
+{
+	struct ipc_shm_channel *chan;
+	uint8 chan_id;
+
+	for (chan_id = 0; chan_id < ipc_shm_priv_data[instance].num_channels; chan_id++) {
+		chan = &ipc_shm_priv_data[instance].channels[chan_id];
+		if (chan->type != IPC_SHM_MANAGED)
+			continue;
+
+		ipc_mchan_credit_check(instance, &chan->ch.mng, chan->id);
+	}
+}
+
+/**
+ * ipc_bd_to_remote_buf() - get remote buffer address described by a BD
+ * @instance: instance id
+ * @mchan:    managed channel private data
+ * @bd:       buffer descriptor popped from channel queue
+ *
+ * Return: buffer address or NULL if BD doesn't describe a valid buffer
+ */
+static void *ipc_bd_to_remote_buf(const uint8 instance,
+		struct ipc_managed_channel *mchan, const struct ipc_shm_bd *bd)
+{
+	struct ipc_shm_pool *pool;
+	uintptr buf_addr = (uintptr)NULL;
+
+	if ((bd->pool_id < mchan->num_pools)
+			&& (bd->buf_id < mchan->pools[bd->pool_id].num_bufs)) {
+		pool = &mchan->pools[bd->pool_id];
+		buf_addr = pool->remote_pool_addr + (pool->buf_size * bd->buf_id);
+
+		/* check if buf_addr is valid */
+		if ((buf_addr < ipc_os_get_remote_shm(instance)) ||
+			((buf_addr + pool->buf_size) > (ipc_os_get_remote_shm(instance) +
+			ipc_shm_priv_data[instance].shm_size))) {
+			buf_addr = (uintptr)NULL;
+		}
+	}
+
+	return (void *)buf_addr;
+}
+
+/**
+ * ipc_channel_rx_deliver() - deliver a received buffer to application
+ * @instance:    instance id
+ * @chan:        channel private data
+ * @buf:         received buffer
+ * @size:        size of data written in buffer
+ * @num_batched: number of buffers pending in instance batch array
+ *
+ * Calls rx_cb directly or adds buffer to batch, delivering full batches.
+ */
+static void ipc_channel_rx_deliver(const uint8 instance,
+		const struct ipc_shm_channel *chan, void *buf, uint32 size,
+		uint32 *num_batched)
+{
+	const struct ipc_managed_channel *mchan = &chan->ch.mng;
+	struct ipc_shm_buf *batch = ipc_shm_priv_data[instance].rx_batch;
+
+	if (mchan->rx_batch_cb == NULL) {
+		mchan->rx_cb(mchan->cb_arg, instance, chan->id, buf, size);
+	} else {
+		batch[*num_batched].buf = buf;
+		batch[*num_batched].size = size;
+		(*num_batched)++;
+
+		/* deliver a full batch and start a new one */
+		if (*num_batched == IPC_SHM_RX_BATCH_SIZE) {
+			mchan->rx_batch_cb(mchan->cb_arg, instance, chan->id,
+				batch, *num_batched);
+			*num_batched = 0u;
+		}
+	}
+}
+
+/**
+ * ipc_channel_rx_chain() - receive a chained message
+ * @instance:    instance id
+ * @chan:        channel private data
+ * @bd:          first BD of chain, already popped from channel queue
+ *
+ * Sender publishes all BDs of a chain at once, so continuation BDs are
+ * available as soon as the first one is. A malformed chain (missing
+ * continuation, too many buffers or invalid BD) is dropped and its buffers
+ * are released to remote, and so is any chain when no rx_chain_cb is set.
+ *
+ * Return: number of BDs popped
+ */
+static uint32 ipc_channel_rx_chain(const uint8 instance,
+		struct ipc_shm_channel *chan, struct ipc_shm_bd *bd)
+{
+	struct ipc_managed_channel *mchan = &chan->ch.mng;
+	struct ipc_shm_chain *chain = &ipc_shm_priv_data[instance].rx_chain;
+	uint8 chain_ok = 1u;
+	uint32 more;
+	uint32 work = 0u;
+	void *buf;
+
+	chain->num_bufs = 0u;
+	chain->total_size = 0u;
+
+	do {
+		more = bd->data_size & IPC_SHM_BD_CHAIN_MORE;
+		buf = ipc_bd_to_remote_buf(instance, mchan, bd);
+		work++;
+
+		if ((buf == NULL) || (chain->num_bufs == IPC_SHM_MAX_CHAIN_BUFS)) {
+			chain_ok = 0u;
+			if (buf != NULL) {
+				/* chain too long: give buffer back to remote */
+				(void)ipc_shm_release_buf(instance, chan->id, buf);
+			}
+		} else {
+			chain->bufs[chain->num_bufs].buf = buf;
+			chain->bufs[chain->num_bufs].size =
+				bd->data_size & ~IPC_SHM_BD_CHAIN_MORE;
+			chain->total_size += chain->bufs[chain->num_bufs].size;
+			chain->num_bufs++;
+		}
+
+		if ((more != 0u)
+				&& (ipc_queue_pop(&mchan->bd_queue, bd) != IPC_SHM_E_OK)) {
+			/* continuation missing: chain is broken */
+			chain_ok = 0u;
+			more = 0u;
+		}
+	} while (more != 0u);
+
+	if ((chain_ok != 0u) && (mchan->rx_chain_cb != NULL)) {
+		mchan->rx_chain_cb(mchan->cb_arg, instance, chan->id, chain);
+	} else {
+		/* broken chain or no gather support in application: drop it */
+		(void)ipc_shm_release_bufs(instance, chan->id, chain->bufs,
+				chain->num_bufs);
+	}
+
+	return work;
+}
+
 /**
  * ipc_channel_rx() - handle Rx for a single channel
  * @instance: instance id
@@ -388,11 +660,10 @@ static uint32 ipc_channel_rx(const uint8 instance, uint8 chan_id, uint32 budget)
 			&ipc_shm_priv_data[instance].channels[chan_id];
 	struct ipc_managed_channel *mchan = &chan->ch.mng;
 	struct ipc_unmanaged_channel *uchan = &chan->ch.umng;
-	struct ipc_shm_pool *pool;
 	struct ipc_shm_bd bd;
-	uintptr buf_addr;
-	uint32 buf_offset;
+	void *buf;
 	uint32 remote_tx_count;
+	uint32 num_batched = 0u;
 	sint8 result = 0;
 	uint32 work = 0;
 
@@ -421,19 +692,33 @@ static uint32 ipc_channel_rx(const uint8 instance, uint8 chan_id, uint32 budget)
 			if (result != IPC_SHM_E_OK) {
 				break;
 			}
-			pool = &mchan->pools[bd.pool_id];
-			buf_offset = pool->buf_size * bd.buf_id;
-			buf_addr = pool->remote_pool_addr + buf_offset;
 
-			/* check if buf_addr is valid */
-			if ((buf_addr >= ipc_os_get_remote_shm(instance)) &&
-				((buf_addr + pool->buf_size) <= (ipc_os_get_remote_shm(instance) +
-				ipc_shm_priv_data[instance].shm_size))) {
-				mchan->rx_cb(mchan->cb_arg, instance, chan->id,
-					(void *)buf_addr, bd.data_size);
+			if ((bd.data_size & IPC_SHM_BD_CHAIN_MORE) != 0u) {
+				/* deliver earlier messages first to keep message order */
+				if (num_batched != 0u) {
+					mchan->rx_batch_cb(mchan->cb_arg, instance, chan->id,
+						ipc_shm_priv_data[instance].rx_batch,
+						num_batched);
+					num_batched = 0u;
+				}
+
+				/* chained message: popped as a whole */
+				work += ipc_channel_rx_chain(instance, chan, &bd);
+			} else {
+				buf = ipc_bd_to_remote_buf(instance, mchan, &bd);
+				if (buf != NULL) {
+					ipc_channel_rx_deliver(instance, chan, buf,
+							bd.data_size, &num_batched);
+				}
+
+				work++;
 			}
+		}
 
-			work++;
+		/* deliver buffers collected in this budget round */
+		if (num_batched != 0u) {
+			mchan->rx_batch_cb(mchan->cb_arg, instance, chan->id,
+				ipc_shm_priv_data[instance].rx_batch, num_batched);
 		}
 	}
 
@@ -507,6 +792,9 @@ static uint32 ipc_shm_rx(const uint8 instance, uint32 budget)
 		}
 	}
 
+	/* remote rings are freshly invalidated here: check Tx credits */
+	ipc_shm_credit_check(instance);
+
 	return work;
 }
 
@@ -593,6 +881,7 @@ static sint8 ipc_buf_pool_init(const uint8 instance, uint8 chan_id, uint16 pool_
 	if (cfg->num_bufs <= IPC_SHM_MAX_BUFS_PER_POOL) {
 		pool->num_bufs = cfg->num_bufs;
 		pool->buf_size = cfg->buf_size;
+		pool->num_spare = 0u;
 
 		/* Preapare queue data parameter */
 		queue_data.queue_type = IPC_SHM_POOL_QUEUE;
@@ -643,7 +932,12 @@ static uint32 ipc_get_total_buf_per_chan(const uint8 instance, uint8 chan_id,
 		/* save managed channel parameters */
 		chan->rx_cb = cfg->rx_cb;
 		chan->cb_arg = cfg->cb_arg;
+		chan->rx_batch_cb = cfg->rx_batch_cb;
+		chan->rx_chain_cb = cfg->rx_chain_cb;
 		chan->num_pools = cfg->num_pools;
+		chan->credit_cb = NULL;
+		chan->credit_cb_arg = NULL;
+		chan->credit_size = 0u;
 
 		/* check that pools are sorted in ascending order by buf size
 		 * and count total number of buffers from all pools
@@ -845,7 +1139,8 @@ static sint8 ipc_shm_init_a_channel(const uint8 instance, uint8 chan_id,
 	chan->type = cfg->type;
 
 	if (cfg->type == IPC_SHM_MANAGED) {
-		if ((cfg->ch.managed.rx_cb == NULL)
+		if (((cfg->ch.managed.rx_cb == NULL)
+				&& (cfg->ch.managed.rx_batch_cb == NULL))
 			|| (cfg->ch.managed.pools == NULL)) {
 			err = -IPC_SHM_E_INVAL;
 		} else {
@@ -1120,6 +1415,56 @@ void ipc_shm_free(void)
 	}
 }
 
+/**
+ * ipc_pool_take_buf() - take a free local buffer from a pool
+ * @pool:   buffer pool private data
+ * @buf_id: [OUT] id of the buffer taken
+ *
+ * Buffers given back unused with ipc_shm_return_buf() are reused first, then
+ * the pool acquire ring is popped.
+ *
+ * Return: IPC_SHM_E_OK for success, error code if pool has no free buffer
+ */
+static sint8 ipc_pool_take_buf(struct ipc_shm_pool *pool, uint16 *buf_id)
+{
+	struct ipc_shm_bd bd = {.pool_id = 0u, .buf_id = 0u, .data_size = 0u};
+	sint8 err = IPC_SHM_E_OK;
+
+	if (pool->num_spare > 0u) {
+		pool->num_spare--;
+		*buf_id = pool->spare_ids[pool->num_spare];
+	} else {
+		err = ipc_queue_pop(&pool->bd_queue, &bd);
+		if (err == IPC_SHM_E_OK)
+			*buf_id = bd.buf_id;
+	}
+
+	return err;
+}
+
+/**
+ * ipc_pool_put_spare() - give an acquired local buffer back to its pool
+ * @pool:   buffer pool private data
+ * @buf_id: id of the buffer
+ *
+ * The acquire ring is written by remote only, so the buffer is kept locally
+ * and handed out again by the next acquire from this pool.
+ *
+ * Return: IPC_SHM_E_OK for success, -IPC_SHM_E_NOMEM if no spare slot is left
+ */
+static sint8 ipc_pool_put_spare(struct ipc_shm_pool *pool, uint16 buf_id)
+{
+	sint8 err = -IPC_SHM_E_NOMEM;
+
+	if (pool->num_spare < IPC_SHM_MAX_SPARE_BUFS) {
+		pool->spare_ids[pool->num_spare] = buf_id;
+		pool->num_spare++;
+		err = IPC_SHM_E_OK;
+	}
+
+	return err;
+}
+
 /**
  * ipc_shm_acquire_buf_from_pool() - Get buffer from a channel
  * @instance:       instance id
@@ -1133,7 +1478,7 @@ static uintptr ipc_shm_acquire_buf_from_pool(const uint8 instance, uint32 mem_si
 {
 	struct ipc_shm_pool *pool = NULL;
 	uintptr buf_addr = (uintptr)NULL;
-	struct ipc_shm_bd bd = {.pool_id = 0u, .buf_id = 0u, .data_size = 0u};
+	uint16 buf_id = 0u;
 	uint16 pool_id;
 
 	/* find first non-empty pool that accommodates the requested size */
@@ -1145,7 +1490,7 @@ static uintptr ipc_shm_acquire_buf_from_pool(const uint8 instance, uint32 mem_si
 			continue;
 
 		/* check if pool has any free buffers left */
-		if (ipc_queue_pop(&pool->bd_queue, &bd) == 0)
+		if (ipc_pool_take_buf(pool, &buf_id) == IPC_SHM_E_OK)
 			break;
 	}
 
@@ -1153,7 +1498,7 @@ static uintptr ipc_shm_acquire_buf_from_pool(const uint8 instance, uint32 mem_si
 		buf_addr = (uintptr)NULL;
 	} else {
 		buf_addr = pool->local_pool_addr +
-			(uint32)(bd.buf_id * pool->buf_size);
+			(uint32)(buf_id * pool->buf_size);
 
 		/* check if buf_addr is valid */
 		if ((buf_addr < ipc_os_get_local_shm(instance)) ||
@@ -1181,12 +1526,67 @@ void *ipc_shm_acquire_buf(const uint8 instance, uint8 chan_id, uint32 mem_size)
 			buf_addr = (uintptr)NULL;
 		} else {
 			buf_addr = ipc_shm_acquire_buf_from_pool(instance, mem_size, chan);
+			if (buf_addr == (uintptr)NULL) {
+				/* a smaller armed size may be served without Rx traffic */
+				ipc_mchan_credit_check(instance, chan, chan_id);
+
+				/* out of credits: notify sender when remote releases */
+				ipc_mchan_arm_credit_cb(chan, mem_size);
+			}
 		}
 	}
 
 	return (void *)buf_addr;
 }
 
+uint32 ipc_shm_tx_credits(const uint8 instance, uint8 chan_id, uint32 mem_size)
+{
+	struct ipc_managed_channel *chan;
+	uint32 credits = 0u;
+
+	/* check if instance is valid and remote is ready */
+	if (ipc_shm_is_remote_ready(instance) == IPC_SHM_E_OK) {
+
+		chan = get_managed_chan(instance, chan_id);
+
+		if ((chan != NULL) && (mem_size != 0u)
+				&& (IPC_SHM_E_OK == ipc_check_mchan_integrity(chan))) {
+			/* deliver a pending notification without Rx traffic */
+			ipc_mchan_credit_check(instance, chan, chan_id);
+
+			credits = ipc_mchan_count_credits(chan, mem_size);
+			if (credits == 0u) {
+				ipc_mchan_arm_credit_cb(chan, mem_size);
+			}
+		}
+	}
+
+	return credits;
+}
+
+sint8 ipc_shm_register_credit_cb(const uint8 instance, uint8 chan_id,
+		void (*credit_cb)(void *cb_arg, const uint8 instance,
+			uint8 chan_id, uint32 credits),
+		void *cb_arg)
+{
+	struct ipc_managed_channel *chan;
+	sint8 err = -IPC_SHM_E_INVAL;
+
+	/* check if instance is used */
+	if (ipc_instance_is_free(instance) == IPC_SHM_INSTANCE_USED) {
+		chan = get_managed_chan(instance, chan_id);
+		if (chan != NULL) {
+			/* disarm first so a stale request is not reported to new cb */
+			chan->credit_size = 0u;
+			chan->credit_cb_arg = cb_arg;
+			chan->credit_cb = credit_cb;
+			err = IPC_SHM_E_OK;
+		}
+	}
+
+	return err;
+}
+
 sint8 ipc_shm_init(const struct ipc_shm_instances_cfg *cfg)
 {
 	uint8 instance_id = 0;
@@ -1252,6 +1652,70 @@ static sint8 find_pool_for_buf(struct ipc_managed_channel *chan,
 	return err;
 }
 
+sint8 ipc_shm_return_buf(const uint8 instance, uint8 chan_id, const void *buf)
+{
+	struct ipc_managed_channel *chan;
+	struct ipc_shm_pool *pool;
+	uint16 pool_id;
+	sint8 err = -IPC_SHM_E_INVAL;
+
+	/* check if instance is used */
+	if ((buf != NULL)
+			&& (ipc_instance_is_free(instance) == IPC_SHM_INSTANCE_USED)) {
+		chan = get_managed_chan(instance, chan_id);
+		if (chan != NULL) {
+			/* Find the local pool that owns the buffer */
+			err = find_pool_for_buf(chan, (uintptr)buf,
+						IPC_BUFFER_FROM_LOCAL, &pool_id);
+			if (IPC_SHM_E_OK == err) {
+				pool = &chan->pools[pool_id];
+				err = ipc_pool_put_spare(pool, (uint16)(((uintptr)buf
+						- pool->local_pool_addr) / pool->buf_size));
+			}
+		}
+	}
+
+	return err;
+}
+
+uint32 ipc_shm_buf_size(const uint8 instance, uint8 chan_id, const void *buf)
+{
+	struct ipc_managed_channel *chan;
+	uint16 pool_id;
+	uint32 size = 0u;
+
+	/* check if instance is used */
+	if ((buf != NULL)
+			&& (ipc_instance_is_free(instance) == IPC_SHM_INSTANCE_USED)) {
+		chan = get_managed_chan(instance, chan_id);
+		if ((chan != NULL) && (find_pool_for_buf(chan, (uintptr)buf,
+				IPC_BUFFER_FROM_LOCAL, &pool_id) == IPC_SHM_E_OK)) {
+			size = chan->pools[pool_id].buf_size;
+		}
+	}
+
+	return size;
+}
+
+uint32 ipc_shm_max_buf_size(const uint8 instance, uint8 chan_id)
+{
+	struct ipc_managed_channel *chan;
+	uint16 pool_id;
+	uint32 size = 0u;
+
+	/* check if instance is used */
+	if (ipc_instance_is_free(instance) == IPC_SHM_INSTANCE_USED) {
+		chan = get_managed_chan(instance, chan_id);
+		for (pool_id = 0u; (chan != NULL) && (pool_id < chan->num_pools);
+				pool_id++) {
+			if (chan->pools[pool_id].buf_size > size)
+				size = chan->pools[pool_id].buf_size;
+		}
+	}
+
+	return size;
+}
+
 sint8 ipc_shm_release_buf(const uint8 instance, uint8 chan_id, const void *buf)
 {
 	struct ipc_managed_channel *chan;
@@ -1288,6 +1752,44 @@ sint8 ipc_shm_release_buf(const uint8 instance, uint8 chan_id, const void *buf)
 	return err;
 }
 
+sint8 ipc_shm_release_bufs(const uint8 instance, uint8 chan_id,
+		const struct ipc_shm_buf *bufs, uint32 num_bufs)
+{
+	struct ipc_managed_channel *chan;
+	struct ipc_shm_pool *pool;
+	struct ipc_shm_bd bd;
+	uint32 i;
+	sint8 err = -IPC_SHM_E_INVAL;
+
+	/* check if instance is valid */
+	if (ipc_shm_is_remote_ready(instance) == IPC_SHM_E_OK) {
+		chan = get_managed_chan(instance, chan_id);
+		if ((chan != NULL) && (bufs != NULL) && (num_bufs != 0u)) {
+
+			err = ipc_check_mchan_integrity(chan);
+			for (i = 0u; (i < num_bufs) && (IPC_SHM_E_OK == err); i++) {
+				/* Find the pool that owns the buffer */
+				err = find_pool_for_buf(chan, (uintptr)bufs[i].buf,
+							IPC_BUFFER_FROM_REMOTE, &bd.pool_id);
+
+				if (IPC_SHM_E_OK == err) {
+					pool = &chan->pools[bd.pool_id];
+					bd.buf_id = (uint16)(((uintptr)bufs[i].buf
+							- pool->remote_pool_addr) / pool->buf_size);
+					bd.data_size = 0; /* reset size of written data in buffer */
+
+					err = ipc_queue_push(&pool->bd_queue, &bd);
+				}
+			}
+
+			/* flush and invalidate local dcache once for the whole batch */
+			ipc_hw_flush_cache_local(instance);
+		}
+	}
+
+	return err;
+}
+
 /**
  * ipc_shm_buf_tx() - find buffer in a pool and notify remote
  * @instance:       instance id
@@ -1348,6 +1850,273 @@ sint8 ipc_shm_tx(const uint8 instance, uint8 chan_id, void *buf, uint32 size)
 	return err;
 }
 
+/**
+ * ipc_chain_plan() - choose pools for the buffers of a chained message
+ * @chan:     managed channel private data
+ * @size:     message size
+ * @pool_ids: pool chosen for each buffer
+ * @sizes:    size of data to be written in each buffer
+ *
+ * Large pools are used first and the last buffer is taken from the smallest
+ * pool that accommodates the remaining data. Only buffers already advertised
+ * by remote are planned, and since only the local sender pops from the pool
+ * acquire rings, the planned buffers are guaranteed to be acquirable.
+ *
+ * Return: number of buffers planned, 0 if message doesn't fit in free buffers
+ */
+static uint8 ipc_chain_plan(struct ipc_managed_channel *chan, uint32 size,
+		uint16 *pool_ids, uint32 *sizes)
+{
+	uint16 avail[IPC_SHM_MAX_POOLS];
+	uint32 remaining = size;
+	uint16 pool_id;
+	uint16 sel;
+	uint8 num_bufs = 0u;
+
+	for (pool_id = 0; pool_id < chan->num_pools; pool_id++) {
+		avail[pool_id] = (uint16)(ipc_queue_count(&chan->pools[pool_id].bd_queue)
+			+ chan->pools[pool_id].num_spare);
+	}
+
+	while ((remaining > 0u) && (num_bufs < IPC_SHM_MAX_CHAIN_BUFS)) {
+		sel = chan->num_pools;
+
+		/* smallest free buffer that holds the remaining data ends chain */
+		for (pool_id = 0; pool_id < chan->num_pools; pool_id++) {
+			if ((avail[pool_id] != 0u)
+					&& (chan->pools[pool_id].buf_size >= remaining)) {
+				sel = pool_id;
+				break;
+			}
+		}
+
+		/* otherwise use largest free buffer */
+		for (pool_id = chan->num_pools; (sel == chan->num_pools)
+				&& (pool_id > 0u); pool_id--) {
+			if (avail[pool_id - 1u] != 0u)
+				sel = pool_id - 1u;
+		}
+
+		if (sel == chan->num_pools)
+			break;
+
+		pool_ids[num_bufs] = sel;
+		sizes[num_bufs] = (chan->pools[sel].buf_size < remaining) ?
+				chan->pools[sel].buf_size : remaining;
+		remaining -= sizes[num_bufs];
+		avail[sel]--;
+		num_bufs++;
+	}
+
+	if (remaining > 0u)
+		num_bufs = 0u;
+
+	return num_bufs;
+}
+
+uint8 ipc_shm_acquire_chain(const uint8 instance, uint8 chan_id, uint32 size,
+		struct ipc_shm_chain *chain)
+{
+	struct ipc_managed_channel *chan;
+	struct ipc_shm_pool *pool;
+	uint16 buf_ids[IPC_SHM_MAX_CHAIN_BUFS];
+	uint16 pool_ids[IPC_SHM_MAX_CHAIN_BUFS];
+	uint32 sizes[IPC_SHM_MAX_CHAIN_BUFS];
+	uintptr buf_addr;
+	uint8 num_bufs = 0u;
+	uint8 i;
+
+	/* check if instance is valid and remote is ready */
+	if ((chain != NULL)
+			&& (ipc_shm_is_remote_ready(instance) == IPC_SHM_E_OK)) {
+		chain->num_bufs = 0u;
+		chain->total_size = 0u;
+
+		chan = get_managed_chan(instance, chan_id);
+
+		if ((chan != NULL) && (size != 0u)
+				&& (IPC_SHM_E_OK == ipc_check_mchan_integrity(chan))) {
+			num_bufs = ipc_chain_plan(chan, size, pool_ids, sizes);
+			if (num_bufs == 0u) {
+				/* not enough credits: notify sender when remote releases */
+				ipc_mchan_arm_credit_cb(chan, 1u);
+			}
+		}
+
+		for (i = 0u; i < num_bufs; i++) {
+			pool = &chan->pools[pool_ids[i]];
+			if (ipc_pool_take_buf(pool, &buf_ids[i]) != IPC_SHM_E_OK) {
+				break;
+			}
+
+			buf_addr = pool->local_pool_addr +
+				(uint32)(buf_ids[i] * pool->buf_size);
+
+			/* check if buf_addr is valid (invalid buffer id is dropped) */
+			if ((buf_addr < ipc_os_get_local_shm(instance)) ||
+				((buf_addr + pool->buf_size) > (ipc_os_get_local_shm(instance) +
+				ipc_shm_priv_data[instance].shm_size))) {
+				break;
+			}
+
+			chain->bufs[i].buf = (void *)buf_addr;
+			chain->bufs[i].size = sizes[i];
+			chain->total_size += sizes[i];
+			chain->num_bufs++;
+		}
+
+		/*
+		 * All or nothing: keep the buffers taken so far as spares of
+		 * their pools, last first so each pool hands them out again in
+		 * the same order. Spares are taken before the acquire ring is
+		 * popped, so no pool ends up with more spares than it had before
+		 * or than buffers taken from it: both fit IPC_SHM_MAX_SPARE_BUFS.
+		 */
+		if (chain->num_bufs != num_bufs) {
+			for (i = chain->num_bufs; i > 0u; i--) {
+				(void)ipc_pool_put_spare(&chan->pools[pool_ids[i - 1u]],
+						buf_ids[i - 1u]);
+			}
+			chain->num_bufs = 0u;
+			chain->total_size = 0u;
+		}
+	}
+
+	return (chain != NULL) ? chain->num_bufs : 0u;
+}
+
+sint8 ipc_shm_tx_chain(const uint8 instance, uint8 chan_id,
+		const struct ipc_shm_chain *chain)
+{
+	struct ipc_managed_channel *chan;
+	struct ipc_shm_pool *pool;
+	struct ipc_shm_bd bds[IPC_SHM_MAX_CHAIN_BUFS];
+	uint8 i;
+	sint8 err = -IPC_SHM_E_INVAL;
+
+	/* check if instance is used */
+	if ((chain != NULL) && (chain->num_bufs != 0u)
+			&& (chain->num_bufs <= IPC_SHM_MAX_CHAIN_BUFS)
+			&& (ipc_shm_is_remote_ready(instance) == IPC_SHM_E_OK)) {
+
+		chan = get_managed_chan(instance, chan_id);
+
+		if (chan != NULL) {
+			err = ipc_check_mchan_integrity(chan);
+		}
+
+		/* build BDs of all buffers, all but last one flagged as chained */
+		for (i = 0u; (i < chain->num_bufs) && (IPC_SHM_E_OK == err); i++) {
+			err = find_pool_for_buf(chan, (uintptr)chain->bufs[i].buf,
+						IPC_BUFFER_FROM_LOCAL, &bds[i].pool_id);
+			if (IPC_SHM_E_OK == err) {
+				pool = &chan->pools[bds[i].pool_id];
+				if ((chain->bufs[i].size == 0u)
+						|| (chain->bufs[i].size > pool->buf_size)) {
+					err = -IPC_SHM_E_INVAL;
+				} else {
+					bds[i].buf_id = (uint16)(((uintptr)chain->bufs[i].buf
+							- pool->local_pool_addr) / pool->buf_size);
+					bds[i].data_size = chain->bufs[i].size;
+					if ((i + 1u) < chain->num_bufs) {
+						bds[i].data_size |= IPC_SHM_BD_CHAIN_MORE;
+					}
+				}
+			}
+		}
+
+		if (IPC_SHM_E_OK == err) {
+			/* publish all BDs at once so remote never sees a partial chain */
+			err = ipc_queue_push_multi(&chan->bd_queue, bds,
+					(uint16)chain->num_bufs);
+			if (IPC_SHM_E_OK == err) {
+				/* flush and invalidate local dcache */
+				ipc_hw_flush_cache_local(instance);
+
+				/* notify remote that data is available */
+				ipc_hw_irq_notify(instance);
+			}
+		}
+	}
+
+	return err;
+}
+
+sint8 ipc_shm_release_chain(const uint8 instance, uint8 chan_id,
+		const struct ipc_shm_chain *chain)
+{
+	sint8 err = -IPC_SHM_E_INVAL;
+
+	if (chain != NULL) {
+		err = ipc_shm_release_bufs(instance, chan_id, chain->bufs,
+				chain->num_bufs);
+	}
+
+	return err;
+}
+
+uint32 ipc_shm_chain_gather(const struct ipc_shm_chain *chain, uint32 offset,
+		void *dst, uint32 len)
+{
+	uint8 *out = (uint8 *)dst;
+	uint32 copied = 0u;
+	uint32 seg_len;
+	uint8 i;
+
+	if ((chain != NULL) && (dst != NULL)) {
+		for (i = 0u; (i < chain->num_bufs) && (copied < len); i++) {
+			/* skip buffers before requested offset */
+			if (offset >= chain->bufs[i].size) {
+				offset -= chain->bufs[i].size;
+				continue;
+			}
+
+			seg_len = chain->bufs[i].size - offset;
+			if (seg_len > (len - copied)) {
+				seg_len = len - copied;
+			}
+
+			ipc_memcpy(&out[copied],
+				(const uint8 *)chain->bufs[i].buf + offset, seg_len);
+			copied += seg_len;
+			offset = 0u;
+		}
+	}
+
+	return copied;
+}
+
+uint32 ipc_shm_chain_scatter(const struct ipc_shm_chain *chain, uint32 offset,
+		const void *src, uint32 len)
+{
+	const uint8 *in = (const uint8 *)src;
+	uint32 copied = 0u;
+	uint32 seg_len;
+	uint8 i;
+
+	if ((chain != NULL) && (src != NULL)) {
+		for (i = 0u; (i < chain->num_bufs) && (copied < len); i++) {
+			/* skip buffers before requested offset */
+			if (offset >= chain->bufs[i].size) {
+				offset -= chain->bufs[i].size;
+				continue;
+			}
+
+			seg_len = chain->bufs[i].size - offset;
+			if (seg_len > (len - copied)) {
+				seg_len = len - copied;
+			}
+
+			ipc_memcpy((uint8 *)chain->bufs[i].buf + offset,
+				&in[copied], seg_len);
+			copied += seg_len;
+			offset = 0u;
+		}
+	}
+
+	return copied;
+}
+
 void *ipc_shm_unmanaged_acquire(const uint8 instance, uint8 chan_id)
 {
 	struct ipc_unmanaged_channel *chan = NULL;
@@ -108,6 +108,49 @@ void ipc_shm_free(void);
  */
 void *ipc_shm_acquire_buf(const uint8 instance, uint8 chan_id, uint32 mem_size);
 
+/**
+ * ipc_shm_return_buf() - give back an acquired buffer that was not sent
+ * @instance:       instance id
+ * @chan_id:        channel index
+ * @buf:            buffer pointer returned by ipc_shm_acquire_buf()
+ *
+ * The buffer stays a Tx credit of the channel and is handed out again by the
+ * next ipc_shm_acquire_buf() that fits its pool. Up to IPC_SHM_MAX_SPARE_BUFS
+ * buffers per pool can be given back at a time.
+ * Unlike ipc_shm_release_buf(), which frees received buffers back to remote,
+ * this is for the local sender only.
+ *
+ * Function used only for managed channels where buffer management is enabled.
+ * Function is thread-safe for different channels but not for the same channel.
+ *
+ * Return: 0 on success, error code otherwise
+ */
+sint8 ipc_shm_return_buf(const uint8 instance, uint8 chan_id, const void *buf);
+
+/**
+ * ipc_shm_buf_size() - size of an acquired buffer
+ * @instance:       instance id
+ * @chan_id:        channel index
+ * @buf:            buffer pointer returned by ipc_shm_acquire_buf()
+ *
+ * ipc_shm_acquire_buf() takes the smallest pool that accommodates the
+ * requested size and has a free buffer, so the buffer may be larger than
+ * requested.
+ *
+ * Return: buffer size of the pool owning buf, 0 if buf is not a Tx buffer of
+ * the channel
+ */
+uint32 ipc_shm_buf_size(const uint8 instance, uint8 chan_id, const void *buf);
+
+/**
+ * ipc_shm_max_buf_size() - largest buffer size of the given channel
+ * @instance:       instance id
+ * @chan_id:        channel index
+ *
+ * Return: buffer size of the largest pool, 0 if invalid or unmanaged channel
+ */
+uint32 ipc_shm_max_buf_size(const uint8 instance, uint8 chan_id);
+
 /**
  * ipc_shm_release_buf() - release a buffer for the given channel
  * @instance:       instance id
@@ -121,6 +164,25 @@ void *ipc_shm_acquire_buf(const uint8 instance, uint8 chan_id, uint32 mem_size);
  */
 sint8 ipc_shm_release_buf(const uint8 instance, uint8 chan_id, const void *buf);
 
+/**
+ * ipc_shm_release_bufs() - release a batch of buffers for the given channel
+ * @instance:       instance id
+ * @chan_id:        channel index
+ * @bufs:           buffers to release (only buf member is used)
+ * @num_bufs:       number of buffers
+ *
+ * Same as ipc_shm_release_buf() for each buffer, but the local dcache is
+ * flushed once for the whole batch. Intended to be used with the buffers
+ * delivered by a batched receive callback. Release stops at first error.
+ *
+ * Function used only for managed channels where buffer management is enabled.
+ * Function is thread-safe for different channels but not for the same channel.
+ *
+ * Return: 0 on success, error code otherwise
+ */
+sint8 ipc_shm_release_bufs(const uint8 instance, uint8 chan_id,
+		const struct ipc_shm_buf *bufs, uint32 num_bufs);
+
 /**
  * ipc_shm_tx() - send data on given channel and notify remote
  * @instance:       instance id
@@ -135,6 +197,140 @@ sint8 ipc_shm_release_buf(const uint8 instance, uint8 chan_id, const void *buf);
  */
 sint8 ipc_shm_tx(const uint8 instance, uint8 chan_id, void *buf, uint32 size);
 
+/**
+ * ipc_shm_tx_credits() - query Tx credits of the given channel
+ * @instance:       instance id
+ * @chan_id:        channel index
+ * @mem_size:       required size
+ *
+ * Tx credits are free remote buffers that accommodate mem_size, advertised by
+ * remote through the pool release rings each time it releases a received
+ * buffer. The query is non-blocking and doesn't consume any credit, a non-zero
+ * result guarantees that the next ipc_shm_acquire_buf() with the same size
+ * succeeds if no other thread acquires from the same channel.
+ * When no credit is left and a credit callback is registered, the callback is
+ * armed and will be invoked when remote replenishes credits. A query also
+ * delivers the callback armed earlier if its credits are back.
+ *
+ * Function used only for managed channels where buffer management is enabled.
+ * Function is thread-safe for different channels but not for the same channel.
+ *
+ * Return: number of available Tx credits, 0 if none or invalid channel
+ */
+uint32 ipc_shm_tx_credits(const uint8 instance, uint8 chan_id, uint32 mem_size);
+
+/**
+ * ipc_shm_register_credit_cb() - register Tx credits replenished callback
+ * @instance:       instance id
+ * @chan_id:        channel index
+ * @credit_cb:      callback, NULL to unregister
+ * @cb_arg:         optional callback argument
+ *
+ * The callback is armed by a failed ipc_shm_acquire_buf() or by an
+ * ipc_shm_tx_credits() query returning 0, and is invoked once with the number
+ * of credits available for the smallest size that armed it. It must not block.
+ *
+ * Remote releases buffers without an interrupt, so the credits are only seen
+ * when the local side looks at them: at the end of every Rx softirq run (or
+ * ipc_shm_poll_channels() call) of the instance, and in ipc_shm_tx_credits()
+ * and a failed ipc_shm_acquire_buf() on the channel, in the caller's context.
+ * While the instance receives nothing and the channel is not queried, the
+ * callback is late: a sender waiting for it should also retry on a timeout.
+ *
+ * Function used only for managed channels where buffer management is enabled.
+ *
+ * Return: 0 on success, error code otherwise
+ */
+sint8 ipc_shm_register_credit_cb(const uint8 instance, uint8 chan_id,
+		void (*credit_cb)(void *cb_arg, const uint8 instance,
+			uint8 chan_id, uint32 credits),
+		void *cb_arg);
+
+/**
+ * ipc_shm_acquire_chain() - request chained buffers for a large message
+ * @instance:       instance id
+ * @chan_id:        channel index
+ * @size:           message size
+ * @chain:          [OUT] acquired buffers and size to be written in each
+ *
+ * Buffers are taken from any pool of the channel, largest first, so messages
+ * bigger than the largest pool buffer can be sent without reserving jumbo
+ * buffers. All buffers are acquired or none: the message must fit in at most
+ * IPC_SHM_MAX_CHAIN_BUFS free buffers, and if a buffer can't be taken the
+ * ones already taken are given back to their pools. Acquired buffers must be
+ * filled (see ipc_shm_chain_scatter()) and sent with ipc_shm_tx_chain().
+ *
+ * Function used only for managed channels where buffer management is enabled.
+ * Function is thread-safe for different channels but not for the same channel.
+ *
+ * Return: number of buffers acquired, 0 if not enough free buffers
+ */
+uint8 ipc_shm_acquire_chain(const uint8 instance, uint8 chan_id, uint32 size,
+		struct ipc_shm_chain *chain);
+
+/**
+ * ipc_shm_tx_chain() - send chained buffers as one message and notify remote
+ * @instance:       instance id
+ * @chan_id:        channel index
+ * @chain:          buffers to send, in message order
+ *
+ * Buffers can be acquired with ipc_shm_acquire_chain() or with
+ * ipc_shm_acquire_buf() from any pool; chain->bufs[].size is the size of data
+ * written in each buffer. All BDs are published at once, so remote receives
+ * the complete chain or nothing. Remote driver must support chained BDs: the
+ * stock A53 Linux ipc-shm driver does not, so use this function only with an
+ * A53 driver built with matching chain support. A local receiver without
+ * rx_chain_cb drops chained messages.
+ *
+ * Function used only for managed channels where buffer management is enabled.
+ * Function is thread-safe for different channels but not for the same channel.
+ *
+ * Return: 0 on success, error code otherwise
+ */
+sint8 ipc_shm_tx_chain(const uint8 instance, uint8 chan_id,
+		const struct ipc_shm_chain *chain);
+
+/**
+ * ipc_shm_release_chain() - release all buffers of a received chain
+ * @instance:       instance id
+ * @chan_id:        channel index
+ * @chain:          chain delivered by rx_chain_cb
+ *
+ * Function used only for managed channels where buffer management is enabled.
+ * Function is thread-safe for different channels but not for the same channel.
+ *
+ * Return: 0 on success, error code otherwise
+ */
+sint8 ipc_shm_release_chain(const uint8 instance, uint8 chan_id,
+		const struct ipc_shm_chain *chain);
+
+/**
+ * ipc_shm_chain_gather() - copy data out of a chained message
+ * @chain:          chained message
+ * @offset:         message offset to start from
+ * @dst:            destination buffer
+ * @len:            number of bytes to copy
+ *
+ * Can be called repeatedly with increasing offset to iterate over a message
+ * larger than the destination buffer.
+ *
+ * Return: number of bytes copied
+ */
+uint32 ipc_shm_chain_gather(const struct ipc_shm_chain *chain, uint32 offset,
+		void *dst, uint32 len);
+
+/**
+ * ipc_shm_chain_scatter() - copy data into the buffers of a chained message
+ * @chain:          chained message
+ * @offset:         message offset to start from
+ * @src:            source buffer
+ * @len:            number of bytes to copy
+ *
+ * Return: number of bytes copied
+ */
+uint32 ipc_shm_chain_scatter(const struct ipc_shm_chain *chain, uint32 offset,
+		const void *src, uint32 len);
+
 /**
  * ipc_shm_unmanaged_acquire() - acquire the unmanaged channel local memory
  * @instance:       instance id
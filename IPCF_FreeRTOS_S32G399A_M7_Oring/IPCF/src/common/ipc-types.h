@@ -315,6 +315,31 @@ extern "C"{
 #define IPC_SHM_MAX_INSTANCES	4u
 #endif
 
+/*
+ * Maximum number of buffers delivered by one batched receive callback call
+ */
+#ifndef IPC_SHM_RX_BATCH_SIZE
+#define IPC_SHM_RX_BATCH_SIZE 16u
+#endif
+
+/*
+ * Maximum number of buffers chained in one scatter-gather message
+ */
+#ifndef IPC_SHM_MAX_CHAIN_BUFS
+#define IPC_SHM_MAX_CHAIN_BUFS 8u
+#endif
+
+/*
+ * Maximum number of acquired buffers per pool given back unused
+ */
+#ifndef IPC_SHM_MAX_SPARE_BUFS
+#define IPC_SHM_MAX_SPARE_BUFS IPC_SHM_MAX_CHAIN_BUFS
+#endif
+
+#if (IPC_SHM_MAX_SPARE_BUFS < IPC_SHM_MAX_CHAIN_BUFS)
+	#error "IPC_SHM_MAX_SPARE_BUFS must hold the buffers of a chain given back"
+#endif
+
 /*
  * Used for boolean false value
  */
@@ -411,12 +436,45 @@ struct ipc_shm_pool_cfg {
 	uint32 buf_size;
 };
 
+/**
+ * struct ipc_shm_buf - shared memory buffer and size of data written in it
+ * @buf:    buffer pointer
+ * @size:   size of data written in buffer
+ */
+struct ipc_shm_buf {
+	void *buf;
+	uint32 size;
+};
+
+/**
+ * struct ipc_shm_chain - scatter-gather message made of chained buffers
+ * @num_bufs:   number of chained buffers
+ * @total_size: size of message (sum of data written in all buffers)
+ * @bufs:       chained buffers, in message order
+ *
+ * Buffers of a chain can belong to any pool of the channel.
+ */
+struct ipc_shm_chain {
+	uint8 num_bufs;
+	uint32 total_size;
+	struct ipc_shm_buf bufs[IPC_SHM_MAX_CHAIN_BUFS];
+};
+
 /**
  * struct ipc_shm_managed_cfg - managed channel parameters
  * @num_pools:   number of buffer pools
  * @pools:       memory buffer pools parameters
  * @rx_cb:       receive callback
  * @cb_arg:      optional receive callback argument
+ * @rx_batch_cb: optional batched receive callback
+ * @rx_chain_cb: optional chained message receive callback
+ *
+ * When rx_batch_cb is set, it is used instead of rx_cb and receives all the
+ * buffers collected for the channel within one Rx budget round (at most
+ * IPC_SHM_RX_BATCH_SIZE per call). rx_cb may be NULL in this case.
+ * When rx_chain_cb is set, messages sent with ipc_shm_tx_chain() are delivered
+ * as a whole chain, otherwise they are dropped and their buffers released to
+ * remote: a piece of a chain is not a message rx_cb or rx_batch_cb can parse.
  */
 struct ipc_shm_managed_cfg {
 	uint8 num_pools;
@@ -424,6 +482,10 @@ struct ipc_shm_managed_cfg {
 	void (*rx_cb)(void *cb_arg, const uint8 instance, uint8 chan_id,
 			void *buf, uint32 size);
 	void *cb_arg;
+	void (*rx_batch_cb)(void *cb_arg, const uint8 instance, uint8 chan_id,
+			const struct ipc_shm_buf *bufs, uint32 num_bufs);
+	void (*rx_chain_cb)(void *cb_arg, const uint8 instance, uint8 chan_id,
+			const struct ipc_shm_chain *chain);
 };
 
 /**
@@ -36,6 +36,7 @@ void ipc_hw_irq_enable(const uint8 instance);
 void ipc_hw_irq_disable(const uint8 instance);
 void ipc_hw_irq_notify(const uint8 instance);
 void ipc_hw_irq_clear(const uint8 instance);
+uint32 ipc_hw_irq_pending(void);
 void ipc_hw_flush_cache_local(const uint8 instance);
 void ipc_hw_flush_cache_remote(const uint8 instance);
 
@@ -107,6 +107,25 @@ static struct ipc_hw_priv_type {
 	sint16 mscm_rx_irq;
 } ipc_hw_priv[IPC_SHM_MAX_INSTANCES];
 
+/* no instance notified by an MSCM status bit */
+#define IPC_HW_NO_INSTANCE 0xFFu
+
+/**
+ * struct ipc_hw_rx_line_type - instances sharing an MSCM inter-core rx interrupt
+ *
+ * @instance:       instance notified by each status bit (one bit per processor)
+ * @status_mask:    status bits of the remotes of all instances on the line
+ * @local_core:     local core of the instances on the line
+ */
+static struct ipc_hw_rx_line_type {
+	uint8 instance[IPC_MSCM_CPX_COUNT];
+	uint32 status_mask;
+	uint8 local_core;
+} ipc_hw_rx_line[IPC_MSCM_MSI_COUNT];
+
+/* rx interrupts with at least one instance, one bit per MSI index */
+static uint32 ipc_hw_rx_lines;
+
 /**
  * ipc_hw_get_core_index_m7() - Validate and get core index if core type is m7
  *
@@ -448,6 +467,107 @@ static sint8 ipc_hw_set_irq_idx(const uint8 instance,
 	return err;
 }
 
+/**
+ * ipc_hw_lowest_bit() - get lowest bit set
+ * @mask: non-zero bitmap
+ *
+ * Return: index of lowest bit set
+ */
+static inline uint8 ipc_hw_lowest_bit(uint32 mask)
+{
+#if defined(__GNUC__)
+	return (uint8)__builtin_ctz(mask);
+#else
+	uint8 bit = 0u;
+
+	while ((mask & 1u) == 0u) {
+		mask >>= 1u;
+		bit++;
+	}
+
+	return bit;
+#endif
+}
+
+/**
+ * ipc_hw_remote_mask() - get MSCM status bits set by the remote of an instance
+ *
+ * Return: status bit of the remote M7 core, or the bits of all A53 cores
+ */
+static uint32 ipc_hw_remote_mask(const uint8 instance)
+{
+	uint32 remote_mask;
+	uint8 remote_core = ipc_hw_priv[instance].remote_core;
+
+	if (((uint8)IPC_M7_0 <= remote_core)
+			&& (remote_core <= (uint8)IPC_M7_3)) {
+		remote_mask = ((uint32)1u << remote_core);
+	} else {
+		remote_mask = (uint32)IPC_MSCM_IRCPnISRx_CLEAR_A53;
+	}
+
+	return remote_mask;
+}
+
+/**
+ * ipc_hw_rx_line_remove() - remove instance from the rx interrupt lookup
+ */
+static void ipc_hw_rx_line_remove(const uint8 instance)
+{
+	struct ipc_hw_rx_line_type *line;
+	uint8 msi;
+	uint8 bit;
+
+	for (msi = 0u; msi < IPC_MSCM_MSI_COUNT; msi++) {
+		line = &ipc_hw_rx_line[msi];
+		for (bit = 0u; bit < IPC_MSCM_CPX_COUNT; bit++) {
+			if ((((line->status_mask >> bit) & 1u) != 0u)
+					&& (line->instance[bit] == instance)) {
+				line->instance[bit] = IPC_HW_NO_INSTANCE;
+				line->status_mask &= ~((uint32)1u << bit);
+			}
+		}
+		if (line->status_mask == 0u) {
+			ipc_hw_rx_lines &= ~((uint32)1u << msi);
+		}
+	}
+}
+
+/**
+ * ipc_hw_rx_line_add() - add instance to the rx interrupt lookup
+ *
+ * Return: IPC_SHM_E_OK for success, -IPC_SHM_E_INVAL if another instance is
+ *         notified on the same rx interrupt by the same remote
+ */
+static sint8 ipc_hw_rx_line_add(const uint8 instance)
+{
+	struct ipc_hw_rx_line_type *line;
+	sint8 err = IPC_SHM_E_OK;
+	uint32 remote_mask;
+	uint8 bit;
+
+	if (ipc_hw_priv[instance].mscm_rx_irq != IPC_IRQ_NONE) {
+		line = &ipc_hw_rx_line[ipc_hw_priv[instance].msi_rx_irq];
+		remote_mask = ipc_hw_remote_mask(instance);
+
+		if ((line->status_mask & remote_mask) != 0u) {
+			/* status bits could not tell the two instances apart */
+			err = -IPC_SHM_E_INVAL;
+		} else {
+			for (bit = 0u; bit < IPC_MSCM_CPX_COUNT; bit++) {
+				if (((remote_mask >> bit) & 1u) != 0u) {
+					line->instance[bit] = instance;
+				}
+			}
+			line->status_mask |= remote_mask;
+			line->local_core = ipc_hw_priv[instance].local_core;
+			ipc_hw_rx_lines |= ((uint32)1u << ipc_hw_priv[instance].msi_rx_irq);
+		}
+	}
+
+	return err;
+}
+
 /**
  * ipc_hw_init() - platform specific initialization
  *
@@ -465,18 +585,25 @@ static sint8 ipc_hw_set_irq_idx(const uint8 instance,
  * the same value to avoid possible race conditions when updating the value of
  * the IRSPRCn register. If the value IPC_CORE_DEFAULT is passed as remote_core,
  * the default value defined for the selected platform will be used instead.
+ * Instances may share an inter_core_rx_irq if their remote cores differ.
  *
  * Return: IPC_SHM_E_OK for success, -IPC_SHM_E_INVAL for either inter core
- *         interrupt invalid or invalid remote core
+ *         interrupt invalid, invalid remote core or rx interrupt already used
+ *         by another instance with the same remote
  */
 sint8 ipc_hw_init(const uint8 instance, const struct ipc_shm_cfg *cfg)
 {
 	sint8 err = IPC_SHM_E_OK;
 
+	ipc_hw_rx_line_remove(instance);
+
 	err = ipc_hw_set_core(instance, cfg);
 	if (err == IPC_SHM_E_OK) {
 		err = ipc_hw_set_irq_idx(instance, cfg);
 	}
+	if (err == IPC_SHM_E_OK) {
+		err = ipc_hw_rx_line_add(instance);
+	}
 
 	if (err == IPC_SHM_E_OK) {
 		ipc_hw_priv[instance].shm_size = cfg->shm_size;
@@ -500,6 +627,7 @@ sint8 ipc_hw_init(const uint8 instance, const struct ipc_shm_cfg *cfg)
 void ipc_hw_free(const uint8 instance)
 {
 	ipc_hw_irq_clear(instance);
+	ipc_hw_rx_line_remove(instance);
 }
 
 /**
@@ -577,24 +705,52 @@ void ipc_hw_irq_notify(const uint8 instance)
 void ipc_hw_irq_clear(const uint8 instance)
 {
 	uint8 local_core;
-	uint8 remote_core;
 	uint8 msi_rx_index;
 
 	if (ipc_hw_priv[instance].mscm_rx_irq != IPC_IRQ_NONE) {
 		local_core = ipc_hw_priv[instance].local_core;
-		remote_core = ipc_hw_priv[instance].remote_core;
 		msi_rx_index = ipc_hw_priv[instance].msi_rx_irq;
 
-		if (((uint8)IPC_M7_0 <= remote_core)
-				&& (remote_core <= (uint8)IPC_M7_3)) {
-			/* clear MSCM core-to-core directed interrupt */
-			IPC_MSCM_IRCPnIRx->IRCPnIRx[local_core][msi_rx_index].IPC_ISR
-				= ((uint32)1u << remote_core);
-		} else {
-			IPC_MSCM_IRCPnIRx->IRCPnIRx[local_core][msi_rx_index].IPC_ISR
-				= (uint32)IPC_MSCM_IRCPnISRx_CLEAR_A53;
+		/* clear MSCM core-to-core directed interrupt */
+		IPC_MSCM_IRCPnIRx->IRCPnIRx[local_core][msi_rx_index].IPC_ISR
+			= ipc_hw_remote_mask(instance);
+	}
+}
+
+/**
+ * ipc_hw_irq_pending() - get instances notified by their remote
+ *
+ * Used by a shared inter-core ISR to find which instances rang. Reads the
+ * MSCM status of every rx interrupt in use once and maps the status bits to
+ * instances, so the cost depends on the rx interrupts in use and on the
+ * instances that rang, not on the number of instances.
+ *
+ * Return: bitmap of pending instances (bit n for instance n)
+ */
+uint32 ipc_hw_irq_pending(void)
+{
+	const struct ipc_hw_rx_line_type *line;
+	uint32 pending = 0u;
+	uint32 lines = ipc_hw_rx_lines;
+	uint32 status;
+	uint8 msi;
+	uint8 bit;
+
+	while (lines != 0u) {
+		msi = ipc_hw_lowest_bit(lines);
+		lines &= lines - 1u;
+		line = &ipc_hw_rx_line[msi];
+
+		status = IPC_MSCM_IRCPnIRx->IRCPnIRx[line->local_core][msi].IPC_ISR
+			& line->status_mask;
+		while (status != 0u) {
+			bit = ipc_hw_lowest_bit(status);
+			status &= status - 1u;
+			pending |= ((uint32)1u << line->instance[bit]);
 		}
 	}
+
+	return pending;
 }
 
 /* generic cache flush */
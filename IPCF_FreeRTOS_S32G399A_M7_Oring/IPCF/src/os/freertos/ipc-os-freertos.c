@@ -96,16 +96,13 @@ extern "C"{
 	#define IPC_SOFTIRQ_PRIORITY (configMAX_PRIORITIES - 1)
 #endif
 
-/**
- * enum msg_receive - used to indicate notification received for a new message
- *
- * @MSG_NOT_RECEIVED: no new message received from the remote core
- * @MSG_IS_RECEIVED: new message received from the remote core
- */
-enum msg_receive {
-	MSG_NOT_RECEIVED = 0U,
-	MSG_IS_RECEIVED = 1U,
-};
+/* pending instances are tracked in a 32-bit bitmap */
+#if (IPC_SHM_MAX_INSTANCES > 32u)
+	#error "IPC_SHM_MAX_INSTANCES exceeds pending bitmap size"
+#endif
+
+/* bit of instance in pending bitmap */
+#define IPC_OS_INSTANCE_BIT(instance) ((uint32)1u << (instance))
 
 /* IPC softirq task */
 static void ipc_shm_softirq(void);
@@ -121,7 +118,6 @@ StaticTask_t IPC_xTaskBuffer;
  * @remote_shm:     remote shared memory address
  * @state:          state of instance
  * @rx_irq_num:     rx interrupt number
- * @msg_received:	state to indicate notification received for a new message
  * @rx_cb:          upper layer rx callback
  */
 struct ipc_os_priv_instance {
@@ -129,7 +125,6 @@ struct ipc_os_priv_instance {
 	uintptr remote_shm;
 	uint8 state;
 	sint16 rx_irq_num;
-	uint8 msg_received;
 	uint32 (*rx_cb)(const uint8 instance, uint32 budget);
 };
 
@@ -138,13 +133,41 @@ struct ipc_os_priv_instance {
  * @id:         private data per instance
  * @softirq_handle: rx task handle used by the ISR to notify the rx task
  * @task_is_initialized: flag to know if the softirq task is initialized
+ * @pending:    bitmap of instances notified by remote and not yet serviced
+ *
+ * The hardirq sets the bit of each ringing instance and the softirq only
+ * services instances whose bit is set, so the cost of a wakeup depends on the
+ * number of pending instances, not on IPC_SHM_MAX_INSTANCES.
  */
 static struct ipc_os_priv_type {
 	struct ipc_os_priv_instance id[IPC_SHM_MAX_INSTANCES];
 	TaskHandle_t softirq_handle;
 	boolean task_is_initialized;
+	volatile uint32 pending;
 } ipc_os_priv;
 
+/**
+ * ipc_os_lowest_instance() - get lowest instance from a pending bitmap
+ * @mask: non-zero pending bitmap
+ *
+ * Return: instance id of lowest bit set
+ */
+static inline uint8 ipc_os_lowest_instance(uint32 mask)
+{
+#if defined(__GNUC__)
+	return (uint8)__builtin_ctz(mask);
+#else
+	uint8 instance = 0u;
+
+	while ((mask & 1u) == 0u) {
+		mask >>= 1u;
+		instance++;
+	}
+
+	return instance;
+#endif
+}
+
 /**
  * ipc_os_init() - OS specific initialization code
  * @cfg:        configuration parameters
@@ -169,7 +192,7 @@ sint8 ipc_os_init(const uint8 instance, const struct ipc_shm_cfg *cfg,
 		ipc_os_priv.id[instance].state = IPC_SHM_INSTANCE_ENABLED;
 		ipc_os_priv.id[instance].rx_cb = rx_cb;
 		ipc_os_priv.id[instance].rx_irq_num = cfg->inter_core_rx_irq;
-		ipc_os_priv.id[instance].msg_received = (uint8)MSG_NOT_RECEIVED;
+		ipc_os_priv.pending &= ~IPC_OS_INSTANCE_BIT(instance);
 
 		if ((ipc_os_priv.id[instance].rx_irq_num == IPC_IRQ_NONE)
 			|| (ipc_os_priv.task_is_initialized != FALSE)) {
@@ -250,8 +273,11 @@ void ipc_os_free(const uint8 instance)
 	ipc_os_free_irq(instance);
 
 	/* clear private data */
-	ipc_os_priv.id[instance].rx_cb = NULL;
+	taskENTER_CRITICAL();
+	ipc_os_priv.pending &= ~IPC_OS_INSTANCE_BIT(instance);
 	ipc_os_priv.id[instance].state = IPC_SHM_INSTANCE_DISABLED;
+	taskEXIT_CRITICAL();
+	ipc_os_priv.id[instance].rx_cb = NULL;
 
 	/* Check if all non-polling instances are disable*/
 	for(instance_id = 0; instance_id < IPC_SHM_MAX_INSTANCES; instance_id++) {
@@ -275,65 +301,87 @@ void ipc_os_free(const uint8 instance)
  * ipc_shm_softirq() - task acting as deferred interrupt handler
  *
  * This task waits to be signaled by the interrupt handler, then calls the upper
- * layer callback registered with ipc_os_init(). If ipc_os_free() is called,
- * task execution terminates. Memory is freed next time the idle task is run.
+ * layer callback registered with ipc_os_init() for each pending instance. An
+ * instance that exhausts its budget is set pending again and serviced after
+ * the other pending instances, so no instance is starving. The irq of an
+ * instance is re-enabled as soon as all its work is done. If ipc_os_free() is
+ * called, task execution terminates. Memory is freed next time the idle task
+ * is run.
  */
 static void ipc_shm_softirq(void)
 {
 	uint32 work = 0;
+	uint32 pending = 0;
 	uint8 i = 0;
 
-	/* wait for signal from interrupt handler */
-	(void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
 	for ( ; ; ) {
-		for (i = 0; i < IPC_SHM_MAX_INSTANCES; i++) {
-			if ((ipc_os_priv.id[i].state == IPC_SHM_INSTANCE_DISABLED)
-				|| (ipc_os_priv.id[i].msg_received == (uint8)MSG_NOT_RECEIVED)
-				|| (ipc_os_priv.id[i].rx_irq_num == IPC_IRQ_NONE))
-				continue;
+		/* wait for signal from interrupt handler */
+		(void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
 
-			do {
-				/* call upper layer callback */
-				work = ipc_os_priv.id[i].rx_cb(i, IPC_SOFTIRQ_BUDGET);
+		for ( ; ; ) {
+			/* take snapshot of pending instances and clear them */
+			taskENTER_CRITICAL();
+			pending = ipc_os_priv.pending;
+			ipc_os_priv.pending = 0u;
+			taskEXIT_CRITICAL();
 
-				/* yield and wait for reschedule */
-				taskYIELD();
-			} while (work >= IPC_SOFTIRQ_BUDGET);
+			if (pending == 0u)
+				break;
 
-			/* reset the flag used to notify  message received */
-			ipc_os_priv.id[i].msg_received = (uint8)MSG_NOT_RECEIVED;
-		}
+			while (pending != 0u) {
+				i = ipc_os_lowest_instance(pending);
+				pending &= ~IPC_OS_INSTANCE_BIT(i);
 
-		for (i = 0; i < IPC_SHM_MAX_INSTANCES; i++) {
-			if (ipc_os_priv.id[i].state == IPC_SHM_INSTANCE_DISABLED)
-				continue;
+				if ((ipc_os_priv.id[i].state == IPC_SHM_INSTANCE_DISABLED)
+					|| (ipc_os_priv.id[i].rx_irq_num == IPC_IRQ_NONE))
+					continue;
 
-			/* work done, re-enable irq */
-			ipc_hw_irq_enable(i);
-		}
+				/* call upper layer callback */
+				work = ipc_os_priv.id[i].rx_cb(i, IPC_SOFTIRQ_BUDGET);
 
-		/* wait for signal from interrupt handler */
-		(void) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+				if (work >= IPC_SOFTIRQ_BUDGET) {
+					/* more work: service again in next round */
+					taskENTER_CRITICAL();
+					ipc_os_priv.pending |= IPC_OS_INSTANCE_BIT(i);
+					taskEXIT_CRITICAL();
+				} else {
+					/* work done, re-enable irq */
+					ipc_hw_irq_enable(i);
+				}
+			}
+
+			/* yield and wait for reschedule */
+			taskYIELD();
+		}
 	}
 }
 
 /**
  * ipc_shm_hardirq() - driver interrupt service routine
  *
- * In case of FreeRTOS this ISR is set from the application.
+ * In case of FreeRTOS this ISR is set from the application. Shared by all
+ * instances: the pending instances are read from the MSCM status of the rx
+ * interrupts in use. An instance with an rx interrupt of its own can use
+ * ipc_shm_hardirq_instance() instead.
  */
 void ipc_shm_hardirq(void)
 {
 	BaseType_t higher_prio_task_woken = (BaseType_t)pdFALSE;
 	UBaseType_t task_critical_status_from_isr;
+	uint32 rang = 0u;
+	uint32 notified = 0u;
 	uint8 i = 0;
 
 	/* ensure the ipc_shm_softirq is initialized */
 	if (ipc_os_priv.task_is_initialized != FALSE) {
 		task_critical_status_from_isr = taskENTER_CRITICAL_FROM_ISR();
 
-		for (i = 0; i < IPC_SHM_MAX_INSTANCES; i++) {
+		/* record only the instances whose remote rang (MSCM status) */
+		notified = ipc_hw_irq_pending();
+		while (notified != 0u) {
+			i = ipc_os_lowest_instance(notified);
+			notified &= notified - 1u;
+
 			if (ipc_os_priv.id[i].state == IPC_SHM_INSTANCE_DISABLED)
 				continue;
 
@@ -343,12 +391,16 @@ void ipc_shm_hardirq(void)
 			/* clear notification */
 			ipc_hw_irq_clear(i);
 
-			/* set the flag for each instance */
-			ipc_os_priv.id[i].msg_received = (uint8)MSG_IS_RECEIVED;
+			rang |= IPC_OS_INSTANCE_BIT(i);
 		}
 
-		/* schedule deferred interrupt handler */
-		vTaskNotifyGiveFromISR(ipc_os_priv.softirq_handle, &higher_prio_task_woken);
+		if (rang != 0u) {
+			ipc_os_priv.pending |= rang;
+
+			/* schedule deferred interrupt handler */
+			vTaskNotifyGiveFromISR(ipc_os_priv.softirq_handle,
+					&higher_prio_task_woken);
+		}
 		taskEXIT_CRITICAL_FROM_ISR(task_critical_status_from_isr);
 		portYIELD_FROM_ISR(higher_prio_task_woken);
 	}
@@ -373,10 +425,8 @@ void ipc_shm_hardirq_instance(const uint8 instance)
 			/* clear notification */
 			ipc_hw_irq_clear(instance);
 
-			/* set the flag used to notify message is received */
-			if (ipc_os_priv.id[instance].msg_received == (uint8)MSG_NOT_RECEIVED) {
-				ipc_os_priv.id[instance].msg_received = (uint8)MSG_IS_RECEIVED;
-			}
+			/* record the ringing instance */
+			ipc_os_priv.pending |= IPC_OS_INSTANCE_BIT(instance);
 
 			/* schedule deferred interrupt handler */
 			vTaskNotifyGiveFromISR(ipc_os_priv.softirq_handle,
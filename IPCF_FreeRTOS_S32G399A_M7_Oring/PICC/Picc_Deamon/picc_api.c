@@ -162,6 +162,11 @@ sint8 PICC_InitChannel(uint8 instanceId, uint8 channelId)
     stackCfg.maxSize    = PICC_STACK_MAX_SIZE;
     stackCfg.periodMs   = PICC_STACK_SEND_PERIOD_MS;
     stackCfg.crcEnabled = PICC_STACK_CRC_ENABLED;
+    stackCfg.flushThreshold  = PICC_STACK_FLUSH_THRESHOLD;
+    stackCfg.flushDeadlineMs = PICC_STACK_FLUSH_DEADLINE_MS;
+    stackCfg.flushOnIdle     = PICC_STACK_FLUSH_ON_IDLE;
+    stackCfg.highLaneEnabled = TRUE;
+    stackCfg.rxDropDuplicates = PICC_STACK_RX_DROP_DUPLICATES;
     ret = PICC_StackInitChannel(&stackCfg);
     if (ret != 0) {
         return ret;
@@ -362,6 +367,60 @@ sint8 PICC_ProcessRxData(const uint8 instance,uint8 chan_id, const void *buf, ui
     return PICC_E_PARAM;
 }
 
+/**
+ * @brief Check whether received IPCF message may be processed directly
+ * 
+ * Walks the stacked frame like PICC_StackProcessRx() does.
+ */
+boolean PICC_IsDirectRxData(const void *buf, uint32 size)
+{
+    const uint8 *data;
+    const uint8 *payload;
+    PICC_MsgHeader_t header;
+    uint16 msgPayloadLen;
+    uint32 payloadLen;
+    uint32 offset;
+    uint32 end;
+    uint32 msgTotalLen;
+
+    if ((buf == NULL) || (size < PICC_STACK_OVERHEAD_SIZE)) {
+        return FALSE;
+    }
+
+    data = (const uint8 *)buf;
+    offset = PICC_STACK_CRC_ENABLE_SIZE;
+    end = size - PICC_STACK_CRC_SIZE - PICC_STACK_COUNTER_SIZE;
+    payloadLen = end - offset;
+
+    /* Legacy heartbeat message (9 bytes, no protocol header) */
+    if (payloadLen == PICC_HEARTBEAT_MSG_SIZE) {
+        if ((PICC_HeartbeatIsPing(&data[offset], PICC_HEARTBEAT_MSG_SIZE) != FALSE) ||
+            (PICC_HeartbeatIsPong(&data[offset], PICC_HEARTBEAT_MSG_SIZE) != FALSE)) {
+            return TRUE;
+        }
+    }
+
+    while (offset < end) {
+        if (PICC_UnpackMessage(&data[offset], payloadLen, &header, &payload, &msgPayloadLen) != 0) {
+            return FALSE;  /* Malformed: let the Rx task report it */
+        }
+
+        if ((header.msgType == (uint8)PICC_MSG_LINK_AVAILABLE) ||
+            (PICC_ServiceIsDirect(&header) == FALSE)) {
+            return FALSE;
+        }
+
+        msgTotalLen = PICC_HEADER_SIZE + (uint32)msgPayloadLen;
+        if (msgTotalLen > payloadLen) {
+            return FALSE;
+        }
+        offset += msgTotalLen;
+        payloadLen -= msgTotalLen;
+    }
+
+    return TRUE;
+}
+
 #if defined(__cplusplus)
 }
 #endif
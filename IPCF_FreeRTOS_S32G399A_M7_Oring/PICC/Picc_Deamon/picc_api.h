@@ -172,7 +172,10 @@ sint8 PICC_MethodResponse(uint8 consumerId, uint8 methodId,
  * ========================================================================
  * New architecture: Each service module directly calls registration APIs in picc_service.h:
  * - PICC_RegisterEventHandler(providerId, callback)
+ * - PICC_RegisterEventIdHandler(providerId, eventId, callback)
  * - PICC_RegisterMethodHandler(localProviderId, callback)
+ * - PICC_RegisterMethodIdHandler(localProviderId, methodId, callback)
+ * - PICC_SetMethodResponseSize(localProviderId, methodId, maxRspLen)
  * - PICC_RegisterResponseHandler(callback)
  */
 
@@ -205,6 +208,21 @@ PICC_LinkState_e PICC_GetLinkState(uint8 channelId);
  */
 sint8 PICC_ProcessRxData(const uint8 instance, uint8 chan_id, const void *buf, uint32 size);
 
+/**
+ * @brief Check whether received IPCF message may be processed directly
+ * 
+ * TRUE if every protocol message of the stacked frame only runs lightweight
+ * handlers (@see PICC_ServiceIsDirect), so the frame may be processed in the
+ * IPCF receive callback instead of being deferred to the Rx task.
+ * Heartbeat-only frames are direct, Link messages are not. The frame is not
+ * verified here, PICC_ProcessRxData() still checks CRC and counter.
+ * 
+ * @param[in] buf   Receive buffer
+ * @param[in] size  Receive data length
+ * @return TRUE if the frame may be processed directly
+ */
+boolean PICC_IsDirectRxData(const void *buf, uint32 size);
+
 #if defined(__cplusplus)
 }
 #endif
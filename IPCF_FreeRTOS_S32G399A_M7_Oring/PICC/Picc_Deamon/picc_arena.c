@@ -0,0 +1,433 @@
+/**
+ * @file picc_arena.c
+ * @brief M-Core Inter-Core Communication Scratch Arena - Implementation
+ *
+ * Blocks are laid out back to back in one static array, each behind an
+ * 8-byte header (size, size of the previous block, owner, check byte).
+ * Free blocks are kept in size-class lists (one per power of two) and are
+ * merged with their free neighbours when freed, so an allocation takes the
+ * head of the first class that surely fits instead of walking the arena.
+ * All operations run in a short critical section of bounded length.
+ *
+ * Copyright 2024 NXP
+ * All Rights Reserved.
+ */
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "picc_arena.h"
+#include "Picc_main.h"    /* For HANDLE_ERROR */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*==================================================================================================
+ *                                         Private Macros
+ *==================================================================================================*/
+
+/** Header check byte (detects frees of foreign pointers) */
+#define PICC_ARENA_MAGIC            (0xA5U)
+
+/** Arena size in PICC_ARENA_ALIGN units (block sizes and offsets are kept in units) */
+#define PICC_ARENA_UNITS            ((uint16)(PICC_ARENA_SIZE / PICC_ARENA_ALIGN))
+
+/** Smallest block (units): header and free list links */
+#define PICC_ARENA_MIN_UNITS        (2U)
+
+/** Size classes: class c holds free blocks of [2^(c+1), 2^(c+2)) units */
+#define PICC_ARENA_CLASS_NUM        (15U)
+
+/** No block (end of a free list) */
+#define PICC_ARENA_NIL              (0xFFFFU)
+
+/*==================================================================================================
+ *                                         Private Types
+ *==================================================================================================*/
+
+/** Block header */
+typedef struct {
+    uint16  size;           /**< Block size including header (PICC_ARENA_ALIGN units) */
+    uint16  prevSize;       /**< Size of the previous block (units), 0 for the first block */
+    uint8   owner;          /**< @see PICC_ArenaOwner_e */
+    uint8   magic;          /**< PICC_ARENA_MAGIC */
+    uint8   charge;         /**< Owner whose quota the block is charged to */
+    uint8   reserved;       /**< Padding */
+} PICC_ArenaBlock_t;
+
+/** Free list links, kept in the data of a free block */
+typedef struct {
+    uint16  next;           /**< Next free block of the class (offset in units), PICC_ARENA_NIL if last */
+    uint16  prev;           /**< Previous free block of the class, PICC_ARENA_NIL if first */
+} PICC_ArenaLinks_t;
+
+/*==================================================================================================
+ *                                         Private Variables
+ *==================================================================================================*/
+
+/** Arena memory */
+static uint8 g_arenaMem[PICC_ARENA_SIZE] __attribute__((aligned(PICC_ARENA_ALIGN)));
+
+/** Arena statistics */
+static PICC_ArenaStats_t g_arenaStats;
+
+/** First free block per size class */
+static uint16 g_arenaFree[PICC_ARENA_CLASS_NUM];
+
+/** Size classes with a free block (bit per class) */
+static uint16 g_arenaFreeMask = 0U;
+
+/** Quota per owner (arena bytes) */
+static const uint32 g_arenaQuota[PICC_ARENA_OWNER_NUM] = {
+    0U,                             /* PICC_ARENA_OWNER_FREE */
+    PICC_ARENA_QUOTA_STACK,
+    PICC_ARENA_QUOTA_FRAG_TX,
+    PICC_ARENA_QUOTA_FRAG_RX,
+    PICC_ARENA_QUOTA_SERVICE
+};
+
+/** Block chain set up (on first allocation) */
+static boolean g_arenaReady = FALSE;
+
+#if (PICC_ARENA_SIZE_SYMBOL != 0)
+/** Arena size in bytes (static footprint, kept for the map file and TRACE32) */
+const uint32 g_piccArenaSize __attribute__((used)) = PICC_ARENA_SIZE;
+#endif
+
+/*==================================================================================================
+ *                                         Private Functions
+ *==================================================================================================*/
+
+/**
+ * @brief Get block header at offset (units)
+ */
+static PICC_ArenaBlock_t* PICC_ArenaBlockAt(uint16 offset)
+{
+    return (PICC_ArenaBlock_t *)(void *)&g_arenaMem[(uint32)offset * PICC_ARENA_ALIGN];
+}
+
+/**
+ * @brief Get free list links of the free block at offset (units)
+ */
+static PICC_ArenaLinks_t* PICC_ArenaLinksAt(uint16 offset)
+{
+    return (PICC_ArenaLinks_t *)(void *)&g_arenaMem[((uint32)offset * PICC_ARENA_ALIGN) +
+                                                    PICC_ARENA_BLOCK_OVERHEAD];
+}
+
+/**
+ * @brief Get size class of a block size (units)
+ */
+static uint8 PICC_ArenaClassOf(uint16 units)
+{
+    uint8 cls = 0U;
+
+    while (units >= 4U) {
+        units >>= 1U;
+        cls++;
+    }
+    return cls;
+}
+
+/**
+ * @brief Add a free block to the list of its class (in critical section)
+ */
+static void PICC_ArenaListInsert(uint16 offset)
+{
+    uint8 cls = PICC_ArenaClassOf(PICC_ArenaBlockAt(offset)->size);
+    PICC_ArenaLinks_t *links = PICC_ArenaLinksAt(offset);
+
+    links->prev = PICC_ARENA_NIL;
+    links->next = g_arenaFree[cls];
+    if (links->next != PICC_ARENA_NIL) {
+        PICC_ArenaLinksAt(links->next)->prev = offset;
+    }
+    g_arenaFree[cls] = offset;
+    g_arenaFreeMask |= (uint16)(1U << cls);
+}
+
+/**
+ * @brief Remove a free block from the list of its class (in critical section)
+ */
+static void PICC_ArenaListRemove(uint16 offset)
+{
+    uint8 cls = PICC_ArenaClassOf(PICC_ArenaBlockAt(offset)->size);
+    PICC_ArenaLinks_t *links = PICC_ArenaLinksAt(offset);
+
+    if (links->prev != PICC_ARENA_NIL) {
+        PICC_ArenaLinksAt(links->prev)->next = links->next;
+    } else {
+        g_arenaFree[cls] = links->next;
+        if (links->next == PICC_ARENA_NIL) {
+            g_arenaFreeMask &= (uint16)~(1U << cls);
+        }
+    }
+    if (links->next != PICC_ARENA_NIL) {
+        PICC_ArenaLinksAt(links->next)->prev = links->prev;
+    }
+}
+
+/**
+ * @brief Tell the block following offset the size of its predecessor (in critical section)
+ */
+static void PICC_ArenaLinkNext(uint16 offset)
+{
+    uint32 next = (uint32)offset + PICC_ArenaBlockAt(offset)->size;
+
+    if (next < PICC_ARENA_UNITS) {
+        PICC_ArenaBlockAt((uint16)next)->prevSize = PICC_ArenaBlockAt(offset)->size;
+    }
+}
+
+/**
+ * @brief Find a free block of at least need units (in critical section)
+ *
+ * Takes the head of the first class above the one of need, where every
+ * block fits. Only if none is left, the list of the class of need itself is
+ * searched.
+ *
+ * @return Offset (units), PICC_ARENA_NIL if no free block is large enough
+ */
+static uint16 PICC_ArenaFindFree(uint16 need)
+{
+    uint8 cls = PICC_ArenaClassOf(need);
+    uint8 c;
+    uint16 offset;
+
+    /* A need of exactly 2^(cls+1) units fits every block of its own class */
+    c = ((need & (need - 1U)) == 0U) ? cls : (uint8)(cls + 1U);
+    for (; c < PICC_ARENA_CLASS_NUM; c++) {
+        if ((g_arenaFreeMask & (uint16)(1U << c)) != 0U) {
+            return g_arenaFree[c];
+        }
+    }
+
+    offset = g_arenaFree[cls];
+    while ((offset != PICC_ARENA_NIL) && (PICC_ArenaBlockAt(offset)->size < need)) {
+        offset = PICC_ArenaLinksAt(offset)->next;
+    }
+    return offset;
+}
+
+/**
+ * @brief Get block header of a user pointer (in critical section)
+ *
+ * @return Header, NULL if the pointer is not an allocated arena block
+ */
+static PICC_ArenaBlock_t* PICC_ArenaHeaderOf(const void *block)
+{
+    const uint8 *p = (const uint8 *)block;
+    PICC_ArenaBlock_t *blk;
+
+    if ((p < &g_arenaMem[PICC_ARENA_BLOCK_OVERHEAD]) || (p >= &g_arenaMem[PICC_ARENA_SIZE]) ||
+        (((uint32)(p - g_arenaMem) % PICC_ARENA_ALIGN) != 0U)) {
+        return NULL;
+    }
+
+    blk = (PICC_ArenaBlock_t *)(void *)(p - PICC_ARENA_BLOCK_OVERHEAD);
+    if ((blk->magic != PICC_ARENA_MAGIC) || (blk->owner == (uint8)PICC_ARENA_OWNER_FREE) ||
+        (blk->owner >= (uint8)PICC_ARENA_OWNER_NUM)) {
+        return NULL;
+    }
+    return blk;
+}
+
+/**
+ * @brief Set up one free block spanning the arena (in critical section)
+ */
+static void PICC_ArenaSetup(void)
+{
+    PICC_ArenaBlock_t *blk = PICC_ArenaBlockAt(0U);
+    uint8 c;
+
+    for (c = 0U; c < PICC_ARENA_CLASS_NUM; c++) {
+        g_arenaFree[c] = PICC_ARENA_NIL;
+    }
+    g_arenaFreeMask = 0U;
+
+    blk->size     = PICC_ARENA_UNITS;
+    blk->prevSize = 0U;
+    blk->owner    = (uint8)PICC_ARENA_OWNER_FREE;
+    blk->magic    = PICC_ARENA_MAGIC;
+    PICC_ArenaListInsert(0U);
+    g_arenaStats.size = PICC_ARENA_SIZE;
+    g_arenaReady = TRUE;
+}
+
+/*==================================================================================================
+ *                                         Public Functions
+ *==================================================================================================*/
+
+/**
+ * @brief Allocate a scratch block
+ */
+void* PICC_ArenaAlloc(uint32 size, PICC_ArenaOwner_e owner)
+{
+    PICC_ArenaBlock_t *blk;
+    PICC_ArenaBlock_t *rest;
+    uint32 bytes;
+    uint16 need;
+    uint16 offset;
+    void *ret = NULL;
+
+    if ((size == 0U) || (size > (PICC_ARENA_SIZE - PICC_ARENA_BLOCK_OVERHEAD)) ||
+        (owner == PICC_ARENA_OWNER_FREE) || (owner >= PICC_ARENA_OWNER_NUM)) {
+        return NULL;
+    }
+    bytes = PICC_ARENA_BLOCK_SIZE(size);
+    need = (uint16)(bytes / PICC_ARENA_ALIGN);
+
+    taskENTER_CRITICAL();
+
+    if (g_arenaReady == FALSE) {
+        PICC_ArenaSetup();
+    }
+
+    if ((g_arenaStats.chargedTo[owner] + bytes) > g_arenaQuota[owner]) {
+        g_arenaStats.overQuota++;
+        offset = PICC_ARENA_NIL;
+    } else {
+        offset = PICC_ArenaFindFree(need);
+    }
+
+    if (offset != PICC_ARENA_NIL) {
+        PICC_ArenaListRemove(offset);
+        blk = PICC_ArenaBlockAt(offset);
+
+        /* Split off the rest if it can hold a block */
+        if (((uint32)blk->size - need) >= PICC_ARENA_MIN_UNITS) {
+            rest = PICC_ArenaBlockAt((uint16)(offset + need));
+            rest->size  = (uint16)(blk->size - need);
+            rest->owner = (uint8)PICC_ARENA_OWNER_FREE;
+            rest->magic = PICC_ARENA_MAGIC;
+            blk->size = need;
+            PICC_ArenaLinkNext(offset);
+            PICC_ArenaLinkNext((uint16)(offset + need));
+            PICC_ArenaListInsert((uint16)(offset + need));
+        }
+        blk->owner  = (uint8)owner;
+        blk->charge = (uint8)owner;
+        blk->magic  = PICC_ARENA_MAGIC;
+
+        bytes = (uint32)blk->size * PICC_ARENA_ALIGN;
+        g_arenaStats.allocs++;
+        g_arenaStats.used += bytes;
+        g_arenaStats.usedBy[owner] += bytes;
+        g_arenaStats.chargedTo[owner] += bytes;
+        if (g_arenaStats.used > g_arenaStats.highWater) {
+            g_arenaStats.highWater = g_arenaStats.used;
+        }
+        ret = &g_arenaMem[((uint32)offset * PICC_ARENA_ALIGN) + PICC_ARENA_BLOCK_OVERHEAD];
+    } else {
+        g_arenaStats.failures++;
+        if (bytes > g_arenaStats.largestFailed) {
+            g_arenaStats.largestFailed = bytes;
+        }
+    }
+
+    taskEXIT_CRITICAL();
+
+    return ret;
+}
+
+/**
+ * @brief Free a scratch block
+ */
+void PICC_ArenaFree(void *block)
+{
+    PICC_ArenaBlock_t *blk;
+    PICC_ArenaBlock_t *next;
+    PICC_ArenaBlock_t *prev;
+    uint16 offset;
+    uint32 bytes;
+
+    if (block == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    blk = PICC_ArenaHeaderOf(block);
+    if (blk != NULL) {
+        bytes = (uint32)blk->size * PICC_ARENA_ALIGN;
+        g_arenaStats.frees++;
+        g_arenaStats.used -= bytes;
+        g_arenaStats.usedBy[blk->owner] -= bytes;
+        g_arenaStats.chargedTo[blk->charge] -= bytes;
+        blk->owner = (uint8)PICC_ARENA_OWNER_FREE;
+        offset = (uint16)(((uint32)((const uint8 *)blk - g_arenaMem)) / PICC_ARENA_ALIGN);
+
+        /* Merge with free neighbours */
+        if (((uint32)offset + blk->size) < PICC_ARENA_UNITS) {
+            next = PICC_ArenaBlockAt((uint16)(offset + blk->size));
+            if (next->owner == (uint8)PICC_ARENA_OWNER_FREE) {
+                PICC_ArenaListRemove((uint16)(offset + blk->size));
+                blk->size = (uint16)(blk->size + next->size);
+            }
+        }
+        if (blk->prevSize != 0U) {
+            prev = PICC_ArenaBlockAt((uint16)(offset - blk->prevSize));
+            if (prev->owner == (uint8)PICC_ARENA_OWNER_FREE) {
+                PICC_ArenaListRemove((uint16)(offset - blk->prevSize));
+                prev->size = (uint16)(prev->size + blk->size);
+                offset = (uint16)(offset - blk->prevSize);
+            }
+        }
+        PICC_ArenaLinkNext(offset);
+        PICC_ArenaListInsert(offset);
+    }
+    taskEXIT_CRITICAL();
+
+    if (blk == NULL) {
+        HANDLE_ERROR(-46);  /* Arena: free of an invalid or already free block */
+    }
+}
+
+/**
+ * @brief Hand a block off to another owner
+ */
+sint8 PICC_ArenaHandoff(void *block, PICC_ArenaOwner_e from, PICC_ArenaOwner_e to)
+{
+    PICC_ArenaBlock_t *blk;
+    sint8 ret = -1;
+
+    if ((to == PICC_ARENA_OWNER_FREE) || (to >= PICC_ARENA_OWNER_NUM)) {
+        return -1;
+    }
+
+    taskENTER_CRITICAL();
+    blk = PICC_ArenaHeaderOf(block);
+    if ((blk != NULL) && (blk->owner == (uint8)from)) {
+        g_arenaStats.usedBy[from] -= blk->size;
+        g_arenaStats.usedBy[to] += blk->size;
+        g_arenaStats.handoffs++;
+        blk->owner = (uint8)to;
+        ret = 0;
+    }
+    taskEXIT_CRITICAL();
+
+    if (ret != 0) {
+        HANDLE_ERROR(-46);  /* Arena: handoff of a block not owned by the caller */
+    }
+    return ret;
+}
+
+/**
+ * @brief Get arena statistics
+ */
+sint8 PICC_ArenaGetStats(PICC_ArenaStats_t *stats)
+{
+    if (stats == NULL) {
+        return -1;
+    }
+
+    taskENTER_CRITICAL();
+    *stats = g_arenaStats;
+    stats->size = PICC_ARENA_SIZE;
+    taskEXIT_CRITICAL();
+
+    return 0;
+}
+
+#if defined(__cplusplus)
+}
+#endif
@@ -0,0 +1,187 @@
+/**
+ * @file picc_arena.h
+ * @brief M-Core Inter-Core Communication Scratch Arena - Interface Definition
+ *
+ * One shared arena of variable-size scratch blocks replaces the fixed
+ * per-module buffers (stack fallback windows, fragment transfer and
+ * reassembly buffers, Method response buffer), which were idle most of the
+ * time. Every block carries its owner; a block can be handed off to another
+ * owner without copying. Used bytes per owner, high water mark and failed
+ * allocations are kept for TRACE32 / PICC_ArenaGetStats().
+ *
+ * The arena is shared: it holds one fragmented message, the stack fallback
+ * windows and one Method response, not the worst case of every owner at
+ * once. Each owner has a quota (its worst case) that only caps its use, so
+ * one owner cannot starve the others: a second 16 KB reassembly is refused
+ * instead of taking the stack fallback windows.
+ *
+ * Copyright 2024 NXP
+ * All Rights Reserved.
+ */
+
+#ifndef PICC_ARENA_H
+#define PICC_ARENA_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "picc_protocol.h"
+#include "picc_frag.h"
+
+/*==================================================================================================
+ *                                         Macro Definitions
+ *==================================================================================================*/
+
+/** Block alignment (bytes) */
+#define PICC_ARENA_ALIGN            (8U)
+
+/** Block header size (bytes, counted in every block) */
+#define PICC_ARENA_BLOCK_OVERHEAD   (8U)
+
+/** Arena bytes taken by a block of n usable bytes */
+#define PICC_ARENA_BLOCK_SIZE(n)    ((((n) + PICC_ARENA_BLOCK_OVERHEAD) + (PICC_ARENA_ALIGN - 1U)) & \
+                                     ~(PICC_ARENA_ALIGN - 1U))
+
+/*
+ * Owner quotas in arena bytes (headers included). A quota caps the use of
+ * one owner, the arena is shared by all of them. Each owner checks at build
+ * time that its largest block fits its quota; the quota is charged to the
+ * allocating owner until the block is freed, also after a handoff.
+ */
+
+/** Stack: two fallback windows (IPCF buffers exhausted or remote not ready) */
+#ifndef PICC_ARENA_QUOTA_STACK
+#define PICC_ARENA_QUOTA_STACK      (2U * PICC_ARENA_BLOCK_SIZE(PICC_MAX_PAYLOAD_SIZE))
+#endif
+
+/** Fragment transfer: one PICC_FRAG_MAX_SIZE message with fragment header */
+#ifndef PICC_ARENA_QUOTA_FRAG_TX
+#define PICC_ARENA_QUOTA_FRAG_TX    (PICC_ARENA_BLOCK_SIZE(PICC_FRAG_HEADER_SIZE + PICC_FRAG_MAX_SIZE))
+#endif
+
+/** Fragment reassembly: one PICC_FRAG_MAX_SIZE message (handed off to the service layer) */
+#ifndef PICC_ARENA_QUOTA_FRAG_RX
+#define PICC_ARENA_QUOTA_FRAG_RX    (PICC_ARENA_BLOCK_SIZE(PICC_FRAG_MAX_SIZE))
+#endif
+
+/** Service: a full-size Method response and a queued request copy */
+#ifndef PICC_ARENA_QUOTA_SERVICE
+#define PICC_ARENA_QUOTA_SERVICE    (2U * PICC_ARENA_BLOCK_SIZE(PICC_MAX_PAYLOAD_SIZE))
+#endif
+
+/** Largest fragment buffer (transfer or reassembly) */
+#define PICC_ARENA_FRAG_MAX         ((PICC_ARENA_QUOTA_FRAG_TX > PICC_ARENA_QUOTA_FRAG_RX) ? \
+                                     PICC_ARENA_QUOTA_FRAG_TX : PICC_ARENA_QUOTA_FRAG_RX)
+
+/**
+ * Arena size in bytes (multiple of PICC_ARENA_ALIGN, override from build settings):
+ * one fragment buffer, the stack fallback windows and one Method response
+ */
+#ifndef PICC_ARENA_SIZE
+#define PICC_ARENA_SIZE             (PICC_ARENA_FRAG_MAX + PICC_ARENA_QUOTA_STACK + \
+                                     PICC_ARENA_BLOCK_SIZE(PICC_MAX_PAYLOAD_SIZE))
+#endif
+
+/** Export the arena size as symbol g_piccArenaSize for the map file / TRACE32 (0 = off) */
+#ifndef PICC_ARENA_SIZE_SYMBOL
+#define PICC_ARENA_SIZE_SYMBOL      (0)
+#endif
+
+#if ((PICC_ARENA_SIZE % PICC_ARENA_ALIGN) != 0U) || (PICC_ARENA_SIZE < (4U * PICC_ARENA_BLOCK_OVERHEAD))
+#error "PICC_ARENA_SIZE: must be a multiple of PICC_ARENA_ALIGN and hold at least one block"
+#endif
+
+#if (PICC_ARENA_SIZE > (0xFFFEU * PICC_ARENA_ALIGN))
+#error "PICC_ARENA_SIZE: block offsets are kept in 16 bits of PICC_ARENA_ALIGN units"
+#endif
+
+#if (PICC_ARENA_SIZE < PICC_ARENA_FRAG_MAX) || (PICC_ARENA_SIZE < PICC_ARENA_QUOTA_STACK) || \
+    (PICC_ARENA_SIZE < PICC_ARENA_QUOTA_SERVICE)
+#error "PICC_ARENA_SIZE: smaller than an owner quota"
+#endif
+
+/*==================================================================================================
+ *                                         Enum Types
+ *==================================================================================================*/
+
+/**
+ * @brief Block owner
+ */
+typedef enum {
+    PICC_ARENA_OWNER_FREE = 0U,     /**< Free block */
+    PICC_ARENA_OWNER_STACK,         /**< Stack window fallback buffer */
+    PICC_ARENA_OWNER_FRAG_TX,       /**< Fragment transfer buffer */
+    PICC_ARENA_OWNER_FRAG_RX,       /**< Fragment reassembly buffer */
+    PICC_ARENA_OWNER_SERVICE,       /**< Service layer (response, reassembled message delivery) */
+    PICC_ARENA_OWNER_NUM            /**< Number of owners */
+} PICC_ArenaOwner_e;
+
+/*==================================================================================================
+ *                                         Structure Definitions
+ *==================================================================================================*/
+
+/**
+ * @brief Arena statistics (bytes include block headers)
+ */
+typedef struct {
+    uint32  size;                               /**< PICC_ARENA_SIZE */
+    uint32  used;                               /**< Bytes in use */
+    uint32  highWater;                          /**< Largest bytes in use */
+    uint32  allocs;                             /**< Successful allocations */
+    uint32  frees;                              /**< Blocks freed */
+    uint32  handoffs;                           /**< Blocks handed off */
+    uint32  failures;                           /**< Allocations failed (no free block large enough) */
+    uint32  largestFailed;                      /**< Largest failed request (bytes) */
+    uint32  overQuota;                          /**< Allocations refused by the owner quota */
+    uint32  usedBy[PICC_ARENA_OWNER_NUM];       /**< Bytes in use per owner */
+    uint32  chargedTo[PICC_ARENA_OWNER_NUM];    /**< Bytes charged to the quota of each owner */
+} PICC_ArenaStats_t;
+
+/*==================================================================================================
+ *                                         Function Declarations
+ *==================================================================================================*/
+
+/**
+ * @brief Allocate a scratch block
+ *
+ * Good fit from size-class free lists, bounded time. Task context, may be
+ * called in critical section. No error is raised on failure (exhausted arena
+ * or owner quota): callers treat it like a full queue.
+ *
+ * @param[in] size  Usable bytes
+ * @param[in] owner Owner of the block
+ * @return Block (PICC_ARENA_ALIGN aligned), NULL if size is 0 or no block is free
+ */
+void* PICC_ArenaAlloc(uint32 size, PICC_ArenaOwner_e owner);
+
+/**
+ * @brief Free a scratch block
+ *
+ * @param[in] block Block from PICC_ArenaAlloc() (NULL is ignored)
+ */
+void PICC_ArenaFree(void *block);
+
+/**
+ * @brief Hand a block off to another owner (no copy)
+ *
+ * @param[in] block Block from PICC_ArenaAlloc()
+ * @param[in] from  Current owner
+ * @param[in] to    New owner
+ * @return 0 on success, non-zero if the block is not owned by from
+ */
+sint8 PICC_ArenaHandoff(void *block, PICC_ArenaOwner_e from, PICC_ArenaOwner_e to);
+
+/**
+ * @brief Get arena statistics
+ *
+ * @param[out] stats Statistics copy
+ * @return 0 on success, non-zero on failure
+ */
+sint8 PICC_ArenaGetStats(PICC_ArenaStats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* PICC_ARENA_H */
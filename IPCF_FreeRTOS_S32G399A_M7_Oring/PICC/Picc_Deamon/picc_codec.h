@@ -0,0 +1,382 @@
+/**
+ * @file picc_codec.h
+ * @brief M-Core Inter-Core Communication Payload Codec Generator - Interface Definition
+ *
+ * Generates typed service payload codecs from a service description, at
+ * compile time, so services no longer pack payloads by hand.
+ *
+ * A service description (see picc_pwr_svc.h) provides:
+ *
+ *   #define <Svc>_PROVIDER_ID            <ProviderID>
+ *   #define <Svc>_MESSAGES(X)            X(<Svc>, <Msg>, EVENT | METHOD, <ID>) ...
+ *   #define <Svc>_<Msg>_FIELDS(U8, U16, U32, ARR, VAR, TAIL)   field list
+ *
+ * Field kinds (wire format big-endian, in list order):
+ *   U8(f) / U16(f) / U32(f)  unsigned integer
+ *   ARR(f, n)                fixed array of n bytes
+ *   VAR(f, max)              [Length 2B BE][up to max bytes], member f##Len
+ *   TAIL(f, max)             rest of payload, last field only: member f##Len
+ *                            keeps up to max bytes (a longer tail is truncated,
+ *                            not rejected), f##WireLen the bytes received
+ *
+ * Message kinds (server view, as PICC_ROLE_SERVER services):
+ *   EVENT   sent by this core:      <Svc>_<Msg>_Send()
+ *   METHOD  received by this core:  <Svc>_<Msg>_Handle() implemented by the
+ *                                   service, called by <Svc>_ServiceDispatch()
+ *
+ * PICC_CODEC_DECLARE_SERVICE(<Svc>) in the service header generates per message
+ * <Svc>_<Msg>_t, <Svc>_<Msg>_ID / _MIN_SIZE / _MAX_SIZE and the prototypes;
+ * PICC_CODEC_DEFINE_SERVICE(<Svc>) in one source file generates the functions.
+ * Test builds (PICC_CODEC_SELFTEST_ENABLE) also get <Svc>_SelfTest(): an
+ * encode/decode round trip of every message.
+ *
+ * Encode/decode check the buffer once against _MIN_SIZE (all fixed fields),
+ * then store/load fixed fields without further checks, so fixed layouts
+ * compile to straight-line byte stores. VAR/TAIL fields are checked against
+ * their maximum and the space left.
+ *
+ * Copyright 2024 NXP
+ * All Rights Reserved.
+ */
+
+#ifndef PICC_CODEC_H
+#define PICC_CODEC_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "picc_service.h"
+
+/** Generate <Svc>_SelfTest() (host test builds, 0 = off) */
+#ifndef PICC_CODEC_SELFTEST_ENABLE
+#define PICC_CODEC_SELFTEST_ENABLE  (0)
+#endif
+
+/*==================================================================================================
+ *                                         Byte Access Macros
+ *==================================================================================================*/
+
+/** Store big-endian */
+#define PICC_CODEC_PUT_U16(p, v)    do { (p)[0] = (uint8)((uint16)(v) >> 8U); \
+                                         (p)[1] = (uint8)(v); } while (0)
+#define PICC_CODEC_PUT_U32(p, v)    do { (p)[0] = (uint8)((uint32)(v) >> 24U); \
+                                         (p)[1] = (uint8)((uint32)(v) >> 16U); \
+                                         (p)[2] = (uint8)((uint32)(v) >> 8U); \
+                                         (p)[3] = (uint8)(v); } while (0)
+
+/** Load big-endian */
+#define PICC_CODEC_GET_U16(p)       (uint16)(((uint16)(p)[0] << 8U) | (uint16)(p)[1])
+#define PICC_CODEC_GET_U32(p)       (((uint32)(p)[0] << 24U) | ((uint32)(p)[1] << 16U) | \
+                                     ((uint32)(p)[2] << 8U) | (uint32)(p)[3])
+
+/** Copy bytes */
+#define PICC_CODEC_COPY(d, s, n)    do { uint32 i_; \
+                                         for (i_ = 0U; i_ < (uint32)(n); i_++) { (d)[i_] = (s)[i_]; } \
+                                    } while (0)
+
+/*==================================================================================================
+ *                                         Field Expansions
+ *==================================================================================================*/
+
+/* Structure members */
+#define PICC_CODEC_MEMBER_U8(f)         uint8  f;
+#define PICC_CODEC_MEMBER_U16(f)        uint16 f;
+#define PICC_CODEC_MEMBER_U32(f)        uint32 f;
+#define PICC_CODEC_MEMBER_ARR(f, n)     uint8  f[n];
+#define PICC_CODEC_MEMBER_VAR(f, max)   uint16 f##Len; uint8 f[max];
+#define PICC_CODEC_MEMBER_TAIL(f, max)  uint16 f##Len; uint16 f##WireLen; uint8 f[max];
+
+/* Minimum wire size (fixed fields and length prefixes) */
+#define PICC_CODEC_MIN_U8(f)            + 1U
+#define PICC_CODEC_MIN_U16(f)           + 2U
+#define PICC_CODEC_MIN_U32(f)           + 4U
+#define PICC_CODEC_MIN_ARR(f, n)        + (n)
+#define PICC_CODEC_MIN_VAR(f, max)      + 2U
+#define PICC_CODEC_MIN_TAIL(f, max)     + 0U
+
+/* Maximum wire size */
+#define PICC_CODEC_MAX_U8(f)            + 1U
+#define PICC_CODEC_MAX_U16(f)           + 2U
+#define PICC_CODEC_MAX_U32(f)           + 4U
+#define PICC_CODEC_MAX_ARR(f, n)        + (n)
+#define PICC_CODEC_MAX_VAR(f, max)      + 2U + (max)
+#define PICC_CODEC_MAX_TAIL(f, max)     + (max)
+
+/* Encode: m = message, buf = output, pos = offset, slack = bytes left for VAR/TAIL data */
+#define PICC_CODEC_ENC_U8(f)            buf[pos] = m->f; pos += 1U;
+#define PICC_CODEC_ENC_U16(f)           PICC_CODEC_PUT_U16(&buf[pos], m->f); pos += 2U;
+#define PICC_CODEC_ENC_U32(f)           PICC_CODEC_PUT_U32(&buf[pos], m->f); pos += 4U;
+#define PICC_CODEC_ENC_ARR(f, n)        PICC_CODEC_COPY(&buf[pos], m->f, (n)); pos += (n);
+#define PICC_CODEC_ENC_VAR(f, max)                                              \
+    if (((uint32)m->f##Len > (uint32)(max)) || ((uint32)m->f##Len > slack)) {   \
+        return -1;                                                              \
+    }                                                                           \
+    slack -= m->f##Len;                                                         \
+    PICC_CODEC_PUT_U16(&buf[pos], m->f##Len); pos += 2U;                        \
+    PICC_CODEC_COPY(&buf[pos], m->f, m->f##Len); pos += m->f##Len;
+#define PICC_CODEC_ENC_TAIL(f, max)                                             \
+    if (((uint32)m->f##Len > (uint32)(max)) || ((uint32)m->f##Len > slack)) {   \
+        return -1;                                                              \
+    }                                                                           \
+    slack -= m->f##Len;                                                         \
+    PICC_CODEC_COPY(&buf[pos], m->f, m->f##Len); pos += m->f##Len;
+
+/* Decode: m = message, buf = input, len = input length */
+#define PICC_CODEC_DEC_U8(f)            m->f = buf[pos]; pos += 1U;
+#define PICC_CODEC_DEC_U16(f)           m->f = PICC_CODEC_GET_U16(&buf[pos]); pos += 2U;
+#define PICC_CODEC_DEC_U32(f)           m->f = PICC_CODEC_GET_U32(&buf[pos]); pos += 4U;
+#define PICC_CODEC_DEC_ARR(f, n)        PICC_CODEC_COPY(m->f, &buf[pos], (n)); pos += (n);
+#define PICC_CODEC_DEC_VAR(f, max)                                              \
+    cnt = PICC_CODEC_GET_U16(&buf[pos]); pos += 2U;                             \
+    if ((cnt > (uint32)(max)) || (cnt > slack)) {                               \
+        return -1;                                                              \
+    }                                                                           \
+    slack -= cnt;                                                               \
+    m->f##Len = (uint16)cnt;                                                    \
+    PICC_CODEC_COPY(m->f, &buf[pos], cnt); pos += cnt;
+#define PICC_CODEC_DEC_TAIL(f, max)                                             \
+    cnt = (uint32)len - pos;                                                    \
+    m->f##WireLen = (uint16)cnt;                                                \
+    if (cnt > (uint32)(max)) {                                                  \
+        cnt = (uint32)(max);    /* Truncate: keep the first max bytes */        \
+    }                                                                           \
+    m->f##Len = (uint16)cnt;                                                    \
+    PICC_CODEC_COPY(m->f, &buf[pos], cnt); pos = len;
+
+/* Self test fill: m = message, seed = next byte value */
+#define PICC_CODEC_FILL_U8(f)           m.f = seed; seed++;
+#define PICC_CODEC_FILL_U16(f)          m.f = (uint16)(((uint16)seed << 8U) | 0x5AU); seed++;
+#define PICC_CODEC_FILL_U32(f)          m.f = ((uint32)seed << 24U) | 0x00A55A01UL; seed++;
+#define PICC_CODEC_FILL_ARR(f, n)       for (i = 0U; i < (uint32)(n); i++) { m.f[i] = seed; seed++; }
+#define PICC_CODEC_FILL_VAR(f, max)     m.f##Len = (uint16)(max); PICC_CODEC_FILL_ARR(f, max)
+#define PICC_CODEC_FILL_TAIL(f, max)    m.f##Len = (uint16)(max); m.f##WireLen = (uint16)(max); \
+                                        PICC_CODEC_FILL_ARR(f, max)
+
+/*==================================================================================================
+ *                                         Declaration Generator (service header)
+ *==================================================================================================*/
+
+/** Send stub (EVENT) / user handler (METHOD) prototypes */
+#define PICC_CODEC_DECLARE_EVENT(svc, name)                                     \
+    sint8 svc##_##name##_Send(const svc##_##name##_t *m, uint8 consumerId,      \
+                              PICC_EventType_e withAck, uint8 channelId);
+#define PICC_CODEC_DECLARE_METHOD(svc, name)                                    \
+    uint8 svc##_##name##_Handle(uint8 consumerId, const svc##_##name##_t *req);
+
+/** Message type, sizes and codec prototypes */
+#define PICC_CODEC_DECLARE_MSG(svc, name, kind, id)                             \
+    typedef struct {                                                            \
+        svc##_##name##_FIELDS(PICC_CODEC_MEMBER_U8, PICC_CODEC_MEMBER_U16,      \
+                              PICC_CODEC_MEMBER_U32, PICC_CODEC_MEMBER_ARR,     \
+                              PICC_CODEC_MEMBER_VAR, PICC_CODEC_MEMBER_TAIL)    \
+    } svc##_##name##_t;                                                         \
+    enum {                                                                      \
+        svc##_##name##_ID       = (id),                                         \
+        svc##_##name##_MIN_SIZE = 0U                                            \
+            svc##_##name##_FIELDS(PICC_CODEC_MIN_U8, PICC_CODEC_MIN_U16,        \
+                                  PICC_CODEC_MIN_U32, PICC_CODEC_MIN_ARR,       \
+                                  PICC_CODEC_MIN_VAR, PICC_CODEC_MIN_TAIL),     \
+        svc##_##name##_MAX_SIZE = 0U                                            \
+            svc##_##name##_FIELDS(PICC_CODEC_MAX_U8, PICC_CODEC_MAX_U16,        \
+                                  PICC_CODEC_MAX_U32, PICC_CODEC_MAX_ARR,       \
+                                  PICC_CODEC_MAX_VAR, PICC_CODEC_MAX_TAIL)      \
+    };                                                                          \
+    sint32 svc##_##name##_Encode(const svc##_##name##_t *m, uint8 *buf, uint16 size); \
+    sint32 svc##_##name##_Decode(svc##_##name##_t *m, const uint8 *buf, uint16 len);  \
+    PICC_CODEC_DECLARE_##kind(svc, name)
+
+/** Self test prototype (test builds) */
+#if (PICC_CODEC_SELFTEST_ENABLE != 0)
+#define PICC_CODEC_DECLARE_SELFTEST(svc)    sint8 svc##_SelfTest(void);
+#else
+#define PICC_CODEC_DECLARE_SELFTEST(svc)
+#endif
+
+/**
+ * @brief Declare service codecs
+ *
+ * <Svc>_<Msg>_Encode() returns the encoded length, <Svc>_<Msg>_Decode() the
+ * consumed length (trailing bytes of newer peers are ignored), -1 on error.
+ * <Svc>_ServiceDispatch() is a PICC_MethodCallback_t decoding requests for
+ * <Svc>_<Msg>_Handle(), <Svc>_ServiceRegister() registers it.
+ */
+#define PICC_CODEC_DECLARE_SERVICE(svc)                                         \
+    svc##_MESSAGES(PICC_CODEC_DECLARE_MSG)                                      \
+    uint8 svc##_ServiceDispatch(uint8 consumerId, uint8 methodId,               \
+                                const uint8 *reqData, uint16 reqLen,            \
+                                uint8 *rspData, uint16 *rspLen);                \
+    sint8 svc##_ServiceRegister(uint8 flags);                                   \
+    PICC_CODEC_DECLARE_SELFTEST(svc)
+
+/*==================================================================================================
+ *                                         Definition Generator (one source file)
+ *==================================================================================================*/
+
+/** Event send stub */
+#define PICC_CODEC_DEFINE_EVENT(svc, name)                                      \
+    sint8 svc##_##name##_Send(const svc##_##name##_t *m, uint8 consumerId,      \
+                              PICC_EventType_e withAck, uint8 channelId)        \
+    {                                                                           \
+        uint8 buf[svc##_##name##_MAX_SIZE];                                     \
+        sint32 len = svc##_##name##_Encode(m, buf, (uint16)sizeof(buf));        \
+        if (len < 0) {                                                          \
+            return -1;                                                          \
+        }                                                                       \
+        return PICC_SendEvent(svc##_PROVIDER_ID, (uint8)svc##_##name##_ID,      \
+                              consumerId, buf, (uint16)len, withAck, channelId);\
+    }
+#define PICC_CODEC_DEFINE_METHOD(svc, name)
+
+/** Encode / decode */
+#define PICC_CODEC_DEFINE_MSG(svc, name, kind, id)                              \
+    sint32 svc##_##name##_Encode(const svc##_##name##_t *m, uint8 *buf, uint16 size) \
+    {                                                                           \
+        uint32 pos = 0U;                                                        \
+        uint32 slack;                                                           \
+        if ((m == NULL) || (buf == NULL) ||                                     \
+            ((uint32)size < (uint32)svc##_##name##_MIN_SIZE)) {                 \
+            return -1;                                                          \
+        }                                                                       \
+        slack = (uint32)size - (uint32)svc##_##name##_MIN_SIZE;                 \
+        svc##_##name##_FIELDS(PICC_CODEC_ENC_U8, PICC_CODEC_ENC_U16,            \
+                              PICC_CODEC_ENC_U32, PICC_CODEC_ENC_ARR,           \
+                              PICC_CODEC_ENC_VAR, PICC_CODEC_ENC_TAIL)          \
+        (void)slack;                                                            \
+        return (sint32)pos;                                                     \
+    }                                                                           \
+    sint32 svc##_##name##_Decode(svc##_##name##_t *m, const uint8 *buf, uint16 len)  \
+    {                                                                           \
+        uint32 pos = 0U;                                                        \
+        uint32 slack;                                                           \
+        uint32 cnt = 0U;                                                        \
+        if ((m == NULL) || ((buf == NULL) && (len != 0U)) ||                    \
+            ((uint32)len < (uint32)svc##_##name##_MIN_SIZE)) {                  \
+            return -1;                                                          \
+        }                                                                       \
+        slack = (uint32)len - (uint32)svc##_##name##_MIN_SIZE;                  \
+        svc##_##name##_FIELDS(PICC_CODEC_DEC_U8, PICC_CODEC_DEC_U16,            \
+                              PICC_CODEC_DEC_U32, PICC_CODEC_DEC_ARR,           \
+                              PICC_CODEC_DEC_VAR, PICC_CODEC_DEC_TAIL)          \
+        (void)slack;                                                            \
+        (void)cnt;                                                              \
+        return (sint32)pos;                                                     \
+    }                                                                           \
+    PICC_CODEC_DEFINE_ROUNDTRIP(svc, name, id)                                  \
+    PICC_CODEC_DEFINE_##kind(svc, name)
+
+/** Dispatch case (METHOD only) */
+#define PICC_CODEC_CASE_EVENT(svc, name)
+#define PICC_CODEC_CASE_METHOD(svc, name)                                       \
+    case svc##_##name##_ID: {                                                   \
+        svc##_##name##_t req;                                                   \
+        if (svc##_##name##_Decode(&req, reqData, reqLen) < 0) {                 \
+            return (uint8)PICC_RET_NOT_OK;                                      \
+        }                                                                       \
+        return svc##_##name##_Handle(consumerId, &req);                         \
+    }
+#define PICC_CODEC_CASE(svc, name, kind, id)    PICC_CODEC_CASE_##kind(svc, name)
+
+#if (PICC_CODEC_SELFTEST_ENABLE != 0)
+/** Round trip of one message (self test) */
+#define PICC_CODEC_DEFINE_ROUNDTRIP(svc, name, id)                              \
+    static sint8 svc##_##name##_RoundTrip(void)                                 \
+    {                                                                           \
+        svc##_##name##_t m;                                                     \
+        svc##_##name##_t d;                                                     \
+        uint8 buf[svc##_##name##_MAX_SIZE + 1U];                                \
+        uint8 chk[svc##_##name##_MAX_SIZE + 1U];                                \
+        uint8 seed = (uint8)(id);                                               \
+        sint32 len;                                                             \
+        uint32 i;                                                               \
+        svc##_##name##_FIELDS(PICC_CODEC_FILL_U8, PICC_CODEC_FILL_U16,          \
+                              PICC_CODEC_FILL_U32, PICC_CODEC_FILL_ARR,         \
+                              PICC_CODEC_FILL_VAR, PICC_CODEC_FILL_TAIL)        \
+        (void)i;                                                                \
+        len = svc##_##name##_Encode(&m, buf, (uint16)svc##_##name##_MAX_SIZE);  \
+        if (len != (sint32)svc##_##name##_MAX_SIZE) {                           \
+            return -1;                                                          \
+        }                                                                       \
+        /* Trailing byte of a newer peer: ignored or truncated away */          \
+        buf[len] = 0xC3U;                                                       \
+        if ((svc##_##name##_Decode(&d, buf, (uint16)(len + 1)) < len) ||        \
+            (svc##_##name##_Encode(&d, chk, (uint16)sizeof(chk)) != len)) {     \
+            return -1;                                                          \
+        }                                                                       \
+        for (i = 0U; i < (uint32)len; i++) {                                    \
+            if (chk[i] != buf[i]) {                                             \
+                return -1;                                                      \
+            }                                                                   \
+        }                                                                       \
+        if (((uint32)svc##_##name##_MIN_SIZE > 0U) &&                           \
+            (svc##_##name##_Decode(&d, buf,                                     \
+                 (uint16)((uint32)svc##_##name##_MIN_SIZE - 1U)) >= 0)) {       \
+            return -1;                                                          \
+        }                                                                       \
+        return 0;                                                               \
+    }
+
+/** Self test step */
+#define PICC_CODEC_SELFTEST(svc, name, kind, id)                                \
+    if (svc##_##name##_RoundTrip() != 0) {                                      \
+        ret = -1;                                                               \
+    }
+
+/**
+ * <Svc>_SelfTest() returns 0 if every message is encoded, decoded (with a
+ * trailing byte appended) and encoded again unchanged, and a payload short of
+ * the fixed fields is rejected.
+ */
+#define PICC_CODEC_DEFINE_SELFTEST(svc)                                         \
+    sint8 svc##_SelfTest(void)                                                  \
+    {                                                                           \
+        sint8 ret = 0;                                                          \
+        svc##_MESSAGES(PICC_CODEC_SELFTEST)                                     \
+        return ret;                                                             \
+    }
+#else
+#define PICC_CODEC_DEFINE_ROUNDTRIP(svc, name, id)
+#define PICC_CODEC_DEFINE_SELFTEST(svc)
+#endif
+
+/**
+ * @brief Define service codecs, send stubs, dispatch and registration
+ *
+ * Requests of unknown MethodID or not decodable are answered PICC_RET_NOT_OK.
+ * Generated dispatch returns no response data, so it is registered without
+ * response buffer.
+ */
+#define PICC_CODEC_DEFINE_SERVICE(svc)                                          \
+    svc##_MESSAGES(PICC_CODEC_DEFINE_MSG)                                       \
+    uint8 svc##_ServiceDispatch(uint8 consumerId, uint8 methodId,               \
+                                const uint8 *reqData, uint16 reqLen,            \
+                                uint8 *rspData, uint16 *rspLen)                 \
+    {                                                                           \
+        (void)rspData;                                                          \
+        *rspLen = 0U;                                                           \
+        switch (methodId) {                                                     \
+            svc##_MESSAGES(PICC_CODEC_CASE)                                     \
+            default:                                                            \
+                break;                                                          \
+        }                                                                       \
+        return (uint8)PICC_RET_NOT_OK;                                          \
+    }                                                                           \
+    sint8 svc##_ServiceRegister(uint8 flags)                                    \
+    {                                                                           \
+        sint8 ret = PICC_RegisterMethodIdHandlerEx(svc##_PROVIDER_ID,           \
+                                                   PICC_SERVICE_ANY_ID,         \
+                                                   svc##_ServiceDispatch,       \
+                                                   flags);                      \
+        if (ret == 0) {                                                         \
+            ret = PICC_SetMethodResponseSize(svc##_PROVIDER_ID,                 \
+                                             PICC_SERVICE_ANY_ID, 0U);          \
+        }                                                                       \
+        return ret;                                                             \
+    }                                                                           \
+    PICC_CODEC_DEFINE_SELFTEST(svc)
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* PICC_CODEC_H */
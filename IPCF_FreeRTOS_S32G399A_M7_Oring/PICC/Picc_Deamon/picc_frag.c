@@ -0,0 +1,508 @@
+/**
+ * @file picc_frag.c
+ * @brief M-Core Inter-Core Communication Fragmentation Layer - Implementation
+ *
+ * Implements segmentation of large service payloads into sequenced fragments
+ * and their reassembly on receipt.
+ * - Tx: payload is copied into a transfer slot, fragments are queued to the
+ *   stack in bursts (send call, then 10ms periodic task) so other messages
+ *   interleave with a large transfer
+ * - Rx: fragments must arrive in order (one channel is FIFO), a gap or
+ *   timeout drops the reassembly
+ * - Transfer and reassembly buffers are scratch arena blocks of the actual
+ *   message size, held only while a transfer is in progress
+ *
+ * Copyright 2024 NXP
+ * All Rights Reserved.
+ */
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "picc_frag.h"
+#include "picc_stack.h"
+#include "picc_arena.h"
+#include "Picc_main.h"    /* For HANDLE_ERROR */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (PICC_ARENA_BLOCK_SIZE(PICC_FRAG_HEADER_SIZE + PICC_FRAG_MAX_SIZE) > PICC_ARENA_QUOTA_FRAG_TX)
+#error "PICC_ARENA_QUOTA_FRAG_TX: too small for a PICC_FRAG_MAX_SIZE transfer"
+#endif
+
+#if (PICC_ARENA_BLOCK_SIZE(PICC_FRAG_MAX_SIZE) > PICC_ARENA_QUOTA_FRAG_RX)
+#error "PICC_ARENA_QUOTA_FRAG_RX: too small for a PICC_FRAG_MAX_SIZE reassembly"
+#endif
+
+/*==================================================================================================
+ *                                         Private Types
+ *==================================================================================================*/
+
+/** Outgoing transfer slot */
+typedef struct {
+    PICC_MsgHeader_t header;        /**< Original message header */
+    uint8   channelId;              /**< IPCF channel ID */
+    uint8   transferId;             /**< Transfer ID */
+    uint16  totalLen;               /**< Payload length */
+    uint16  sentLen;                /**< Payload bytes queued to stack */
+    uint16  nextIndex;              /**< Index of next fragment */
+    uint32  lastTick;               /**< Tick of last progress */
+    boolean busy;                   /**< Owned by a sending task */
+    boolean isUsed;                 /**< Is slot in use */
+    /** Fragment header headroom + payload (arena block); the header of
+     *  fragment n is written over the tail of fragment n-1, already queued */
+    uint8  *buf;
+} PICC_FragTx_t;
+
+/** Reassembly slot */
+typedef struct {
+    PICC_MsgHeader_t header;        /**< Original message header (Length = total) */
+    uint8   instanceId;             /**< Receive instance ID */
+    uint8   channelId;              /**< Receive channel ID */
+    uint8   transferId;             /**< Transfer ID */
+    uint16  totalLen;               /**< Payload length */
+    uint16  rcvdLen;                /**< Payload bytes received */
+    uint16  nextIndex;              /**< Index of expected fragment */
+    uint32  lastTick;               /**< Tick of last fragment */
+    boolean busy;                   /**< Rx task copying into buf */
+    boolean isUsed;                 /**< Is slot in use */
+    uint8  *buf;                    /**< Reassembly buffer (arena block, totalLen bytes) */
+} PICC_FragRx_t;
+
+/*==================================================================================================
+ *                                         Private Variables
+ *==================================================================================================*/
+
+/** Outgoing transfers */
+static PICC_FragTx_t g_fragTx[PICC_FRAG_TX_SLOTS];
+
+/** Reassemblies */
+static PICC_FragRx_t g_fragRx[PICC_FRAG_RX_SLOTS];
+
+/** Transfer ID counter */
+static uint8 g_fragTransferId = 0U;
+
+/** Fragmentation statistics */
+static PICC_FragStats_t g_fragStats;
+
+/** Reassembled message callback */
+static PICC_FragDeliverCallback_t g_fragDeliver = NULL;
+
+/*==================================================================================================
+ *                                         Private Functions
+ *==================================================================================================*/
+
+/**
+ * @brief Queue up to PICC_FRAG_BURST fragments of a transfer (owner only)
+ *
+ * @param tx Transfer slot (busy)
+ * @return TRUE if all fragments are queued
+ */
+static boolean PICC_FragTxPump(PICC_FragTx_t *tx)
+{
+    uint8 hdrBuf[PICC_HEADER_SIZE];
+    PICC_MsgHeader_t fragHeader;
+    uint8 *frag;
+    uint16 chunk;
+    uint32 queued = 0U;
+
+    fragHeader = tx->header;
+    fragHeader.msgType = (uint8)PICC_MSG_FRAGMENT;
+
+    while ((queued < PICC_FRAG_BURST) && (tx->sentLen < tx->totalLen)) {
+        chunk = tx->totalLen - tx->sentLen;
+        if (chunk > PICC_FRAG_CHUNK_SIZE) {
+            chunk = PICC_FRAG_CHUNK_SIZE;
+        }
+
+        /* Fragment header right in front of the chunk */
+        frag = &tx->buf[tx->sentLen];
+        frag[0] = tx->header.msgType;
+        frag[1] = tx->transferId;
+        frag[2] = (uint8)(tx->nextIndex >> 8U);
+        frag[3] = (uint8)(tx->nextIndex & 0xFFU);
+        frag[4] = (uint8)(tx->totalLen >> 8U);
+        frag[5] = (uint8)(tx->totalLen & 0xFFU);
+
+        (void)PICC_PackHeader(hdrBuf, sizeof(hdrBuf), &fragHeader,
+                              (uint16)(PICC_FRAG_HEADER_SIZE + chunk));
+        if (PICC_StackAddMessageParts(tx->channelId, hdrBuf, frag,
+                                      (uint16)(PICC_FRAG_HEADER_SIZE + chunk)) != 0) {
+            break;  /* Stack full - retried from periodic task */
+        }
+
+        tx->sentLen += chunk;
+        tx->nextIndex++;
+        tx->lastTick = (uint32)xTaskGetTickCount();
+        queued++;
+    }
+
+    taskENTER_CRITICAL();
+    g_fragStats.txFragments += queued;
+    taskEXIT_CRITICAL();
+
+    return (tx->sentLen >= tx->totalLen) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Find reassembly slot of a transfer (in critical section)
+ */
+static PICC_FragRx_t* PICC_FragFindRx(const PICC_MsgHeader_t *header,
+                                      uint8 channelId, uint8 transferId)
+{
+    uint32 i;
+
+    for (i = 0U; i < PICC_FRAG_RX_SLOTS; i++) {
+        if ((g_fragRx[i].isUsed != FALSE) &&
+            (g_fragRx[i].channelId == channelId) &&
+            (g_fragRx[i].transferId == transferId) &&
+            (g_fragRx[i].header.providerId == header->providerId) &&
+            (g_fragRx[i].header.methodId == header->methodId)) {
+            return &g_fragRx[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Find free reassembly slot (in critical section)
+ */
+static PICC_FragRx_t* PICC_FragAllocRx(void)
+{
+    uint32 i;
+
+    for (i = 0U; i < PICC_FRAG_RX_SLOTS; i++) {
+        if ((g_fragRx[i].isUsed == FALSE) && (g_fragRx[i].busy == FALSE)) {
+            return &g_fragRx[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Drop transfer slot and free its buffer (in critical section)
+ *
+ * A busy slot keeps its buffer until the owning task is done with it.
+ */
+static void PICC_FragTxRelease(PICC_FragTx_t *tx)
+{
+    tx->isUsed = FALSE;
+    if (tx->busy == FALSE) {
+        PICC_ArenaFree(tx->buf);
+        tx->buf = NULL;
+    }
+}
+
+/**
+ * @brief Drop reassembly slot and free its buffer (in critical section)
+ *
+ * A busy slot keeps its buffer until the Rx task has finished copying.
+ */
+static void PICC_FragRxRelease(PICC_FragRx_t *rx)
+{
+    rx->isUsed = FALSE;
+    if (rx->busy == FALSE) {
+        PICC_ArenaFree(rx->buf);
+        rx->buf = NULL;
+    }
+}
+
+/*==================================================================================================
+ *                                         Public Functions
+ *==================================================================================================*/
+
+/**
+ * @brief Initialize fragmentation layer
+ */
+void PICC_FragInit(PICC_FragDeliverCallback_t deliver)
+{
+    PICC_FragStats_t empty = {0};
+    uint32 i;
+
+    taskENTER_CRITICAL();
+    for (i = 0U; i < PICC_FRAG_TX_SLOTS; i++) {
+        PICC_FragTxRelease(&g_fragTx[i]);  /* Busy slot freed by its owner */
+    }
+    for (i = 0U; i < PICC_FRAG_RX_SLOTS; i++) {
+        PICC_FragRxRelease(&g_fragRx[i]);
+    }
+    g_fragStats = empty;
+    g_fragDeliver = deliver;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Send message as fragments
+ */
+sint8 PICC_FragSend(const PICC_MsgHeader_t *header,
+                    const uint8 *payload, uint16 payloadLen,
+                    uint8 channelId)
+{
+    PICC_FragTx_t *tx = NULL;
+    uint8 *buf;
+    boolean done;
+    uint32 i;
+
+    if ((header == NULL) || (payload == NULL) || (payloadLen == 0U)) {
+        return -1;
+    }
+
+    if (payloadLen > PICC_FRAG_MAX_SIZE) {
+        HANDLE_ERROR(-41);  /* Frag: Payload exceeds PICC_FRAG_MAX_SIZE */
+        return -2;
+    }
+
+    buf = (uint8 *)PICC_ArenaAlloc(PICC_FRAG_HEADER_SIZE + (uint32)payloadLen,
+                                   PICC_ARENA_OWNER_FRAG_TX);
+
+    /* Claim transfer slot */
+    taskENTER_CRITICAL();
+    if (buf != NULL) {
+        for (i = 0U; i < PICC_FRAG_TX_SLOTS; i++) {
+            if ((g_fragTx[i].isUsed == FALSE) && (g_fragTx[i].busy == FALSE)) {
+                tx = &g_fragTx[i];
+                tx->isUsed = TRUE;
+                tx->busy = TRUE;
+                tx->buf = buf;
+                tx->transferId = g_fragTransferId;
+                g_fragTransferId++;
+                break;
+            }
+        }
+    }
+    if (tx == NULL) {
+        g_fragStats.txNoSlot++;
+    }
+    taskEXIT_CRITICAL();
+
+    if (tx == NULL) {
+        PICC_ArenaFree(buf);
+        HANDLE_ERROR(-42);  /* Frag: No free transfer slot or scratch memory */
+        return -3;
+    }
+
+    /* Copy outside of critical section, slot is owned (busy) */
+    tx->header = *header;
+    tx->channelId = channelId;
+    tx->totalLen = payloadLen;
+    tx->sentLen = 0U;
+    tx->nextIndex = 0U;
+    tx->lastTick = (uint32)xTaskGetTickCount();
+    for (i = 0U; i < payloadLen; i++) {
+        tx->buf[PICC_FRAG_HEADER_SIZE + i] = payload[i];
+    }
+
+    done = PICC_FragTxPump(tx);
+
+    taskENTER_CRITICAL();
+    g_fragStats.txMessages++;
+    tx->busy = FALSE;
+    if ((done != FALSE) || (tx->isUsed == FALSE)) {
+        PICC_FragTxRelease(tx);  /* Done, or dropped meanwhile */
+    }
+    taskEXIT_CRITICAL();
+
+    return 0;
+}
+
+/**
+ * @brief Process received fragment
+ */
+sint8 PICC_FragReceive(const PICC_MsgHeader_t *header,
+                       const uint8 *payload, uint16 len,
+                       uint8 instanceId, uint8 channelId)
+{
+    PICC_FragRx_t *rx;
+    PICC_MsgHeader_t msgHeader;
+    uint8 *msgBuf = NULL;
+    uint8 transferId;
+    uint16 index;
+    uint16 totalLen;
+    uint16 chunk;
+    uint32 i;
+    boolean complete = FALSE;
+
+    if ((header == NULL) || (payload == NULL) || (len <= PICC_FRAG_HEADER_SIZE)) {
+        taskENTER_CRITICAL();
+        g_fragStats.rxDropped++;
+        taskEXIT_CRITICAL();
+        return -1;
+    }
+
+    transferId = payload[1];
+    index      = ((uint16)payload[2] << 8U) | (uint16)payload[3];
+    totalLen   = ((uint16)payload[4] << 8U) | (uint16)payload[5];
+    chunk      = len - PICC_FRAG_HEADER_SIZE;
+
+    taskENTER_CRITICAL();
+    g_fragStats.rxFragments++;
+    rx = PICC_FragFindRx(header, channelId, transferId);
+
+    if (index == 0U) {
+        /* First fragment: (re)start reassembly */
+        if (rx != NULL) {
+            g_fragStats.rxDropped++;  /* Previous attempt never completed */
+            PICC_FragRxRelease(rx);
+        } else {
+            rx = PICC_FragAllocRx();
+        }
+        if ((rx != NULL) && (totalLen != 0U) && (totalLen <= PICC_FRAG_MAX_SIZE)) {
+            rx->buf = (uint8 *)PICC_ArenaAlloc(totalLen, PICC_ARENA_OWNER_FRAG_RX);
+        }
+        if ((rx != NULL) && (rx->buf != NULL)) {
+            rx->header = *header;
+            rx->header.msgType = payload[0];
+            rx->header.length = totalLen;
+            rx->instanceId = instanceId;
+            rx->channelId = channelId;
+            rx->transferId = transferId;
+            rx->totalLen = totalLen;
+            rx->rcvdLen = 0U;
+            rx->nextIndex = 0U;
+            rx->isUsed = TRUE;
+        } else {
+            rx = NULL;  /* No slot, invalid length or no scratch memory */
+        }
+    } else if ((rx != NULL) &&
+               ((index != rx->nextIndex) || (totalLen != rx->totalLen))) {
+        /* Fragment lost or out of order: reassembly cannot complete */
+        PICC_FragRxRelease(rx);
+        rx = NULL;
+    } else {
+        /* Next fragment of a reassembly, or orphan (rx == NULL) */
+    }
+
+    if ((rx != NULL) && (((uint32)rx->rcvdLen + chunk) > rx->totalLen)) {
+        PICC_FragRxRelease(rx);
+        rx = NULL;
+    }
+
+    if (rx == NULL) {
+        g_fragStats.rxDropped++;
+        taskEXIT_CRITICAL();
+        return -2;
+    }
+    rx->lastTick = (uint32)xTaskGetTickCount();
+    rx->busy = TRUE;
+    taskEXIT_CRITICAL();
+
+    /* Copy outside of critical section, only the Rx task writes slots,
+     * buf is kept while busy even if the slot is dropped meanwhile */
+    for (i = 0U; i < chunk; i++) {
+        rx->buf[rx->rcvdLen + i] = payload[PICC_FRAG_HEADER_SIZE + i];
+    }
+
+    taskENTER_CRITICAL();
+    rx->busy = FALSE;
+    if (rx->isUsed != FALSE) {
+        rx->rcvdLen += chunk;
+        rx->nextIndex++;
+        complete = (rx->rcvdLen == rx->totalLen) ? TRUE : FALSE;
+    } else {
+        PICC_FragRxRelease(rx);  /* Dropped meanwhile (timeout / init) */
+    }
+    if (complete != FALSE) {
+        /* Hand the buffer off to delivery, slot is free for the next transfer */
+        msgHeader = rx->header;
+        msgBuf = rx->buf;
+        rx->buf = NULL;
+        rx->isUsed = FALSE;
+        g_fragStats.rxMessages++;
+        (void)PICC_ArenaHandoff(msgBuf, PICC_ARENA_OWNER_FRAG_RX, PICC_ARENA_OWNER_SERVICE);
+    }
+    taskEXIT_CRITICAL();
+
+    if (complete != FALSE) {
+        if (g_fragDeliver != NULL) {
+            g_fragDeliver(&msgHeader, msgBuf, msgHeader.length, instanceId, channelId);
+        }
+        PICC_ArenaFree(msgBuf);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Pending fragments and timeouts - called from PICC periodic task (10ms)
+ */
+void PICC_FragProcess(void)
+{
+    PICC_FragTx_t *tx;
+    uint32 now;
+    uint32 timeout = (uint32)pdMS_TO_TICKS(PICC_FRAG_TIMEOUT_MS);
+    boolean done;
+    uint32 i;
+
+    now = (uint32)xTaskGetTickCount();
+
+    /* Outgoing transfers: next burst, or drop if stack accepts nothing */
+    for (i = 0U; i < PICC_FRAG_TX_SLOTS; i++) {
+        tx = &g_fragTx[i];
+
+        taskENTER_CRITICAL();
+        if ((tx->isUsed == FALSE) || (tx->busy != FALSE)) {
+            taskEXIT_CRITICAL();
+            continue;
+        }
+        if ((now - tx->lastTick) > timeout) {
+            PICC_FragTxRelease(tx);
+            g_fragStats.txAborted++;
+            taskEXIT_CRITICAL();
+            continue;
+        }
+        tx->busy = TRUE;
+        taskEXIT_CRITICAL();
+
+        done = PICC_FragTxPump(tx);
+
+        taskENTER_CRITICAL();
+        tx->busy = FALSE;
+        if ((done != FALSE) || (tx->isUsed == FALSE)) {
+            PICC_FragTxRelease(tx);  /* Done, or dropped meanwhile */
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    /* Reassemblies: drop if no fragment for too long */
+    taskENTER_CRITICAL();
+    for (i = 0U; i < PICC_FRAG_RX_SLOTS; i++) {
+        if ((g_fragRx[i].isUsed != FALSE) && ((now - g_fragRx[i].lastTick) > timeout)) {
+            PICC_FragRxRelease(&g_fragRx[i]);
+            g_fragStats.rxTimeouts++;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Get fragmentation statistics
+ */
+sint8 PICC_FragGetStats(PICC_FragStats_t *stats)
+{
+    if (stats == NULL) {
+        return -1;
+    }
+
+    taskENTER_CRITICAL();
+    *stats = g_fragStats;
+    taskEXIT_CRITICAL();
+
+    return 0;
+}
+
+/**
+ * @brief Reset fragmentation statistics
+ */
+void PICC_FragResetStats(void)
+{
+    PICC_FragStats_t empty = {0};
+
+    taskENTER_CRITICAL();
+    g_fragStats = empty;
+    taskEXIT_CRITICAL();
+}
+
+#if defined(__cplusplus)
+}
+#endif
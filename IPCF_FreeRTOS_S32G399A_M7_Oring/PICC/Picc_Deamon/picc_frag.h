@@ -0,0 +1,151 @@
+/**
+ * @file picc_frag.h
+ * @brief M-Core Inter-Core Communication Fragmentation Layer - Interface Definition
+ *
+ * Splits service payloads larger than PICC_FRAG_THRESHOLD into sequenced
+ * fragments and reassembles them on receipt (used by the service layer).
+ *
+ * Fragment message: 8-byte protocol header with MessageType PICC_MSG_FRAGMENT,
+ * Provider/Method/Consumer/Session ID and ReturnCode of the original message,
+ * Payload = [OrigMsgType 1B][TransferID 1B][Index 2B BE][TotalLen 2B BE][Data].
+ *
+ * Fragments are sent in bursts of PICC_FRAG_BURST per transfer, the rest
+ * from the periodic task, so they interleave with normal traffic. Transfers
+ * and reassemblies use bounded slots and are dropped after a timeout.
+ *
+ * Copyright 2024 NXP
+ * All Rights Reserved.
+ */
+
+#ifndef PICC_FRAG_H
+#define PICC_FRAG_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "picc_protocol.h"
+
+/*==================================================================================================
+ *                                         Macro Definitions
+ *==================================================================================================*/
+
+/** Payloads longer than this are fragmented */
+#define PICC_FRAG_THRESHOLD         (PICC_MAX_PAYLOAD_SIZE)
+
+/** Fragment header length (bytes, at start of fragment payload) */
+#define PICC_FRAG_HEADER_SIZE       (6U)
+
+/** Data bytes per fragment */
+#define PICC_FRAG_CHUNK_SIZE        (1024U)
+
+/** Maximum payload length of a fragmented message (reassembly buffer size) */
+#define PICC_FRAG_MAX_SIZE          (16384U)
+
+/** Concurrent outgoing transfers */
+#define PICC_FRAG_TX_SLOTS          (2U)
+
+/** Concurrent reassemblies */
+#define PICC_FRAG_RX_SLOTS          (2U)
+
+/** Fragments queued per transfer at once (send call / periodic task) */
+#define PICC_FRAG_BURST             (4U)
+
+/** Transfer / reassembly dropped when not progressing for this long (ms) */
+#define PICC_FRAG_TIMEOUT_MS        (200U)
+
+/*==================================================================================================
+ *                                         Structure Definitions
+ *==================================================================================================*/
+
+/**
+ * @brief Fragmentation statistics
+ */
+typedef struct {
+    uint32  txMessages;         /**< Messages fragmented */
+    uint32  txFragments;        /**< Fragments queued to stack */
+    uint32  txAborted;          /**< Transfers dropped by timeout */
+    uint32  txNoSlot;           /**< Sends rejected, no free transfer slot */
+    uint32  rxMessages;         /**< Messages reassembled */
+    uint32  rxFragments;        /**< Fragments received */
+    uint32  rxTimeouts;         /**< Reassemblies dropped by timeout */
+    uint32  rxDropped;          /**< Fragments dropped (out of order, no slot, invalid) */
+} PICC_FragStats_t;
+
+/**
+ * @brief Reassembled message delivery callback function type (Rx task context)
+ *
+ * header->msgType / header->length are those of the original message,
+ * payload is valid during the call only.
+ */
+typedef void (*PICC_FragDeliverCallback_t)(const PICC_MsgHeader_t *header,
+                                           const uint8 *payload, uint16 len,
+                                           uint8 instanceId, uint8 channelId);
+
+/*==================================================================================================
+ *                                         Function Declarations
+ *==================================================================================================*/
+
+/**
+ * @brief Initialize fragmentation layer (drops all transfers)
+ *
+ * @param[in] deliver Callback for reassembled messages
+ */
+void PICC_FragInit(PICC_FragDeliverCallback_t deliver);
+
+/**
+ * @brief Send message as fragments
+ *
+ * Payload is copied, the first PICC_FRAG_BURST fragments are queued at once,
+ * the rest by PICC_FragProcess().
+ *
+ * @param[in] header     Protocol header of the original message
+ * @param[in] payload    Payload data
+ * @param[in] payloadLen Payload length (up to PICC_FRAG_MAX_SIZE)
+ * @param[in] channelId  IPCF channel ID
+ * @return 0 on success, non-zero on failure
+ */
+sint8 PICC_FragSend(const PICC_MsgHeader_t *header,
+                    const uint8 *payload, uint16 payloadLen,
+                    uint8 channelId);
+
+/**
+ * @brief Process received fragment (PICC_MSG_FRAGMENT message)
+ *
+ * Delivers the original message through the deliver callback once its
+ * last fragment arrived.
+ *
+ * @param[in] header     Fragment message header
+ * @param[in] payload    Fragment payload
+ * @param[in] len        Fragment payload length
+ * @param[in] instanceId Receive instance ID
+ * @param[in] channelId  Receive channel ID
+ * @return 0 on success, non-zero if fragment was dropped
+ */
+sint8 PICC_FragReceive(const PICC_MsgHeader_t *header,
+                       const uint8 *payload, uint16 len,
+                       uint8 instanceId, uint8 channelId);
+
+/**
+ * @brief Pending fragments and timeouts - called from PICC periodic task (10ms)
+ */
+void PICC_FragProcess(void);
+
+/**
+ * @brief Get fragmentation statistics
+ *
+ * @param[out] stats Statistics copy
+ * @return 0 on success, non-zero on failure
+ */
+sint8 PICC_FragGetStats(PICC_FragStats_t *stats);
+
+/**
+ * @brief Reset fragmentation statistics
+ */
+void PICC_FragResetStats(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* PICC_FRAG_H */
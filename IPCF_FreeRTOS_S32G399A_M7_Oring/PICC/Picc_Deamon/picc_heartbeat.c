@@ -4,6 +4,9 @@
  *
  * Low-level heartbeat (Ping/Pong) functionality for IPC channel health monitoring.
  * Independent of application-level connection state (no CONSUMER_ID/PROVIDER_ID).
+ * Liveness is inferred from any valid received frame, so busy links need no
+ * heartbeat frames. Ping/Pong travel as legacy 9-byte messages, or as flags
+ * of regular frames once the peer has sent a heartbeat flag.
  *
  * Copyright 2024 NXP
  * All Rights Reserved.
@@ -15,22 +18,24 @@ extern "C" {
 
 #include "picc_heartbeat.h"
 #include "FreeRTOS.h"
+#include "task.h"
 #include "Picc_main.h"    /* For HANDLE_ERROR */
 #include "ipcf_Ip_Cfg_Defines.h"  /* For IPCF_INSTANCE0 */
+#include "ipc-shm.h"              /* For IPC_SHM_MAX_INSTANCES / IPC_SHM_MAX_CHANNELS */
 #include "picc_stack.h"
 
 /* NOTE: timers.h removed - no longer using FreeRTOS timers */
 
 /*==================================================================================================
- *                                         Macro Definitions
+ *                                         Private Types
  *==================================================================================================*/
 
-/** Heartbeat timer period (same as link request period for shared timer) */
-#define PICC_HEARTBEAT_TIMER_PERIOD_MS  (10U)
+/** Index entry: no context */
+#define PICC_HEARTBEAT_NO_SLOT          (0xFFU)
 
-/*==================================================================================================
- *                                         Private Types
- *==================================================================================================*/
+#if (PICC_HEARTBEAT_MAX_CHANNELS >= PICC_HEARTBEAT_NO_SLOT)
+#error "PICC_HEARTBEAT_MAX_CHANNELS: must be below 255 (uint8 index)"
+#endif
 
 /**
  * @brief Heartbeat channel context
@@ -39,6 +44,9 @@ typedef struct {
     uint8    instanceId;                /**< IPCF instance ID */
     uint8    channelId;                 /**< IPCF channel ID */
     volatile uint8 missCount;           /**< Heartbeat miss count */
+    volatile uint32 lastRxTick;         /**< Tick of last valid received frame */
+    volatile boolean peerFlags;         /**< Peer sent heartbeat frame flags (flag mode) */
+    uint32   lastPingTick;              /**< Tick of last Ping */
     boolean  isUsed;                    /**< Is channel in use */
 } PICC_HeartbeatContext_t;
 
@@ -49,8 +57,8 @@ typedef struct {
 /** Heartbeat channel contexts */
 static PICC_HeartbeatContext_t g_hbContexts[PICC_HEARTBEAT_MAX_CHANNELS];
 
-/** Heartbeat timer counter (counts up to 2000ms) - incremented each 10ms call */
-static uint16 g_hbTimerCounter = 0U;
+/** Context slot per (instance, channel), PICC_HEARTBEAT_NO_SLOT if none */
+static uint8 g_hbIndex[IPC_SHM_MAX_INSTANCES][IPC_SHM_MAX_CHANNELS];
 
 /** Timeout callback */
 static PICC_HeartbeatTimeoutCallback_t g_timeoutCallback = NULL;
@@ -63,62 +71,103 @@ static boolean g_hbInitialized = FALSE;
  *==================================================================================================*/
 
 /**
- * @brief Get heartbeat context by channel ID
+ * @brief Get heartbeat context by channel ID (constant time, called per received frame)
  */
 static PICC_HeartbeatContext_t* PICC_GetHeartbeatContext(uint8 instanceId, uint8 channelId)
+{
+    uint8 slot;
+
+    if ((instanceId >= IPC_SHM_MAX_INSTANCES) || (channelId >= IPC_SHM_MAX_CHANNELS)) {
+        return NULL;
+    }
+
+    slot = g_hbIndex[instanceId][channelId];
+    if ((slot == PICC_HEARTBEAT_NO_SLOT) || (g_hbContexts[slot].isUsed == FALSE)) {
+        return NULL;
+    }
+    return &g_hbContexts[slot];
+}
+
+/**
+ * @brief Check whether a channel uses heartbeat frame flags
+ */
+static boolean PICC_HeartbeatFlagMode(const PICC_HeartbeatContext_t *ctx)
+{
+    return ((PICC_HEARTBEAT_PIGGYBACK != FALSE) && (ctx != NULL) &&
+            (ctx->peerFlags != FALSE)) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Clear (instance, channel) index
+ */
+static void PICC_HeartbeatIndexClear(void)
 {
     uint32 i;
-    (void)instanceId;  /* Currently only supports IPCF_INSTANCE0 */
-    
-    for (i = 0U; i < PICC_HEARTBEAT_MAX_CHANNELS; i++) {
-        if (g_hbContexts[i].isUsed && g_hbContexts[i].channelId == channelId) {
-            return &g_hbContexts[i];
+    uint32 c;
+
+    for (i = 0U; i < IPC_SHM_MAX_INSTANCES; i++) {
+        for (c = 0U; c < IPC_SHM_MAX_CHANNELS; c++) {
+            g_hbIndex[i][c] = PICC_HEARTBEAT_NO_SLOT;
         }
     }
-    return NULL;
 }
 
 /**
  * @brief Heartbeat process - called from PICC periodic task (10ms)
  * 
- * [R6] Sends Ping every 2000ms and checks timeout.
- * Replaces the timer-based approach.
+ * [R6] Sends Ping every PICC_HEARTBEAT_PERIOD_MS (PICC_HEARTBEAT_IDLE_MS in
+ * flag mode) while nothing is received and checks timeout. Busy links never
+ * ping: every received frame resets the idle time.
  */
 void PICC_HeartbeatProcess(void)
 {
     uint32 i;
+    uint32 now;
+    uint32 idleTicks;
+    boolean timeout;
     PICC_HeartbeatContext_t *ctx;
 
     if (g_hbInitialized == FALSE) {
         return;
     }
 
-    g_hbTimerCounter++;
-    
-    /* 2000ms period (200 * 10ms) */
-    if (g_hbTimerCounter >= (PICC_HEARTBEAT_PERIOD_MS / PICC_HEARTBEAT_TIMER_PERIOD_MS)) {
-        g_hbTimerCounter = 0U;
-
-        /* Iterate through all monitored channels */
-        for (i = 0U; i < PICC_HEARTBEAT_MAX_CHANNELS; i++) {
-            ctx = &g_hbContexts[i];
-            
-            if (ctx->isUsed == FALSE) {
-                continue;
-            }
-
-            /* [R6] Send Ping on each channel */
-            (void)PICC_HeartbeatSendPing(ctx->instanceId, ctx->channelId);
-
-            /* [R6] Increment miss count and check timeout */
-            ctx->missCount++;
-            if (ctx->missCount >= PICC_HEARTBEAT_TIMEOUT_COUNT) {
-                /* Timeout - notify application via callback */
-                if (g_timeoutCallback != NULL) {
-                    g_timeoutCallback(ctx->instanceId, ctx->channelId);
-                }
-                ctx->missCount = 0U;  /* Reset after notification */
-            }
+    now = (uint32)xTaskGetTickCount();
+
+    /* Iterate through all monitored channels */
+    for (i = 0U; i < PICC_HEARTBEAT_MAX_CHANNELS; i++) {
+        ctx = &g_hbContexts[i];
+        
+        if (ctx->isUsed == FALSE) {
+            continue;
+        }
+
+        /* Short interval only with flag Pings (no extra frame on a busy link) */
+        idleTicks = (PICC_HeartbeatFlagMode(ctx) != FALSE) ?
+                    (uint32)pdMS_TO_TICKS(PICC_HEARTBEAT_IDLE_MS) :
+                    (uint32)pdMS_TO_TICKS(PICC_HEARTBEAT_PERIOD_MS);
+
+        /* Peer heard from recently, or Ping of this interval already sent */
+        if (((now - ctx->lastRxTick) < idleTicks) || ((now - ctx->lastPingTick) < idleTicks)) {
+            continue;
+        }
+
+        /* [R6] Send Ping on idle channel */
+        (void)PICC_HeartbeatSendPing(ctx->instanceId, ctx->channelId);
+        ctx->lastPingTick = now;
+
+        /* [R6] Increment miss count and check timeout */
+        timeout = FALSE;
+        taskENTER_CRITICAL();
+        ctx->missCount++;
+        if (ctx->missCount >= PICC_HEARTBEAT_TIMEOUT_COUNT) {
+            ctx->missCount = 0U;  /* Reset after notification */
+            timeout = TRUE;
+        }
+        taskEXIT_CRITICAL();
+
+        if ((timeout != FALSE) && (g_timeoutCallback != NULL)) {
+            /* Timeout - notify application via callback */
+            g_timeoutCallback(ctx->instanceId, ctx->channelId);
         }
     }
 }
@@ -143,10 +192,11 @@ sint8 PICC_HeartbeatInit(void)
         g_hbContexts[i].instanceId = 0U;
         g_hbContexts[i].channelId = 0U;
         g_hbContexts[i].missCount = 0U;
+        g_hbContexts[i].peerFlags = FALSE;
         g_hbContexts[i].isUsed = FALSE;
     }
+    PICC_HeartbeatIndexClear();
     
-    g_hbTimerCounter = 0U;
     g_timeoutCallback = NULL;
     
     /* NOTE: Timer removed - PICC_HeartbeatProcess() is called from PICC_PeriodicTask */
@@ -165,6 +215,7 @@ void PICC_HeartbeatDeinit(void)
     for (i = 0U; i < PICC_HEARTBEAT_MAX_CHANNELS; i++) {
         g_hbContexts[i].isUsed = FALSE;
     }
+    PICC_HeartbeatIndexClear();
     
     g_hbInitialized = FALSE;
 }
@@ -177,14 +228,20 @@ sint8 PICC_HeartbeatAddChannel(uint8 instanceId, uint8 channelId)
     uint32 i;
     sint8 freeSlot = -1;
     
+    if ((instanceId >= IPC_SHM_MAX_INSTANCES) || (channelId >= IPC_SHM_MAX_CHANNELS)) {
+        HANDLE_ERROR(-44);  /* Heartbeat: instance/channel outside context index */
+        return -2;
+    }
+
     /* Check if already exists */
+    if (PICC_GetHeartbeatContext(instanceId, channelId) != NULL) {
+        return 0;  /* Already exists, success */
+    }
+
     for (i = 0U; i < PICC_HEARTBEAT_MAX_CHANNELS; i++) {
-        if (g_hbContexts[i].isUsed && 
-            g_hbContexts[i].channelId == channelId) {
-            return 0;  /* Already exists, success */
-        }
-        if (freeSlot == -1 && g_hbContexts[i].isUsed == FALSE) {
+        if (g_hbContexts[i].isUsed == FALSE) {
             freeSlot = (sint8)i;
+            break;
         }
     }
     
@@ -196,7 +253,11 @@ sint8 PICC_HeartbeatAddChannel(uint8 instanceId, uint8 channelId)
     g_hbContexts[freeSlot].instanceId = instanceId;
     g_hbContexts[freeSlot].channelId = channelId;
     g_hbContexts[freeSlot].missCount = 0U;
+    g_hbContexts[freeSlot].peerFlags = FALSE;
+    g_hbContexts[freeSlot].lastRxTick = (uint32)xTaskGetTickCount();
+    g_hbContexts[freeSlot].lastPingTick = g_hbContexts[freeSlot].lastRxTick;
     g_hbContexts[freeSlot].isUsed = TRUE;
+    g_hbIndex[instanceId][channelId] = (uint8)freeSlot;
     
     return 0;
 }
@@ -211,7 +272,10 @@ sint8 PICC_HeartbeatSendPing(uint8 instanceId, uint8 channelId)
     };
     sint8 ret;
 
-    (void)instanceId;  /* Currently Stack uses fixed IPCF_INSTANCE0 */
+    if (PICC_HeartbeatFlagMode(PICC_GetHeartbeatContext(instanceId, channelId)) != FALSE) {
+        /* Ping flag on the next frame (empty control frame if channel is idle) */
+        return PICC_StackSendHeartbeat(channelId, PICC_STACK_FLAG_HB_PING);
+    }
 
     /* Send through Stack layer */
     ret = PICC_StackAddMessageToChannel(channelId, pingMsg, PICC_HEARTBEAT_MSG_SIZE);
@@ -299,6 +363,31 @@ sint8 PICC_HeartbeatHandlePing(uint8 instanceId, uint8 channelId)
     return ret;
 }
 
+/**
+ * @brief Note valid frame received on a channel
+ */
+void PICC_HeartbeatNotifyRx(uint8 instanceId, uint8 channelId, uint8 hbFlags)
+{
+    PICC_HeartbeatContext_t *ctx;
+
+    PICC_HeartbeatReset(instanceId, channelId);
+
+    if (hbFlags == 0U) {
+        return;
+    }
+
+    /* Peer understands heartbeat flags: send ours as flags from now on */
+    ctx = PICC_GetHeartbeatContext(instanceId, channelId);
+    if (ctx != NULL) {
+        ctx->peerFlags = TRUE;
+    }
+
+    /* Peer asks for a sign of life: Pong flag, sent at once */
+    if ((hbFlags & PICC_STACK_FLAG_HB_PING) != 0U) {
+        (void)PICC_StackSendHeartbeat(channelId, PICC_STACK_FLAG_HB_PONG);
+    }
+}
+
 /**
  * @brief Reset heartbeat miss count
  */
@@ -309,6 +398,7 @@ void PICC_HeartbeatReset(uint8 instanceId, uint8 channelId)
         /* [FIX] Use critical section to prevent race with Timer callback */
         taskENTER_CRITICAL();
         ctx->missCount = 0U;
+        ctx->lastRxTick = (uint32)xTaskGetTickCount();
         taskEXIT_CRITICAL();
     }
 }
@@ -4,6 +4,10 @@
  *
  * Low-level heartbeat (Ping/Pong) functionality for IPC channel health monitoring.
  * Independent of application-level connection state (no CONSUMER_ID/PROVIDER_ID).
+ * Any valid received frame proves the peer alive; Ping is only sent after
+ * an idle interval without received frames. Legacy 9-byte Ping/Pong
+ * messages are used until the peer has shown it understands heartbeat
+ * frame flags (optional, PICC_HEARTBEAT_PIGGYBACK).
  *
  * Copyright 2024 NXP
  * All Rights Reserved.
@@ -22,12 +26,27 @@ extern "C" {
  *                                         Macro Definitions
  *==================================================================================================*/
 
-/** Heartbeat period (ms) [R6]: 2 second period */
+/** Heartbeat period (ms) [R6]: legacy Ping interval while nothing is received */
 #define PICC_HEARTBEAT_PERIOD_MS        (2000U)
 
-/** Heartbeat timeout count threshold [R6]: 3 consecutive misses indicates fault */
+/** Ping interval while nothing is received, channel in flag mode (ms) */
+#define PICC_HEARTBEAT_IDLE_MS          (30U)
+
+/** Heartbeat timeout count threshold [R6]: 3 consecutive misses indicates fault
+ *  (timeout = Ping interval * PICC_HEARTBEAT_TIMEOUT_COUNT) */
 #define PICC_HEARTBEAT_TIMEOUT_COUNT    (3U)
 
+/**
+ * Heartbeat frame flags (Ping/Pong as bits 6/7 of frame byte 0).
+ * FALSE: legacy 9-byte Ping/Pong messages only (wire format unchanged).
+ * TRUE: a channel switches to flag mode once a frame with a heartbeat flag
+ * was received from the peer; until then legacy Pings are sent, so peers
+ * without flag support are never sent flags.
+ */
+#ifndef PICC_HEARTBEAT_PIGGYBACK
+#define PICC_HEARTBEAT_PIGGYBACK        (FALSE)
+#endif
+
 /** Heartbeat message length [R6]: Special format 9 bytes */
 #define PICC_HEARTBEAT_MSG_SIZE         (9U)
 
@@ -104,10 +123,22 @@ sint8 PICC_HeartbeatSendPong(uint8 instanceId, uint8 channelId);
  */
 sint8 PICC_HeartbeatHandlePing(uint8 instanceId, uint8 channelId);
 
+/**
+ * @brief Note valid frame received on a channel (Rx task context)
+ * 
+ * Resets the miss count, answers a Ping flag with a Pong flag. A heartbeat
+ * flag switches the channel to flag mode (PICC_HEARTBEAT_PIGGYBACK).
+ * 
+ * @param[in] instanceId Receive instance ID
+ * @param[in] channelId  Receive channel ID
+ * @param[in] hbFlags    Heartbeat flags of the frame (PICC_STACK_FLAG_HB_xxx)
+ */
+void PICC_HeartbeatNotifyRx(uint8 instanceId, uint8 channelId, uint8 hbFlags);
+
 /**
  * @brief Reset heartbeat miss count for specified channel
  * 
- * Called when Pong is received.
+ * Called when a valid frame is received.
  * 
  * @param[in] instanceId Instance ID
  * @param[in] channelId  Channel ID
@@ -152,7 +183,8 @@ uint8 PICC_HeartbeatGetMissCount(uint8 instanceId, uint8 channelId);
 /**
  * @brief Heartbeat process - called from PICC periodic task (10ms)
  * 
- * [R6] Sends Ping every 2000ms and checks timeout.
+ * [R6] Sends Ping every PICC_HEARTBEAT_PERIOD_MS (PICC_HEARTBEAT_IDLE_MS in
+ * flag mode) while nothing is received and checks timeout.
  */
 void PICC_HeartbeatProcess(void);
 
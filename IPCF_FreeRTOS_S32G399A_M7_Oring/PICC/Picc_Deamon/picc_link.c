@@ -27,20 +27,30 @@ extern "C" {
  *                                         Private Variables
  *==================================================================================================*/
 
+/** Send flow control: maximum backoff value (100 * 10ms = 1000ms) */
+#define PICC_SEND_BACKOFF_MAX       (100U)
+
+/** Send flow control: backoff increment (number of periods added on each buffer full) */
+#define PICC_SEND_BACKOFF_INCREMENT (10U)
+
+/** Index entry: no context */
+#define PICC_LINK_NO_SLOT           (0xFFU)
+
+#if (PICC_MAX_CHANNELS >= PICC_LINK_NO_SLOT)
+#error "PICC_MAX_CHANNELS: must be below 255 (uint8 index)"
+#endif
+
 /** Link context array */
 static PICC_LinkContext_t g_linkContexts[PICC_MAX_CHANNELS];
 
+/** Context slot per (instance, channel), PICC_LINK_NO_SLOT if none */
+static uint8 g_linkIndex[IPC_SHM_MAX_INSTANCES][IPC_SHM_MAX_CHANNELS];
+
 /** State change callback */
 static PICC_LinkStateCallback_t g_stateCallback = NULL;
 
-/** Send flow control: backoff counter (incremented when buffer full, used to reduce send frequency) */
-static uint8 g_sendBackoffCounter = 0U;
-
-/** Send flow control: maximum backoff value (100 * 10ms = 1000ms) */
-#define PICC_SEND_BACKOFF_MAX       (100U)
-
-/** Send flow control: backoff increment (number of periods added on each buffer full) */
-#define PICC_SEND_BACKOFF_INCREMENT (10U)
+/** Backoff jitter generator state (periodic task only, never 0) */
+static uint32 g_linkJitterState = 0x2545F491U;
 
 /*==================================================================================================
  *                                         Private Function Declarations
@@ -52,19 +62,65 @@ static PICC_LinkContext_t* PICC_GetLinkContext(uint8 instanceId, uint8 channelId
  *==================================================================================================*/
 
 /**
- * @brief Get context by Channel ID
+ * @brief Get context by Channel ID (constant time)
  */
 static PICC_LinkContext_t* PICC_GetLinkContext(uint8 instanceId, uint8 channelId)
+{
+    uint8 slot;
+
+    if ((instanceId >= IPC_SHM_MAX_INSTANCES) || (channelId >= IPC_SHM_MAX_CHANNELS)) {
+        return NULL;
+    }
+
+    slot = g_linkIndex[instanceId][channelId];
+    if ((slot == PICC_LINK_NO_SLOT) || (g_linkContexts[slot].config.isUsed == FALSE)) {
+        return NULL;
+    }
+    return &g_linkContexts[slot];
+}
+
+/**
+ * @brief Clear (instance, channel) index
+ */
+static void PICC_LinkIndexClear(void)
 {
     uint32 i;
-    for (i = 0U; i < PICC_MAX_CHANNELS; i++) {
-        if (g_linkContexts[i].config.isUsed != FALSE && 
-            g_linkContexts[i].config.instanceId == instanceId &&
-            g_linkContexts[i].config.channelId == channelId) {
-            return &g_linkContexts[i];
+    uint32 c;
+
+    for (i = 0U; i < IPC_SHM_MAX_INSTANCES; i++) {
+        for (c = 0U; c < IPC_SHM_MAX_CHANNELS; c++) {
+            g_linkIndex[i][c] = PICC_LINK_NO_SLOT;
         }
     }
-    return NULL;
+}
+
+/**
+ * @brief Next backoff of a link (exponential with equal jitter)
+ * 
+ * Span doubles per failure up to PICC_SEND_BACKOFF_MAX; the wait is a
+ * random value in [span/2, span], so links failing together (and both
+ * cores) don't retry in lockstep.
+ */
+static void PICC_LinkBackoff(PICC_LinkContext_t *ctx)
+{
+    uint32 half;
+
+    if (ctx->backoffSpan == 0U) {
+        ctx->backoffSpan = PICC_SEND_BACKOFF_INCREMENT;
+    } else {
+        ctx->backoffSpan = (uint16)(ctx->backoffSpan * 2U);
+        if (ctx->backoffSpan > PICC_SEND_BACKOFF_MAX) {
+            ctx->backoffSpan = PICC_SEND_BACKOFF_MAX;
+        }
+    }
+
+    /* xorshift32 */
+    g_linkJitterState ^= g_linkJitterState << 13U;
+    g_linkJitterState ^= g_linkJitterState >> 17U;
+    g_linkJitterState ^= g_linkJitterState << 5U;
+
+    half = (uint32)ctx->backoffSpan / 2U;
+    ctx->backoffCount = (uint16)(half + (g_linkJitterState % (half + 1U)));
 }
 
 /**
@@ -171,9 +227,19 @@ void PICC_LinkProcess(void)
         if ((ctx->config.role == PICC_ROLE_CLIENT) && 
             (ctx->state == PICC_LINK_STATE_CONNECTING)) {
             
-            /* [Flow control] If backoff count exists, skip this send */
-            if (g_sendBackoffCounter > 0U) {
-                g_sendBackoffCounter--;
+            /* [Flow control] Credits replenished by A-core end the backoff early */
+            if ((ctx->backoffCount > 0U) &&
+                (PICC_StackTakeCreditEvent(ctx->config.channelId) != FALSE)) {
+                ctx->backoffCount = 0U;
+                ctx->backoffSpan = 0U;
+            }
+
+            /* [Flow control] Backoff of this link only, other links keep their own pace */
+            if (ctx->backoffCount > 0U) {
+                ctx->backoffCount--;
+            } else if (PICC_StackGetTxCredits(ctx->config.channelId) == 0U) {
+                /* No free A-core buffer: wait for credit event, don't spin on acquire */
+                PICC_LinkBackoff(ctx);
             } else {
                 /* Send connection request */
                 sint8 sendResult = PICC_LinkSendMessage(ctx->config.remoteId,
@@ -184,26 +250,16 @@ void PICC_LinkProcess(void)
                                                         ctx->config.channelId);
                 
                 /* [Flow control - Hybrid Exponential Backoff]
-                 * Doubles backoff on each failure, capped at maximum.
-                 * Sequence: 10→20→40→80→100 (100ms→200ms→400ms→800ms→1000ms)
-                 * Balances quick initial retries with longer waits for persistent failures.
+                 * Doubles backoff span on each failure, capped at maximum.
+                 * Span sequence: 10→20→40→80→100 (100ms→200ms→400ms→800ms→1000ms),
+                 * actual wait jittered within [span/2, span].
                  */
                 if (sendResult != 0) {
-                    if (g_sendBackoffCounter == 0U) {
-                        /* First failure - start with base increment */
-                        g_sendBackoffCounter = PICC_SEND_BACKOFF_INCREMENT;
-                    } else {
-                        /* Subsequent failures - double the backoff */
-                        g_sendBackoffCounter = g_sendBackoffCounter * 2U;
-                        
-                        /* Cap at maximum to prevent overflow */
-                        if (g_sendBackoffCounter > PICC_SEND_BACKOFF_MAX) {
-                            g_sendBackoffCounter = PICC_SEND_BACKOFF_MAX;
-                        }
-                    }
+                    PICC_LinkBackoff(ctx);
                 } else {
-                    /* Send succeeded - reset backoff counter for clean slate */
-                    g_sendBackoffCounter = 0U;
+                    /* Send succeeded - reset backoff for clean slate */
+                    ctx->backoffCount = 0U;
+                    ctx->backoffSpan = 0U;
                 }
             }
         }
@@ -222,16 +278,29 @@ sint8 PICC_LinkInit(const PICC_LinkConfig_t *config)
         return -1;
     }
 
+    if ((config->instanceId >= IPC_SHM_MAX_INSTANCES) || (config->channelId >= IPC_SHM_MAX_CHANNELS)) {
+        HANDLE_ERROR(-43);  /* Link: instance/channel outside context index */
+        return -2;
+    }
+
     /* Clear all contexts */
     for (i = 0U; i < PICC_MAX_CHANNELS; i++) {
         g_linkContexts[i].config.isUsed = FALSE;
         g_linkContexts[i].isInitialized = FALSE;
         g_linkContexts[i].state = PICC_LINK_STATE_DISCONNECTED;
+        g_linkContexts[i].backoffCount = 0U;
+        g_linkContexts[i].backoffSpan = 0U;
+    }
+    PICC_LinkIndexClear();
+    g_linkJitterState ^= (uint32)xTaskGetTickCount();
+    if (g_linkJitterState == 0U) {
+        g_linkJitterState = 0x2545F491U;
     }
 
     /* Initialize first channel */
     g_linkContexts[0].config = *config;
     g_linkContexts[0].config.isUsed = TRUE;
+    g_linkIndex[config->instanceId][config->channelId] = 0U;
     
     /* [R5] Role auto-start mechanism:
      * - CLIENT: Auto enters CONNECTING state, timer will periodically send connection requests
@@ -255,22 +324,27 @@ sint8 PICC_LinkInit(const PICC_LinkConfig_t *config)
 sint8 PICC_LinkAddChannel(uint8 instanceId, uint8 channelId)
 {
     uint32 i;
-    sint8 slot = -1;
+    uint8 slot = PICC_LINK_NO_SLOT;
     
+    if ((instanceId >= IPC_SHM_MAX_INSTANCES) || (channelId >= IPC_SHM_MAX_CHANNELS)) {
+        HANDLE_ERROR(-43);  /* Link: instance/channel outside context index */
+        return -3;
+    }
+
     /* Check if already exists */
+    if (PICC_GetLinkContext(instanceId, channelId) != NULL) {
+        return 0; /* Already exists, return success */
+    }
+
+    /* Record first free slot */
     for (i = 0U; i < PICC_MAX_CHANNELS; i++) {
-        if (g_linkContexts[i].config.isUsed != FALSE && 
-            g_linkContexts[i].config.instanceId == instanceId &&
-            g_linkContexts[i].config.channelId == channelId) {
-            return 0; /* Already exists, return success */
-        }
-        /* Record first free slot */
-        if (slot == -1 && g_linkContexts[i].config.isUsed == FALSE) {
-            slot = (sint8)i;
+        if (g_linkContexts[i].config.isUsed == FALSE) {
+            slot = (uint8)i;
+            break;
         }
     }
 
-    if (slot == -1) {
+    if (slot == PICC_LINK_NO_SLOT) {
         HANDLE_ERROR(-4);  /* No free slot for link channel */
         return -1; /* No free slot */
     }
@@ -288,7 +362,10 @@ sint8 PICC_LinkAddChannel(uint8 instanceId, uint8 channelId)
     g_linkContexts[slot].config.isUsed = TRUE;
     
     g_linkContexts[slot].state = PICC_LINK_STATE_DISCONNECTED;
+    g_linkContexts[slot].backoffCount = 0U;
+    g_linkContexts[slot].backoffSpan = 0U;
     g_linkContexts[slot].isInitialized = TRUE;
+    g_linkIndex[instanceId][channelId] = slot;
     
     /* [FIX] Additional channels do NOT participate in Link management.
      * Only the primary channel (initialized via PICC_LinkInit) sends Link requests.
@@ -315,6 +392,7 @@ void PICC_LinkDeinit(void)
         g_linkContexts[i].config.isUsed = FALSE;
         g_linkContexts[i].state = PICC_LINK_STATE_DISCONNECTED;
     }
+    PICC_LinkIndexClear();
     
     g_stateCallback = NULL;
 }
@@ -606,12 +684,14 @@ sint8 PICC_LinkHandleDisconnect(const PICC_MsgHeader_t *header,
  */
 PICC_LinkState_e PICC_LinkGetState(uint8 channelId)
 {
+    PICC_LinkContext_t *ctx;
     uint32 i;
     
-    for (i = 0U; i < PICC_MAX_CHANNELS; i++) {
-        if (g_linkContexts[i].config.isUsed && 
-            g_linkContexts[i].config.channelId == channelId) {
-            return g_linkContexts[i].state;
+    /* Channel on any instance, lowest instance first */
+    for (i = 0U; i < IPC_SHM_MAX_INSTANCES; i++) {
+        ctx = PICC_GetLinkContext((uint8)i, channelId);
+        if (ctx != NULL) {
+            return ctx->state;
         }
     }
     return PICC_LINK_STATE_DISCONNECTED;
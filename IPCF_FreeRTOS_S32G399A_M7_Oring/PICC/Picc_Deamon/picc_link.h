@@ -27,7 +27,7 @@ extern "C" {
 /** Connection request period (ms) */
 #define PICC_LINK_REQUEST_PERIOD_MS     (10U)
 
-/** Maximum supported channels */
+/** Maximum supported channels (contexts are found through an (instance, channel) index) */
 #define PICC_MAX_CHANNELS               (2U)
 
 /*==================================================================================================
@@ -66,6 +66,8 @@ typedef struct {
     PICC_LinkConfig_t config;           /**< Link configuration */
     volatile PICC_LinkState_e state;    /**< Current state (volatile) */
     boolean           isInitialized;    /**< Whether initialized */
+    uint16            backoffCount;     /**< Periods left before next connection request */
+    uint16            backoffSpan;      /**< Current backoff span (doubles per failure) */
 } PICC_LinkContext_t;
 
 /**
@@ -31,13 +31,14 @@ extern "C"{
 /* FreeRTOS */
 #include "FreeRTOS.h"
 #include "task.h"
-#include "queue.h"
 
 /* PICC module */
 #include "picc_api.h"
 #include "picc_stack.h"     /* For PICC_StackProcess */
 #include "picc_heartbeat.h" /* For PICC_HeartbeatProcess */
 #include "picc_link.h"      /* For PICC_LinkProcess */
+#include "picc_service.h"   /* For PICC_ServiceRequestProcess */
+#include "picc_frag.h"      /* For PICC_FragProcess */
 
 /* Power management module */
 #include "picc_pwr_main.h"
@@ -55,6 +56,8 @@ extern "C"{
 #define PICC_INIT_TASK_STACK_SIZE   (256U)  // 1KB
 #define RX_TASK_STACK_SIZE          (192U)  // 768B
 #define PERIODIC_TASK_STACK_SIZE    (256U)  // 1KB
+#define STACK_FLUSH_TASK_STACK_SIZE (256U)  // 1KB
+#define SERVICE_WORKER_STACK_SIZE   (256U)  // 1KB
 
 /** Control channel configuration */
 #define CTRL_CHAN_ID            (0U)
@@ -64,6 +67,91 @@ extern "C"{
 
 #define MAX_MSG_LEN             (PICC_STACK_MAX_SIZE)
 
+/** Receive queue overflow policies */
+#define APP_RX_OVERFLOW_DROP_NEWEST     (0U)    /**< Release the arriving buffer */
+#define APP_RX_OVERFLOW_DROP_OLDEST     (1U)    /**< Release the oldest queued buffer */
+#define APP_RX_OVERFLOW_BACKPRESSURE    (2U)    /**< Keep buffer unreleased in defer ring */
+
+/** Receive ring depth (aggregates) */
+#ifndef APP_RX_QUEUE_DEPTH
+#define APP_RX_QUEUE_DEPTH              (16U)
+#endif
+
+/** Receive queue overflow policy (APP_RX_OVERFLOW_xxx) */
+#ifndef APP_RX_OVERFLOW_POLICY
+#define APP_RX_OVERFLOW_POLICY          (APP_RX_OVERFLOW_BACKPRESSURE)
+#endif
+
+/**
+ * Buffers of one data channel (sum of its pools, mirrors
+ * ipcf_shm_cfg_buf_pools0_1/0_2 in ipcf_Ip_Cfg.c). Update on regeneration.
+ */
+#ifndef APP_RX_CHAN_BUFS
+#define APP_RX_CHAN_BUFS                (30U + 20U + 10U)
+#endif
+
+/** Buffers the remote can have in flight on all data channels (all but control) */
+#define APP_RX_DATA_CHAN_BUFS           (APP_RX_CHAN_BUFS * (IPC_SHM_MAX_CHANNELS - 1U))
+
+/**
+ * Defer ring depth (backpressure policy). Deferred buffers stay owned by
+ * the M7 until processed, so the remote runs out of Tx buffers and slows
+ * down instead of frames being lost. Every queued message holds one data
+ * channel buffer, so receive and defer ring together hold all of them and
+ * the defer ring cannot overflow.
+ */
+#ifndef APP_RX_DEFER_DEPTH
+#define APP_RX_DEFER_DEPTH              (APP_RX_DATA_CHAN_BUFS - APP_RX_QUEUE_DEPTH)
+#endif
+
+/** Messages processed per rx task wakeup before yielding */
+#ifndef APP_RX_DRAIN_BUDGET
+#define APP_RX_DRAIN_BUDGET             (16U)
+#endif
+
+/**
+ * Processed buffers released to IPCF in one batch (one dcache flush).
+ * Bounds release latency: a buffer is held for at most this many messages.
+ */
+#ifndef APP_RX_RELEASE_BATCH
+#define APP_RX_RELEASE_BATCH            (8U)
+#endif
+
+/**
+ * Direct Rx processing: frames whose messages only run lightweight handlers
+ * (PICC_HANDLER_FLAG_DIRECT) are processed in the IPCF receive callback,
+ * without queue and task switch. Other frames still go to the rx task.
+ */
+#ifndef APP_RX_DIRECT_MODE
+#define APP_RX_DIRECT_MODE              (FALSE)
+#endif
+
+/**
+ * Service worker task priorities, one per PICC_SERVICE_WORKER_NUM worker.
+ * Below the rx task, so requests are queued before a handler runs; a
+ * service picks its priority with PICC_ServiceSetWorker().
+ */
+#ifndef APP_SERVICE_WORKER_PRIORITIES
+#define APP_SERVICE_WORKER_PRIORITIES   { tskIDLE_PRIORITY + 2U, tskIDLE_PRIORITY + 1U }
+#endif
+
+#if (APP_RX_OVERFLOW_POLICY > APP_RX_OVERFLOW_BACKPRESSURE)
+#error "APP_RX_OVERFLOW_POLICY: unknown policy"
+#endif
+
+#if (APP_RX_RELEASE_BATCH == 0U) || (APP_RX_DRAIN_BUDGET == 0U)
+#error "APP_RX_RELEASE_BATCH / APP_RX_DRAIN_BUDGET: must not be 0"
+#endif
+
+#if (APP_RX_CHAN_BUFS > (IPC_SHM_MAX_POOLS * IPC_SHM_MAX_BUFS_PER_POOL))
+#error "APP_RX_CHAN_BUFS: more buffers than the IPCF configuration allows"
+#endif
+
+#if (APP_RX_OVERFLOW_POLICY == APP_RX_OVERFLOW_BACKPRESSURE) && \
+    ((APP_RX_QUEUE_DEPTH + APP_RX_DEFER_DEPTH) < APP_RX_DATA_CHAN_BUFS)
+#error "APP_RX_DEFER_DEPTH: receive and defer ring must hold all data channel buffers"
+#endif
+
 /*==================================================================================================
  *                                         Private Type Definitions
  *==================================================================================================*/
@@ -84,7 +172,7 @@ typedef struct {
 } App_Data_t;
 
 /**
- * @brief Receive message structure (for queue)
+ * @brief Receive message structure (for receive ring)
  */
 typedef struct {
     uint8   instance;   /**< IPCF instance */
@@ -94,6 +182,40 @@ typedef struct {
     boolean isManaged;  /**< TRUE=Managed(needs release), FALSE=Unmanaged */
 } App_RxMsg_t;
 
+/**
+ * @brief Receive ring - messages handed from receive callback to rx task
+ *
+ * Written by the receive callback, read by the rx task (drop oldest also
+ * reads in the callback). Indexes change in a critical section only.
+ */
+typedef struct {
+    App_RxMsg_t    *slots;  /**< Message slots */
+    uint16          depth;  /**< Number of slots */
+    uint16          head;   /**< Oldest message */
+    volatile uint16 count;  /**< Messages in ring */
+} App_RxRing_t;
+
+/**
+ * @brief Receive queue statistics (for TRACE32)
+ *
+ * Counters written from the receive callback and the rx task only.
+ */
+typedef struct {
+    volatile uint32 queued;         /**< Messages put in receive ring */
+    volatile uint32 highWater;      /**< Maximum receive ring fill level */
+    volatile uint32 dropNewest;     /**< Arriving buffers released (ring full) */
+    volatile uint32 dropOldest;     /**< Queued buffers evicted (ring full) */
+    volatile uint32 deferred;       /**< Buffers held in defer ring (backpressure) */
+    volatile uint32 deferDropped;   /**< Arriving buffers released (defer ring full, stays 0) */
+    volatile uint32 direct;         /**< Messages processed in receive callback */
+    volatile uint32 wakeups;        /**< Rx task wakeups */
+    volatile uint32 processed;      /**< Messages processed by rx task */
+    volatile uint32 maxDrain;       /**< Maximum messages drained in one wakeup */
+    volatile uint32 budgetHits;     /**< Drains stopped by APP_RX_DRAIN_BUDGET */
+    volatile uint32 releaseBatches; /**< ipc_shm_release_bufs() calls */
+    volatile uint32 releaseErrors;  /**< Failed batch releases */
+} App_RxQueueStats_t;
+
 /*==================================================================================================
  *                                         Private Variables
  *==================================================================================================*/
@@ -104,8 +226,40 @@ static App_Data_t g_appData;
 /** link with generated variables */
 const void *rx_cb_arg = &g_appData;
 
-/** Receive queue handle */
-static QueueHandle_t g_rxQueue = NULL;
+/** Receive ring */
+static App_RxMsg_t g_rxSlots[APP_RX_QUEUE_DEPTH];
+static App_RxRing_t g_rxRing = { g_rxSlots, APP_RX_QUEUE_DEPTH, 0U, 0U };
+
+#if (APP_RX_OVERFLOW_POLICY == APP_RX_OVERFLOW_BACKPRESSURE)
+/** Defer ring - messages arrived while receive ring full */
+static App_RxMsg_t g_rxDeferSlots[APP_RX_DEFER_DEPTH];
+static App_RxRing_t g_rxDeferRing = { g_rxDeferSlots, APP_RX_DEFER_DEPTH, 0U, 0U };
+#endif
+
+/** Rx task handle, woken once per receive callback that queued messages */
+static TaskHandle_t g_rxTask = NULL;
+
+/** Receive queue statistics */
+static App_RxQueueStats_t g_rxQueueStats;
+
+/**
+ * Messages queued (receive or defer ring) and not yet processed by the rx
+ * task. Direct processing only while 0, so frames stay in arrival order and
+ * are never processed by the receive callback and the rx task at once.
+ */
+static volatile uint32 g_rxPending = 0U;
+
+/** Buffers dropped or processed by batched receive callback (softirq context only) */
+static struct ipc_shm_buf g_rxDropBatch[IPC_SHM_RX_BATCH_SIZE];
+
+/** Processed buffers pending release (rx task only) */
+static struct ipc_shm_buf g_rxReleaseBatch[APP_RX_RELEASE_BATCH];
+static uint32 g_rxReleaseCount = 0U;
+static uint8  g_rxReleaseInstance;
+static uint8  g_rxReleaseChanId;
+
+/** Service worker task priorities */
+static const UBaseType_t g_workerPriorities[PICC_SERVICE_WORKER_NUM] = APP_SERVICE_WORKER_PRIORITIES;
 
 /** Exit code (for main loop) */
 volatile uint8 exit_code;
@@ -170,6 +324,239 @@ static void App_LinkStateCallback(uint8 remoteId, PICC_LinkState_e state)
     g_appData.link_state = (uint8)state;
 }
 
+/*==================================================================================================
+ *                                         Receive Queue Functions
+ *==================================================================================================*/
+
+/**
+ * @brief Update count of queued, not yet processed messages (any context)
+ */
+static void App_RxPendingAdd(sint32 delta)
+{
+    UBaseType_t savedMask;
+
+    savedMask = taskENTER_CRITICAL_FROM_ISR();
+    g_rxPending = (uint32)((sint32)g_rxPending + delta);
+    taskEXIT_CRITICAL_FROM_ISR(savedMask);
+}
+
+/**
+ * @brief Process received message in receive callback if possible
+ *
+ * Only when direct mode is on, nothing is pending for the rx task and all
+ * messages of the frame have lightweight handlers.
+ * The caller releases the buffer when TRUE is returned.
+ *
+ * @return TRUE if the message was processed
+ */
+static boolean App_RxProcessDirect(const App_RxMsg_t *msg)
+{
+    if ((APP_RX_DIRECT_MODE == FALSE) || (g_rxPending != 0U) ||
+        (PICC_IsDirectRxData(msg->buf, msg->size) == FALSE)) {
+        return FALSE;
+    }
+
+    (void)PICC_ProcessRxData(msg->instance, msg->chanId, msg->buf, msg->size);
+    g_rxQueueStats.direct++;
+    g_appData.tx_count++;
+
+    return TRUE;
+}
+
+/**
+ * @brief Append message to ring (any context)
+ *
+ * @return Fill level after append, 0 if the ring is full
+ */
+static uint16 App_RxRingPut(App_RxRing_t *ring, const App_RxMsg_t *msg)
+{
+    UBaseType_t savedMask;
+    uint16 fill = 0U;
+
+    savedMask = taskENTER_CRITICAL_FROM_ISR();
+    if (ring->count < ring->depth) {
+        ring->slots[(ring->head + ring->count) % ring->depth] = *msg;
+        ring->count++;
+        fill = ring->count;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(savedMask);
+
+    return fill;
+}
+
+/**
+ * @brief Take oldest message from ring (any context)
+ *
+ * @return TRUE if a message was taken
+ */
+static boolean App_RxRingGet(App_RxRing_t *ring, App_RxMsg_t *msg)
+{
+    UBaseType_t savedMask;
+    boolean taken = FALSE;
+
+    savedMask = taskENTER_CRITICAL_FROM_ISR();
+    if (ring->count != 0U) {
+        *msg = ring->slots[ring->head];
+        ring->head = (uint16)((ring->head + 1U) % ring->depth);
+        ring->count--;
+        taken = TRUE;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(savedMask);
+
+    return taken;
+}
+
+/**
+ * @brief Put received message in receive ring - ISR context
+ *
+ * Applies APP_RX_OVERFLOW_POLICY when the receive ring is full.
+ * With backpressure, messages go to the defer ring as long as it is not
+ * empty, so they are processed in arrival order.
+ * Doesn't wake the rx task: the caller does it once per callback
+ * (App_RxWakeFromISR).
+ *
+ * @param[in] msg Received message
+ * @return TRUE if the message is queued, FALSE if the caller must release it
+ */
+static boolean App_RxEnqueueFromISR(const App_RxMsg_t *msg)
+{
+    uint16 fill;
+#if (APP_RX_OVERFLOW_POLICY == APP_RX_OVERFLOW_DROP_OLDEST)
+    App_RxMsg_t oldest;
+#endif
+
+#if (APP_RX_OVERFLOW_POLICY == APP_RX_OVERFLOW_BACKPRESSURE)
+    if (g_rxDeferRing.count != 0U) {
+        if (App_RxRingPut(&g_rxDeferRing, msg) == 0U) {
+            g_rxQueueStats.deferDropped++;
+            return FALSE;
+        }
+        g_rxQueueStats.deferred++;
+        App_RxPendingAdd(1);
+        return TRUE;
+    }
+#endif
+
+    fill = App_RxRingPut(&g_rxRing, msg);
+    if (fill == 0U) {
+#if (APP_RX_OVERFLOW_POLICY == APP_RX_OVERFLOW_DROP_NEWEST)
+        g_rxQueueStats.dropNewest++;
+        return FALSE;
+#elif (APP_RX_OVERFLOW_POLICY == APP_RX_OVERFLOW_DROP_OLDEST)
+        /* Evict oldest message, its buffer may belong to another channel */
+        if (App_RxRingGet(&g_rxRing, &oldest) != FALSE) {
+            if (oldest.isManaged != FALSE) {
+                (void)ipc_shm_release_buf(oldest.instance, oldest.chanId, oldest.buf);
+            }
+            g_rxQueueStats.dropOldest++;
+            App_RxPendingAdd(-1);
+        }
+        fill = App_RxRingPut(&g_rxRing, msg);
+        if (fill == 0U) {
+            g_rxQueueStats.dropNewest++;
+            return FALSE;
+        }
+#else
+        if (App_RxRingPut(&g_rxDeferRing, msg) == 0U) {
+            g_rxQueueStats.deferDropped++;
+            return FALSE;
+        }
+        g_rxQueueStats.deferred++;
+        App_RxPendingAdd(1);
+        return TRUE;
+#endif
+    }
+
+    g_rxQueueStats.queued++;
+    App_RxPendingAdd(1);
+    if ((uint32)fill > g_rxQueueStats.highWater) {
+        g_rxQueueStats.highWater = (uint32)fill;
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Wake rx task after messages were queued - ISR context
+ *
+ * Before the rx task runs, messages wait in the ring: the task drains it
+ * before its first wait.
+ */
+static void App_RxWakeFromISR(BaseType_t *pxWoken)
+{
+    if (g_rxTask != NULL) {
+        vTaskNotifyGiveFromISR(g_rxTask, pxWoken);
+    }
+}
+
+/**
+ * @brief Get next received message - rx task context
+ *
+ * Receive ring first, then defer ring (holds the newer messages).
+ *
+ * @param[out] msg Received message
+ * @return TRUE if a message was received
+ */
+static boolean App_RxDequeue(App_RxMsg_t *msg)
+{
+    if (App_RxRingGet(&g_rxRing, msg) != FALSE) {
+        return TRUE;
+    }
+
+#if (APP_RX_OVERFLOW_POLICY == APP_RX_OVERFLOW_BACKPRESSURE)
+    if (App_RxRingGet(&g_rxDeferRing, msg) != FALSE) {
+        return TRUE;
+    }
+#endif
+
+    return FALSE;
+}
+
+/**
+ * @brief Release pending processed buffers to IPCF - rx task context
+ */
+static void App_RxReleaseFlush(void)
+{
+    if (g_rxReleaseCount == 0U) {
+        return;
+    }
+
+    if (ipc_shm_release_bufs(g_rxReleaseInstance, g_rxReleaseChanId,
+                             g_rxReleaseBatch, g_rxReleaseCount) != 0) {
+        g_rxQueueStats.releaseErrors++;
+    }
+    g_rxQueueStats.releaseBatches++;
+    g_rxReleaseCount = 0U;
+}
+
+/**
+ * @brief Add processed buffer to release batch - rx task context
+ *
+ * A batch covers one channel; it is flushed when full or when a buffer of
+ * another channel is added.
+ */
+static void App_RxReleaseLater(const App_RxMsg_t *msg)
+{
+    if (msg->isManaged == FALSE) {
+        return;
+    }
+
+    if ((g_rxReleaseCount != 0U) &&
+        ((g_rxReleaseInstance != msg->instance) || (g_rxReleaseChanId != msg->chanId))) {
+        App_RxReleaseFlush();
+    }
+
+    g_rxReleaseInstance = msg->instance;
+    g_rxReleaseChanId   = msg->chanId;
+    g_rxReleaseBatch[g_rxReleaseCount].buf  = msg->buf;
+    g_rxReleaseBatch[g_rxReleaseCount].size = msg->size;
+    g_rxReleaseCount++;
+
+    if (g_rxReleaseCount >= APP_RX_RELEASE_BATCH) {
+        App_RxReleaseFlush();
+    }
+}
+
 /*==================================================================================================
  *                                         IPCF Callback Functions
  *==================================================================================================*/
@@ -177,7 +564,7 @@ static void App_LinkStateCallback(uint8 remoteId, PICC_LinkState_e state)
 /**
  * @brief Data channel receive callback - ISR context
  * 
- * @note Only pushes message to queue, no complex processing
+ * @note Only pushes message to receive ring, no complex processing
  */
 void data_chan_rx_cb(void *arg, const uint8 instance, uint8 chan_id, void *buf,
         uint32 size)
@@ -202,17 +589,85 @@ void data_chan_rx_cb(void *arg, const uint8 instance, uint8 chan_id, void *buf,
     msg.size      = size;
     msg.isManaged = TRUE;
 
-    /* Push to queue (non-blocking) */
-    if (g_rxQueue != NULL) {
-        if (xQueueSendFromISR(g_rxQueue, &msg, &xHigherPriorityTaskWoken) != pdPASS) {
-            (void)ipc_shm_release_buf(instance, chan_id, buf);
-            appPtr->error_count++;
+    /* Lightweight frame: process at once */
+    if (App_RxProcessDirect(&msg) != FALSE) {
+        (void)ipc_shm_release_buf(instance, chan_id, buf);
+        return;
+    }
 
-        }
-    } else {
+    /* Push to ring (non-blocking) */
+    if (App_RxEnqueueFromISR(&msg) == FALSE) {
         (void)ipc_shm_release_buf(instance, chan_id, buf);
+        appPtr->error_count++;
+        return;
+    }
+
+    App_RxWakeFromISR(&xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief Data channel batched receive callback - ISR context
+ * 
+ * Receives all buffers collected by IPCF within one budget round.
+ * Messages go into the receive ring without any kernel call, then the rx
+ * task is woken once for the whole batch. Dropped buffers are released with
+ * a single cache flush; buffers processed directly (APP_RX_DIRECT_MODE) go
+ * into the same release.
+ */
+void data_chan_rx_batch_cb(void *arg, const uint8 instance, uint8 chan_id,
+        const struct ipc_shm_buf *bufs, uint32 num_bufs)
+{
+    App_Data_t *appPtr = (App_Data_t *)(*((uintptr *)arg));
+    App_RxMsg_t msg;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32 numDropped = 0U;
+    uint32 numRelease = 0U;
+    uint32 numQueued = 0U;
+    uint32 i;
+
+    if (appPtr != &g_appData || bufs == NULL) {
+        HANDLE_ERROR(-IPC_SHM_E_INVAL);
+        return;
     }
 
+    appPtr->last_rx_ch = chan_id;
+
+    msg.instance  = instance;
+    msg.chanId    = chan_id;
+    msg.isManaged = TRUE;
+
+    for (i = 0U; i < num_bufs; i++) {
+        msg.buf  = bufs[i].buf;
+        msg.size = bufs[i].size;
+
+        if (bufs[i].size > MAX_MSG_LEN) {
+            g_rxDropBatch[numRelease] = bufs[i];
+            numRelease++;
+            numDropped++;
+        } else if (App_RxProcessDirect(&msg) != FALSE) {
+            /* Lightweight frame processed at once */
+            g_rxDropBatch[numRelease] = bufs[i];
+            numRelease++;
+        } else if (App_RxEnqueueFromISR(&msg) == FALSE) {
+            /* Push to ring (non-blocking), collect buffers that can't be queued */
+            g_rxDropBatch[numRelease] = bufs[i];
+            numRelease++;
+            numDropped++;
+        } else {
+            /* Queued, released by rx task */
+            numQueued++;
+        }
+    }
+
+    if (numRelease != 0U) {
+        (void)ipc_shm_release_bufs(instance, chan_id, g_rxDropBatch, numRelease);
+        appPtr->error_count += (uint16)numDropped;
+    }
+
+    if (numQueued != 0U) {
+        App_RxWakeFromISR(&xHigherPriorityTaskWoken);
+    }
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
@@ -256,15 +711,7 @@ static void PICC_Init_Task(void *params)
     (void)params;
 
     /* ========================================================================
-     * 1. Initialize receive queue
-     * ======================================================================== */
-    g_rxQueue = xQueueCreate(10, sizeof(App_RxMsg_t));
-    if (g_rxQueue == NULL) {
-        HANDLE_ERROR(-1);
-    }
-
-    /* ========================================================================
-     * 2. Initialize application data
+     * 1. Initialize application data
      * ======================================================================== */
     g_appData.rx_count    = 0U;
     g_appData.tx_count    = 0U;
@@ -275,7 +722,7 @@ static void PICC_Init_Task(void *params)
     g_appData.link_state  = (uint8)PICC_LINK_STATE_DISCONNECTED;
 
     /* ========================================================================
-     * 3. Initialize IPCF driver
+     * 2. Initialize IPCF driver
      * ======================================================================== */
     do {
         err = ipc_shm_init(&ipcf_shm_instances_cfg);
@@ -297,7 +744,7 @@ static void PICC_Init_Task(void *params)
     }
 
     /* ========================================================================
-     * 4. Initialize IPCF channels (Stack + Heartbeat) - CHANNEL LAYER
+     * 3. Initialize IPCF channels (Stack + Heartbeat) - CHANNEL LAYER
      * [R6] Heartbeat starts immediately, independent of connection state
      * ======================================================================== */
     err = PICC_InitChannel(IPCF_INSTANCE0, 1U);
@@ -311,7 +758,7 @@ static void PICC_Init_Task(void *params)
     }
 
     /* ========================================================================
-     * 5. Initialize PICC application infrastructure (Service Layer)
+     * 4. Initialize PICC application infrastructure (Service Layer)
      * ======================================================================== */
     piccCfg.linkLocalId  = PWR_PROVIDER_ID;
     piccCfg.linkRemoteId = PWR_CONSUMER_ID;
@@ -324,7 +771,7 @@ static void PICC_Init_Task(void *params)
     }
 
     /* ========================================================================
-     * 6. Register application-level Link (Power Management)
+     * 5. Register application-level Link (Power Management)
      * ======================================================================== */
     err = PICC_LinkRegister(&piccCfg);
     if (err != 0) {
@@ -332,7 +779,7 @@ static void PICC_Init_Task(void *params)
     }
 
     /* ========================================================================
-     * 7. Initialize power management module
+     * 6. Initialize power management module
      * ======================================================================== */
     err = Pwr_Init();
     if (err != 0) {
@@ -340,7 +787,7 @@ static void PICC_Init_Task(void *params)
     }
 
     /* ========================================================================
-     * 8. Register Link state callback
+     * 7. Register Link state callback
      * ======================================================================== */
     (void)PICC_RegisterLinkStateCallback(App_LinkStateCallback);
 
@@ -358,30 +805,55 @@ static void PICC_Init_Task(void *params)
  * @brief Main 10ms periodic task
  * 
  * Handles received messages from IPCF.
- * This task blocks on the RX queue waiting for messages.
+ * This task sleeps on its task notification, given once per receive
+ * callback, and drains the receive ring per wakeup (up to
+ * APP_RX_DRAIN_BUDGET before yielding). Processed buffers
+ * are released to IPCF in batches of APP_RX_RELEASE_BATCH, the rest at the
+ * end of the drain.
  */
 static void App_Rx_Msg_10ms_Task(void *params)
 {
     App_RxMsg_t rxMsg;
-    sint8 err;
+    uint32 numDrained;
 
     (void)params;
+
+    g_rxTask = xTaskGetCurrentTaskHandle();
+
     /* Main loop - process received messages */
     while (1) {
-        if (xQueueReceive(g_rxQueue, &rxMsg, portMAX_DELAY) == pdPASS) {
-            
+        if (App_RxDequeue(&rxMsg) == FALSE) {
+            /* Ring empty: wait for the receive callback */
+            (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+
+        g_rxQueueStats.wakeups++;
+        numDrained = 0U;
+
+        do {
             /* Process received message */
             (void)PICC_ProcessRxData(rxMsg.instance, rxMsg.chanId, rxMsg.buf, rxMsg.size);
-            
+
             /* Release buffer (Managed channel only) */
-            if (rxMsg.isManaged != FALSE) {
-                err = ipc_shm_release_buf(rxMsg.instance, rxMsg.chanId, rxMsg.buf);
-                if (err != 0) {
-                    /* Log release error */
-                }
-            }
-            
+            App_RxReleaseLater(&rxMsg);
+            App_RxPendingAdd(-1);
+
             g_appData.tx_count++;
+            numDrained++;
+        } while ((numDrained < APP_RX_DRAIN_BUDGET) && (App_RxDequeue(&rxMsg) != FALSE));
+
+        App_RxReleaseFlush();
+
+        g_rxQueueStats.processed += numDrained;
+        if (numDrained > g_rxQueueStats.maxDrain) {
+            g_rxQueueStats.maxDrain = numDrained;
+        }
+
+        /* Budget used up: let equal priority tasks run before draining on */
+        if (numDrained >= APP_RX_DRAIN_BUDGET) {
+            g_rxQueueStats.budgetHits++;
+            taskYIELD();
         }
     }
 }
@@ -439,12 +911,18 @@ void task_M7_0_10ms( void *pvParameters )
         /* PICC Stack: Send buffered messages on all channels */
         PICC_StackProcess();
 
-        /* PICC Heartbeat: Send Ping every 2000ms */
+        /* PICC Heartbeat: Ping idle channels, check timeout */
         PICC_HeartbeatProcess();
 
         /* PICC Link: Handle connection requests (Client mode) */
         PICC_LinkProcess();
 
+        /* PICC Service: Outstanding request timeouts/retries */
+        PICC_ServiceRequestProcess();
+
+        /* PICC Fragmentation: Pending fragments, reassembly timeouts */
+        PICC_FragProcess();
+
         /* Power State Machine */
         Pwsm_Main();
 
@@ -465,11 +943,15 @@ void task_M7_0_10ms( void *pvParameters )
  * - PICC_Init_Task: One-time initialization (priority 4, deletes itself)
  * - App_Main_10ms_Task: RX message processing (priority 1)
  * - task_M7_0_10ms: PICC periodic + Power state machine (priority 2)
+ * - PICC_StackFlush: PICC adaptive batching flush (priority 2)
+ * - PICC_Worker<n>: PICC service workers (APP_SERVICE_WORKER_PRIORITIES)
  */
 void PICC_Mian_Task(void)
 {
 #if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
     BaseType_t os_status;
+    char workerName[] = "PICC_Worker0";
+    uint32 i;
 
     /* Create initialization task (high priority, runs once then deletes itself) */
     os_status = xTaskCreate((TaskFunction_t)PICC_Init_Task,
@@ -508,6 +990,34 @@ void PICC_Mian_Task(void)
         HANDLE_ERROR((sint8)os_status);
     }
 
+    /* Create PICC stack flush task (idle/threshold/deadline flush)
+     * Same priority as task_M7_0_10ms: bursts from equal priority
+     * producers are batched before the flush task runs.
+     */
+    os_status = xTaskCreate((TaskFunction_t)PICC_StackFlushTask,
+                "PICC_StackFlush",
+                STACK_FLUSH_TASK_STACK_SIZE,
+                NULL,
+                tskIDLE_PRIORITY + 2,
+                NULL);
+    if (os_status != pdPASS) {
+        HANDLE_ERROR((sint8)os_status);
+    }
+
+    /* Create PICC service worker tasks (Method handlers of opted-in services) */
+    for (i = 0U; i < PICC_SERVICE_WORKER_NUM; i++) {
+        workerName[sizeof(workerName) - 2U] = (char)('0' + i);
+        os_status = xTaskCreate((TaskFunction_t)PICC_ServiceWorkerTask,
+                    workerName,
+                    SERVICE_WORKER_STACK_SIZE,
+                    (void *)(uintptr)i,
+                    g_workerPriorities[i],
+                    NULL);
+        if (os_status != pdPASS) {
+            HANDLE_ERROR((sint8)os_status);
+        }
+    }
+
 #endif
 
 #if (configSUPPORT_STATIC_ALLOCATION == 1)
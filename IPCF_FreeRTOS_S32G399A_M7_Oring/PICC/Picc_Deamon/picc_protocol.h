@@ -59,6 +59,7 @@ typedef enum {
     PICC_MSG_REQUEST_NO_RETURN_WITHOUT_ACK  = 0x07U,  /**< Method request (no Response, no ACK) */
     PICC_MSG_NOTIFICATION_WITH_ACK          = 0x08U,  /**< Event notification (with ACK) */
     PICC_MSG_NOTIFICATION_WITHOUT_ACK       = 0x09U,  /**< Event notification (no ACK) */
+    PICC_MSG_FRAGMENT                       = 0x0AU,  /**< Fragment of a large message @see picc_frag.h */
     PICC_MSG_RESPONSE                       = 0x80U,  /**< Method response */
     PICC_MSG_ACK                            = 0x81U,  /**< Method ACK */
     PICC_MSG_EVENT_ACK                      = 0x82U,  /**< Event ACK */
@@ -171,6 +172,53 @@ typedef struct {
 /** CRC16 start value */
 #define PICC_CRC16_START_VALUE   (0xFFFFU)
 
+/** CRC16 engines (value = bytes consumed per step, all engines give identical results) */
+#define PICC_CRC16_ENGINE_NIBBLE (0U)   /**< Half-byte table, 32 B flash, slowest */
+#define PICC_CRC16_ENGINE_TABLE  (1U)   /**< Byte table, 512 B flash */
+#define PICC_CRC16_ENGINE_SLICE4 (4U)   /**< Slicing-by-4, 2 KB flash */
+#define PICC_CRC16_ENGINE_SLICE8 (8U)   /**< Slicing-by-8, 4 KB flash, fastest on large frames */
+
+/** Selected CRC16 engine (override from build settings for flash-constrained builds, see bench_picc_crc16.c) */
+#ifndef PICC_CRC16_ENGINE
+#define PICC_CRC16_ENGINE        PICC_CRC16_ENGINE_SLICE8
+#endif
+
+#if (PICC_CRC16_ENGINE != PICC_CRC16_ENGINE_NIBBLE) && (PICC_CRC16_ENGINE != PICC_CRC16_ENGINE_TABLE) && \
+    (PICC_CRC16_ENGINE != PICC_CRC16_ENGINE_SLICE4) && (PICC_CRC16_ENGINE != PICC_CRC16_ENGINE_SLICE8)
+#error "PICC_CRC16_ENGINE: unsupported CRC16 engine"
+#endif
+
+/*==================================================================================================
+ *                                         Frame Counter Tracking
+ *==================================================================================================*/
+
+/** Frame counters tracked behind the newest one (duplicate / late frame detection) */
+#define PICC_FRAME_SEQ_WINDOW    (32U)
+
+/**
+ * @brief Received frame counter classification @see PICC_FrameSeqTrack
+ */
+typedef enum {
+    PICC_FRAME_SEQ_FIRST = 0,    /**< First frame: tracking baseline */
+    PICC_FRAME_SEQ_NEXT,         /**< Newer frame, none missing in between */
+    PICC_FRAME_SEQ_GAP,          /**< Newer frame, frames missing in between */
+    PICC_FRAME_SEQ_DUPLICATE,    /**< Counter already received */
+    PICC_FRAME_SEQ_LATE,         /**< Older frame filling an earlier gap */
+    PICC_FRAME_SEQ_RESYNC        /**< Far behind newest frame (remote restart): tracking restarted */
+} PICC_FrameSeqResult_e;
+
+/**
+ * @brief Received frame counter tracking state
+ *
+ * Counters follow the Tx counter scheme of the remote: +1 per frame,
+ * 0 skipped on wrap.
+ */
+typedef struct {
+    uint16  counter;        /**< Newest counter */
+    boolean synced;         /**< counter valid (first frame received) */
+    uint32  seenMask;       /**< Bit n: counter-1-n received */
+} PICC_FrameSeq_t;
+
 /*==================================================================================================
  *                                         Function Declarations
  *==================================================================================================*/
@@ -195,6 +243,18 @@ uint16 PICC_CalculateCRC16(const uint8 *data, uint32 len, boolean isFirst, uint1
  */
 uint16 PICC_CRC16(const uint8 *data, uint32 len);
 
+/**
+ * @brief Pack protocol header only (payload is placed after it by the caller)
+ * 
+ * @param[out] outBuf       Output buffer
+ * @param[in]  outBufSize   Output buffer size
+ * @param[in]  header       Protocol header
+ * @param[in]  payloadLen   Payload length (Length field)
+ * @return PICC_HEADER_SIZE, returns 0 on failure
+ */
+uint32 PICC_PackHeader(uint8 *outBuf, uint32 outBufSize,
+                       const PICC_MsgHeader_t *header, uint16 payloadLen);
+
 /**
  * @brief Pack protocol message
  * 
@@ -233,6 +293,19 @@ uint16 PICC_BeToCpu16(uint16 value);
  */
 uint16 PICC_CpuToBe16(uint16 value);
 
+/**
+ * @brief Classify received frame counter and update tracking state
+ *
+ * Distances skip counter 0 only where a step actually crosses the wrap:
+ * forward when the new counter is below the newest, backward when it is above.
+ *
+ * @param[in,out] seq     Tracking state (zero-initialized before the first frame)
+ * @param[in]     counter Received frame counter
+ * @param[out]    missing Frames missing before a GAP frame (can be NULL)
+ * @return Classification @see PICC_FrameSeqResult_e
+ */
+PICC_FrameSeqResult_e PICC_FrameSeqTrack(PICC_FrameSeq_t *seq, uint16 counter, uint16 *missing);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -73,6 +73,9 @@ extern "C" {
 /** Power control command notification acknowledgement Method ID */
 #define PWR_METHOD_CTRL_ACK         (11U)
 
+/** Maximum Method payload length kept for the application layer (longer rejected) */
+#define PWR_MAX_PAYLOAD_LEN         (8U)
+
 /*==================================================================================================
  *                                         Enum Types - Payload Values
  *==================================================================================================*/
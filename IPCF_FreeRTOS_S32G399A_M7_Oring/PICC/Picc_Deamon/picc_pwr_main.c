@@ -10,6 +10,8 @@
  * - Power control command acknowledgement handling (Method ID=11)
  * - Two-phase shutdown state machine
  *
+ * Payloads are encoded/decoded by codecs generated from picc_pwr_svc.h.
+ *
  * Copyright 2024 NXP
  * All Rights Reserved.
  */
@@ -19,7 +21,8 @@ extern "C" {
 #endif
 
 #include "picc_pwr_main.h"
-#include "picc_service.h"   /* For PICC_RegisterMethodHandler, PICC_SendEvent */
+#include "picc_service.h"   /* For PICC_HANDLER_FLAG_DIRECT */
+#include "picc_stack.h"     /* For PICC_StackSetLane */
 #include "Picc_main.h"           /* For HANDLE_ERROR */
 #include "ipcf_Ip_Cfg_Defines.h"  /* For IPCF_INSTANCE0 */
 
@@ -41,9 +44,7 @@ static volatile boolean g_stateAckReceived = FALSE;    /**< Method ID=2 received
 static volatile boolean g_phase1DoneReceived = FALSE;  /**< Method ID=8 received */
 static volatile boolean g_ctrlAckReceived = FALSE;     /**< Method ID=11 received */
 
-/** Payload data storage for application layer access */
-#define PWR_MAX_PAYLOAD_LEN  (8U)  /**< Maximum payload length to store */
-
+/** Payload data storage for application layer access (wire format) */
 typedef struct {
     uint8  data[PWR_MAX_PAYLOAD_LEN];  /**< Payload data */
     uint16 len;                         /**< Actual payload length */
@@ -53,107 +54,112 @@ static Pwr_PayloadData_t g_stateAckPayload = {0};   /**< Method ID=2 payload */
 static Pwr_PayloadData_t g_phase1DonePayload = {0}; /**< Method ID=8 payload */
 static Pwr_PayloadData_t g_ctrlAckPayload = {0};    /**< Method ID=11 payload */
 
+/*==================================================================================================
+ *                                         Generated Codecs
+ *
+ * Pwr_<Msg>_Encode/Decode, Event send stubs and Pwr_ServiceDispatch from the
+ * service description in picc_pwr_svc.h.
+ *==================================================================================================*/
+
+PICC_CODEC_DEFINE_SERVICE(Pwr)
+
 /*==================================================================================================
  *                                         Application Layer Callback Handlers
  *
- * These functions are called when M-Core receives Method requests from A-Core.
+ * These functions are called with the decoded request when M-Core receives
+ * Method requests from A-Core (payloads shorter than the fixed fields are
+ * answered PICC_RET_NOT_OK by the dispatcher, longer ones are truncated to
+ * PWR_MAX_PAYLOAD_LEN and still handled).
  * Application layer can add custom logic in these functions.
  *==================================================================================================*/
 
 /**
  * @brief Power state acknowledgement handler (Method ID=2)
  */
- void Pwr_InternalStateAckHandler(const uint8 *payload, uint16 payloadLen)
+uint8 Pwr_StateAck_Handle(uint8 consumerId, const Pwr_StateAck_t *req)
 {
-    uint8 coreId;
-    uint16 copyLen;
-    uint16 i;
-    
-    if ((payload == NULL) || (payloadLen < 2U)) {
-        return;
-    }
-    
-    coreId = payload[0];
-    
-    if (coreId != PWR_CORE_A) {
-        return;
-    }
-    
-    /* Save payload for application layer */
-    copyLen = (payloadLen > PWR_MAX_PAYLOAD_LEN) ? PWR_MAX_PAYLOAD_LEN : payloadLen;
-    for (i = 0U; i < copyLen; i++) {
-        g_stateAckPayload.data[i] = payload[i];
+    sint32 len;
+
+    (void)consumerId;
+
+    if (req->coreId != PWR_CORE_A) {
+        return (uint8)PICC_RET_OK;
     }
-    g_stateAckPayload.len = payloadLen;
-    
+
+    /* Save payload for application layer (first PWR_MAX_PAYLOAD_LEN bytes, received length) */
+    len = Pwr_StateAck_Encode(req, g_stateAckPayload.data, (uint16)PWR_MAX_PAYLOAD_LEN);
+    g_stateAckPayload.len = (len > 0) ? (uint16)(Pwr_StateAck_MIN_SIZE + req->infoWireLen) : 0U;
+
     /* Note: State machine transition is controlled by PWSM (pwsm.c) */
     /* This handler only sets the flag, PWSM polls it and controls the flow */
-    
+
     /* Set flag to notify PWSM application layer */
     g_stateAckReceived = TRUE;
+
+    return (uint8)PICC_RET_OK;
 }
 
 /**
- * @brief Power event completion handler (Method ID=8)
+ * @brief Power state acknowledgement handler (Method ID=2), raw payload
  */
-static void Pwr_InternalDoneHandler(const uint8 *payload, uint16 payloadLen)
+void Pwr_InternalStateAckHandler(const uint8 *payload, uint16 payloadLen)
 {
-    Power_DoneType_e doneType;
-    uint16 copyLen;
-    
-    if ((payload == NULL) || (payloadLen < 1U)) {
-        return;
+    Pwr_StateAck_t req;
+
+    if (Pwr_StateAck_Decode(&req, payload, payloadLen) >= 0) {
+        (void)Pwr_StateAck_Handle(PWR_CONSUMER_ID, &req);
     }
-    
-    doneType = (Power_DoneType_e)payload[0];
-    
-    if (doneType == PWR_DONE_FIRST_STEP) {
+}
+
+/**
+ * @brief Power event completion handler (Method ID=8)
+ */
+uint8 Pwr_EventDone_Handle(uint8 consumerId, const Pwr_EventDone_t *req)
+{
+    sint32 len;
+
+    (void)consumerId;
+
+    if (req->doneType == (uint8)PWR_DONE_FIRST_STEP) {
         /* A-Core phase 1 shutdown complete */
         /* Note: State machine transition is controlled by PWSM (pwsm.c) */
         /* This handler only sets the flag, PWSM polls it and controls Event ID=4 sending */
-        
-        /* Save payload for application layer */
-        copyLen = (payloadLen > PWR_MAX_PAYLOAD_LEN) ? PWR_MAX_PAYLOAD_LEN : payloadLen;
-        for (uint16 i = 0U; i < copyLen; i++) {
-            g_phase1DonePayload.data[i] = payload[i];
-        }
-        g_phase1DonePayload.len = payloadLen;
-        
+
+        /* Save payload for application layer (first PWR_MAX_PAYLOAD_LEN bytes, received length) */
+        len = Pwr_EventDone_Encode(req, g_phase1DonePayload.data, (uint16)PWR_MAX_PAYLOAD_LEN);
+        g_phase1DonePayload.len = (len > 0) ? (uint16)(Pwr_EventDone_MIN_SIZE + req->infoWireLen) : 0U;
+
         /* Set flag to notify PWSM application layer */
         g_phase1DoneReceived = TRUE;
     }
+
+    return (uint8)PICC_RET_OK;
 }
 
 /**
  * @brief Power control command acknowledgement handler (Method ID=11)
  */
-static void Pwr_InternalCtrlAckHandler(const uint8 *payload, uint16 payloadLen)
+uint8 Pwr_CtrlAck_Handle(uint8 consumerId, const Pwr_CtrlAck_t *req)
 {
-    uint8 coreId;
-    uint16 copyLen;
-    
-    if ((payload == NULL) || (payloadLen < 2U)) {
-        return;
-    }
-    
-    coreId = payload[0];
-    
-    if (coreId != PWR_CORE_A) {
-        return;
-    }
-    
-    /* Save payload for application layer */
-    copyLen = (payloadLen > PWR_MAX_PAYLOAD_LEN) ? PWR_MAX_PAYLOAD_LEN : payloadLen;
-    for (uint16 i = 0U; i < copyLen; i++) {
-        g_ctrlAckPayload.data[i] = payload[i];
+    sint32 len;
+
+    (void)consumerId;
+
+    if (req->coreId != PWR_CORE_A) {
+        return (uint8)PICC_RET_OK;
     }
-    g_ctrlAckPayload.len = payloadLen;
-    
+
+    /* Save payload for application layer (first PWR_MAX_PAYLOAD_LEN bytes, received length) */
+    len = Pwr_CtrlAck_Encode(req, g_ctrlAckPayload.data, (uint16)PWR_MAX_PAYLOAD_LEN);
+    g_ctrlAckPayload.len = (len > 0) ? (uint16)(Pwr_CtrlAck_MIN_SIZE + req->infoWireLen) : 0U;
+
     /* Note: State machine transition is controlled by PWSM (pwsm.c) */
     /* This handler only sets the flag, PWSM polls it and controls the flow */
-    
+
     /* Set flag to notify PWSM application layer */
     g_ctrlAckReceived = TRUE;
+
+    return (uint8)PICC_RET_OK;
 }
 
 /*==================================================================================================
@@ -168,13 +174,18 @@ sint8 Pwr_Init(void)
     sint8 ret = 0;
     
     if (PWR_SERVICE_ROLE == PICC_ROLE_SERVER) {
-        /* Server role: Receive and handle A-Core Method requests */
-        ret = PICC_RegisterMethodHandler(PWR_PROVIDER_ID, Pwr_MethodHandler);
+        /* Server role: Receive and handle A-Core Method requests
+         * Handlers only copy payload and set PWSM flags: lightweight */
+        ret = Pwr_ServiceRegister(PICC_HANDLER_FLAG_DIRECT);
         if (ret != 0) {
             return ret;
         }
     }
     
+    /* Power state notification / control command must not wait behind bulk traffic */
+    (void)PICC_StackSetLane(PWR_PROVIDER_ID, PWR_EVENT_STATE_NOTIFY, PICC_STACK_LANE_HIGH);
+    (void)PICC_StackSetLane(PWR_PROVIDER_ID, PWR_EVENT_CTRL_CMD, PICC_STACK_LANE_HIGH);
+
     g_stateMachine = PWR_SM_IDLE;
     g_pwrInitialized = TRUE;
 
@@ -197,20 +208,7 @@ uint8 Pwr_MethodHandler(uint8 consumerId, uint8 methodId,
                         const uint8 *reqData, uint16 reqLen,
                         uint8 *rspData, uint16 *rspLen)
 {
-    (void)consumerId;
-    (void)rspData;
-
-    *rspLen = 0U;  /* Default no response data */
-
-    if (methodId == PWR_METHOD_STATE_ACK) {
-        Pwr_InternalStateAckHandler(reqData, reqLen);
-    } else if (methodId == PWR_METHOD_EVENT_DONE) {
-        Pwr_InternalDoneHandler(reqData, reqLen);
-    } else if (methodId == PWR_METHOD_CTRL_ACK) {
-        Pwr_InternalCtrlAckHandler(reqData, reqLen);
-    }
-
-    return (uint8)PICC_RET_OK;
+    return Pwr_ServiceDispatch(consumerId, methodId, reqData, reqLen, rspData, rspLen);
 }
 
 /**
@@ -218,21 +216,18 @@ uint8 Pwr_MethodHandler(uint8 consumerId, uint8 methodId,
  */
 sint8 Pwr_SendStateNotify(Power_State_e state)
 {
-    uint8 payload[1];
+    Pwr_StateNotify_t msg;
 
     if (g_pwrInitialized == FALSE) {
         HANDLE_ERROR(-1);
         return -1;
     }
 
-    payload[0] = (uint8)state;
+    msg.state = (uint8)state;
 
-    return PICC_SendEvent(PWR_PROVIDER_ID,
-                          PWR_EVENT_STATE_NOTIFY,
-                          PWR_CONSUMER_ID,
-                          payload, 1U,
-                          PICC_EVENT_WITH_ACK,
-                          g_piccConfig.channelId);
+    return Pwr_StateNotify_Send(&msg, PWR_CONSUMER_ID,
+                                PICC_EVENT_WITH_ACK,
+                                g_piccConfig.channelId);
 }
 
 /**
@@ -240,22 +235,19 @@ sint8 Pwr_SendStateNotify(Power_State_e state)
  */
 sint8 Pwr_SendCtrlCmd(Power_Cmd_e cmd)
 {
-    uint8 payload[2];
+    Pwr_CtrlCmd_t msg;
 
     if (g_pwrInitialized == FALSE) {
         HANDLE_ERROR(-1);
         return -1;
     }
 
-    payload[0] = PWR_CORE_A;
-    payload[1] = (uint8)cmd;
+    msg.coreId = PWR_CORE_A;
+    msg.cmd    = (uint8)cmd;
 
-    return PICC_SendEvent(PWR_PROVIDER_ID,
-                          PWR_EVENT_CTRL_CMD,
-                          PWR_CONSUMER_ID,
-                          payload, 2U,
-                          PICC_EVENT_WITH_ACK,
-                          g_piccConfig.channelId);
+    return Pwr_CtrlCmd_Send(&msg, PWR_CONSUMER_ID,
+                            PICC_EVENT_WITH_ACK,
+                            g_piccConfig.channelId);
 }
 
 /**
@@ -21,6 +21,7 @@ extern "C" {
 #endif
 
 #include "picc_pwr_cnf.h"
+#include "picc_pwr_svc.h"
 #include "picc_api.h"
 
 /*==================================================================================================
@@ -46,7 +47,8 @@ void Pwr_Deinit(void);
 /**
  * @brief Method request handler (M-Core as Server handles A-Core requests)
  * 
- * Called automatically by PICC, no manual registration needed.
+ * Forwards to the generated Pwr_ServiceDispatch() (registered by Pwr_Init),
+ * which decodes the request and calls Pwr_<Msg>_Handle().
  */
 uint8 Pwr_MethodHandler(uint8 consumerId, uint8 methodId,
                         const uint8 *reqData, uint16 reqLen,
@@ -0,0 +1,71 @@
+/**
+ * @file picc_pwr_svc.h
+ * @brief Power Management Module - Service Description
+ *
+ * Payload layout of every power management message, expanded by
+ * picc_codec.h into Pwr_<Msg>_t, Pwr_<Msg>_Encode/Decode(),
+ * Pwr_<Msg>_Send() (Events) and Pwr_ServiceDispatch() (Methods).
+ * Codecs are defined in picc_pwr_main.c.
+ *
+ * Copyright 2024 NXP
+ * All Rights Reserved.
+ */
+
+#ifndef PICC_PWR_SVC_H
+#define PICC_PWR_SVC_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "picc_pwr_cnf.h"
+#include "picc_codec.h"
+
+/*==================================================================================================
+ *                                         Service Description
+ *==================================================================================================*/
+
+/** Provider ID of generated Event sends and Method registration */
+#define Pwr_PROVIDER_ID             PWR_PROVIDER_ID
+
+/** Messages: X(Service, Name, EVENT | METHOD, ID) */
+#define Pwr_MESSAGES(X) \
+    X(Pwr, StateNotify, EVENT,  PWR_EVENT_STATE_NOTIFY) \
+    X(Pwr, CtrlCmd,     EVENT,  PWR_EVENT_CTRL_CMD)     \
+    X(Pwr, StateAck,    METHOD, PWR_METHOD_STATE_ACK)   \
+    X(Pwr, EventDone,   METHOD, PWR_METHOD_EVENT_DONE)  \
+    X(Pwr, CtrlAck,     METHOD, PWR_METHOD_CTRL_ACK)
+
+/** Event ID=1: [State 1B] */
+#define Pwr_StateNotify_FIELDS(U8, U16, U32, ARR, VAR, TAIL) \
+    U8(state)
+
+/** Event ID=4: [CoreID 1B][Cmd 1B] */
+#define Pwr_CtrlCmd_FIELDS(U8, U16, U32, ARR, VAR, TAIL) \
+    U8(coreId) \
+    U8(cmd)
+
+/** Method ID=2: [CoreID 1B][State 1B][Info] */
+#define Pwr_StateAck_FIELDS(U8, U16, U32, ARR, VAR, TAIL) \
+    U8(coreId) \
+    U8(state)  \
+    TAIL(info, PWR_MAX_PAYLOAD_LEN - 2U)
+
+/** Method ID=8: [DoneType 1B][Info] */
+#define Pwr_EventDone_FIELDS(U8, U16, U32, ARR, VAR, TAIL) \
+    U8(doneType) \
+    TAIL(info, PWR_MAX_PAYLOAD_LEN - 1U)
+
+/** Method ID=11: [CoreID 1B][Cmd 1B][Info] */
+#define Pwr_CtrlAck_FIELDS(U8, U16, U32, ARR, VAR, TAIL) \
+    U8(coreId) \
+    U8(cmd)    \
+    TAIL(info, PWR_MAX_PAYLOAD_LEN - 2U)
+
+PICC_CODEC_DECLARE_SERVICE(Pwr)
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* PICC_PWR_SVC_H */
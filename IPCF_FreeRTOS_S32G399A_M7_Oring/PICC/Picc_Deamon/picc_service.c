@@ -3,7 +3,16 @@
  * @brief M-Core Inter-Core Communication Service Layer - Implementation
  *
  * Implements Event and Method service processing, including auto ACK reply (middleware layer).
- * Supports multi-module registration, routing messages to corresponding modules by ProviderID.
+ * Supports multi-module registration, routing messages to corresponding modules by ProviderID
+ * (provider-wide handlers) or by ProviderID + MethodID/EventID (per-ID handlers).
+ * Dispatch uses index tables built at registration, no registry search on the Rx path.
+ * Outstanding Method requests are tracked by (ProviderID, MethodID, SessionID) with
+ * completion callbacks, timeouts/retries (10ms periodic task) and RTT statistics.
+ * Payloads above PICC_FRAG_THRESHOLD are sent and received through picc_frag.
+ * Method requests of services assigned to a worker are queued per service (request data
+ * copied to the scratch arena) and handled and answered by PICC_ServiceWorkerTask.
+ * Request pipes track a window of outstanding requests per (ProviderID, MethodID) in a ring,
+ * optionally holding early completions back for in-order delivery.
  *
  * Copyright 2024 NXP
  * All Rights Reserved.
@@ -16,18 +25,35 @@ extern "C" {
 #include "picc_service.h"
 #include "picc_link.h"
 #include "picc_stack.h"
+#include "picc_frag.h"
+#include "picc_arena.h"
 #include "Picc_main.h"    /* For HANDLE_ERROR */
 #include "ipc-shm.h"
 #include "FreeRTOS.h"
 #include "task.h"
+#include "queue.h"
 
 /*==================================================================================================
  *                                         Private Types
  *==================================================================================================*/
 
+/** Number of ProviderID / MethodID values */
+#define PICC_SERVICE_ID_NUM         (256U)
+
+/** Index table entry: no handler */
+#define PICC_SERVICE_NO_HANDLER     (0xFFU)
+
+/** Pipe entry states */
+#define PICC_PIPE_ENTRY_WAITING     (0U)    /**< Request outstanding */
+#define PICC_PIPE_ENTRY_DONE        (1U)    /**< Completed, held for in-order delivery */
+#define PICC_PIPE_ENTRY_DELIVERED   (2U)    /**< Delivered (or not sent), slot freed when at head */
+
 /** Event handler registration entry */
 typedef struct {
     uint8                 providerId;   /**< Target ProviderID */
+    uint8                 eventId;      /**< EventID or PICC_SERVICE_ANY_ID */
+    uint8                 next;         /**< Next handler of same key, PICC_SERVICE_NO_HANDLER if last */
+    uint8                 flags;        /**< PICC_HANDLER_FLAG_xxx */
     PICC_EventCallback_t  callback;     /**< Callback function */
     boolean               isUsed;       /**< Is slot in use */
 } PICC_EventHandler_t;
@@ -35,10 +61,92 @@ typedef struct {
 /** Method handler registration entry */
 typedef struct {
     uint8                  localProviderId;  /**< Local module's ProviderID */
+    uint8                  methodId;         /**< MethodID or PICC_SERVICE_ANY_ID */
+    uint8                  flags;            /**< PICC_HANDLER_FLAG_xxx */
+    uint16                 rspMax;           /**< Response buffer size (largest response of the handler) */
     PICC_MethodCallback_t  callback;         /**< Callback function */
     boolean                isUsed;           /**< Is slot in use */
 } PICC_MethodHandler_t;
 
+/**
+ * @brief Handler index (one per handler kind)
+ * 
+ * Maps (ProviderID, ID) to the registry slot of its first handler:
+ * idHead[idTable[providerId]][id] for per-ID handlers, providerHead[providerId]
+ * for provider-wide ones. ID tables are only allocated for providers that
+ * register per-ID handlers.
+ */
+typedef struct {
+    uint8 providerHead[PICC_SERVICE_ID_NUM];                    /**< Provider-wide handler per ProviderID */
+    uint8 idTable[PICC_SERVICE_ID_NUM];                         /**< ID table per ProviderID */
+    uint8 idHead[PICC_MAX_ID_TABLES][PICC_SERVICE_ID_NUM];      /**< Per-ID handler per ID table */
+    uint8 tablesUsed;                                           /**< Allocated ID tables */
+} PICC_ServiceIndex_t;
+
+/** Outstanding request entry */
+typedef struct {
+    uint8                   providerId;     /**< Service provider ID */
+    uint8                   methodId;       /**< Method ID */
+    uint8                   sessionId;      /**< Session ID */
+    uint8                   msgType;        /**< Request message type */
+    uint8                   channelId;      /**< IPCF channel ID */
+    uint8                   retriesLeft;    /**< Retransmissions left */
+    uint16                  dataLen;        /**< Request data length */
+    uint8                   data[PICC_REQUEST_RETRY_DATA_SIZE]; /**< Request data (for retries) */
+    boolean                 canRetry;       /**< Request data kept */
+    uint32                  sendTick;       /**< Tick of last (re)transmission */
+    uint32                  timeoutTicks;   /**< Timeout per attempt (ticks) */
+    PICC_RequestCallback_t  callback;       /**< Completion callback */
+    void                   *cbArg;          /**< Completion callback argument */
+    uint8                   cbFlags;        /**< Completion callback flags */
+    boolean                 isUsed;         /**< Is slot in use */
+} PICC_PendingRequest_t;
+
+/** Queued Method request */
+typedef struct {
+    PICC_MsgHeader_t        header;         /**< Request header */
+    uint8                  *payload;        /**< Request data copy (arena block), NULL if empty */
+    uint16                  len;            /**< Request data length */
+    uint8                   channelId;      /**< IPCF channel ID (for the Response) */
+    TickType_t              queueTick;      /**< Tick the request was queued */
+} PICC_ServiceJob_t;
+
+/** Request pipe entry (one outstanding request) */
+typedef struct {
+    uint8                   pipe;           /**< Pipe index */
+    uint8                   state;          /**< PICC_PIPE_ENTRY_xxx */
+    uint8                   sessionId;      /**< Session ID (set on completion) */
+    uint8                   returnCode;     /**< Held completion: return code */
+    PICC_RequestStatus_e    status;         /**< Held completion: status */
+    uint8                  *rspData;        /**< Held completion: response copy (arena block) */
+    uint16                  rspLen;         /**< Held completion: response length */
+} PICC_PipeEntry_t;
+
+/** Request pipe */
+typedef struct {
+    uint8                   providerId;     /**< Service provider ID */
+    uint8                   methodId;       /**< Method ID */
+    uint8                   instanceId;     /**< IPCF instance ID */
+    uint8                   channelId;      /**< IPCF channel ID */
+    PICC_PipeConfig_t       config;         /**< Configuration */
+    PICC_PipeEntry_t        entries[PICC_PIPE_MAX_WINDOW]; /**< Ring in request order */
+    uint8                   head;           /**< Oldest entry */
+    uint8                   count;          /**< Entries in ring (outstanding + held) */
+    uint8                   okCount;        /**< Completions since the limit last changed */
+    boolean                 delivering;     /**< A task is delivering held completions */
+    boolean                 isUsed;         /**< Is slot in use */
+    PICC_PipeStats_t        stats;          /**< Statistics (limit, serverLimit: current values) */
+} PICC_Pipe_t;
+
+/** Service handled by a worker */
+typedef struct {
+    QueueHandle_t               queue;      /**< Request queue (created on first use, kept for reuse) */
+    uint8                       providerId; /**< Local module's ProviderID */
+    uint8                       worker;     /**< Worker index */
+    boolean                     isUsed;     /**< Is slot in use */
+    PICC_ServiceWorkerStats_t   stats;      /**< Queue statistics */
+} PICC_WorkerService_t;
+
 /*==================================================================================================
  *                                         Private Variables
  *==================================================================================================*/
@@ -49,17 +157,41 @@ static PICC_EventHandler_t g_eventHandlers[PICC_MAX_EVENT_HANDLERS];
 /** Method handler registry */
 static PICC_MethodHandler_t g_methodHandlers[PICC_MAX_METHOD_HANDLERS];
 
+/** Event handler index */
+static PICC_ServiceIndex_t g_eventIndex;
+
+/** Method handler index */
+static PICC_ServiceIndex_t g_methodIndex;
+
+/** Outstanding request table */
+static PICC_PendingRequest_t g_pendingRequests[PICC_MAX_PENDING_REQUESTS];
+
+/** Outstanding request slot per SessionID (session IDs are unique among outstanding requests) */
+static uint8 g_pendingBySession[PICC_SERVICE_ID_NUM];
+
+/** Outstanding request statistics */
+static PICC_RequestStats_t g_requestStats;
+
 /** Method response callback (Client role, only one needed) */
 static PICC_ResponseCallback_t g_responseCallback = NULL;
 
-/** Session ID counter */
-static uint8 g_sessionIdCounter = PICC_SESSION_ID_MIN;
+/** Method response callback flags */
+static uint8 g_responseFlags = PICC_HANDLER_FLAG_NONE;
+
+/** Services handled by workers */
+static PICC_WorkerService_t g_workerServices[PICC_MAX_WORKER_SERVICES];
+
+/** Worker service slot per ProviderID */
+static uint8 g_workerByProvider[PICC_SERVICE_ID_NUM];
+
+/** Request pipes */
+static PICC_Pipe_t g_pipes[PICC_MAX_PIPES];
 
-/** Response data buffer */
-static uint8 g_rspBuffer[PICC_MAX_PAYLOAD_SIZE];
+/** Worker task handles (NULL until PICC_ServiceWorkerTask runs) */
+static TaskHandle_t g_workerTasks[PICC_SERVICE_WORKER_NUM];
 
-/** TX buffer for message packing (static to avoid stack overflow with large payloads) */
-static uint8 g_txBuffer[PICC_HEADER_SIZE + PICC_MAX_PAYLOAD_SIZE];
+/** Session ID counter */
+static uint8 g_sessionIdCounter = PICC_SESSION_ID_MIN;
 
 /** Whether service layer is initialized */
 static boolean g_serviceInitialized = FALSE;
@@ -70,17 +202,112 @@ static boolean g_serviceInitialized = FALSE;
 
 /**
  * @brief Get next Session ID
+ * 
+ * Skips session IDs of outstanding requests so responses stay unambiguous.
  */
 static uint8 PICC_GetNextSessionId(void)
 {
-    uint8 id = g_sessionIdCounter;
-    g_sessionIdCounter++;
-    if (g_sessionIdCounter == 0U) {
-        g_sessionIdCounter = PICC_SESSION_ID_MIN;
+    uint8 id;
+    uint32 tries;
+
+    taskENTER_CRITICAL();
+    for (tries = 0U; tries < PICC_SERVICE_ID_NUM; tries++) {
+        id = g_sessionIdCounter;
+        g_sessionIdCounter++;
+        if (g_sessionIdCounter == 0U) {
+            g_sessionIdCounter = PICC_SESSION_ID_MIN;
+        }
+        if (g_pendingBySession[id] == PICC_SERVICE_NO_HANDLER) {
+            break;
+        }
     }
+    taskEXIT_CRITICAL();
+
     return id;
 }
 
+/**
+ * @brief Get request message type of a Method type
+ * 
+ * @return TRUE on success, FALSE if type is invalid
+ */
+static boolean PICC_ServiceRequestMsgType(PICC_MethodType_e type, uint8 *msgType)
+{
+    switch (type) {
+        case PICC_METHOD_WITH_RESPONSE:
+            *msgType = (uint8)PICC_MSG_REQUEST;
+            break;
+        case PICC_METHOD_NO_RETURN_WITH_ACK:
+            *msgType = (uint8)PICC_MSG_REQUEST_NO_RETURN_WITH_ACK;
+            break;
+        case PICC_METHOD_NO_RETURN_WITHOUT_ACK:
+            *msgType = (uint8)PICC_MSG_REQUEST_NO_RETURN_WITHOUT_ACK;
+            break;
+        default:
+            return FALSE;
+    }
+    return TRUE;
+}
+
+/**
+ * @brief Clear handler index
+ */
+static void PICC_ServiceIndexClear(PICC_ServiceIndex_t *index)
+{
+    uint32 i;
+    uint32 t;
+
+    for (i = 0U; i < PICC_SERVICE_ID_NUM; i++) {
+        index->providerHead[i] = PICC_SERVICE_NO_HANDLER;
+        index->idTable[i] = PICC_SERVICE_NO_HANDLER;
+        for (t = 0U; t < PICC_MAX_ID_TABLES; t++) {
+            index->idHead[t][i] = PICC_SERVICE_NO_HANDLER;
+        }
+    }
+    index->tablesUsed = 0U;
+}
+
+/**
+ * @brief Look up first handler of a received message (constant time)
+ * 
+ * Per-ID handler wins over provider-wide handler.
+ * 
+ * @return Registry slot, PICC_SERVICE_NO_HANDLER if none
+ */
+static uint8 PICC_ServiceIndexLookup(const PICC_ServiceIndex_t *index, uint8 providerId, uint8 id)
+{
+    uint8 table = index->idTable[providerId];
+
+    if ((table != PICC_SERVICE_NO_HANDLER) &&
+        (index->idHead[table][id] != PICC_SERVICE_NO_HANDLER)) {
+        return index->idHead[table][id];
+    }
+    return index->providerHead[providerId];
+}
+
+/**
+ * @brief Get index entry a handler of (ProviderID, ID) is linked from
+ * 
+ * Allocates the ID table of the provider on first per-ID registration.
+ * 
+ * @return Index entry, NULL if no ID table is free
+ */
+static uint8* PICC_ServiceIndexEntry(PICC_ServiceIndex_t *index, uint8 providerId, uint8 id)
+{
+    if (id == PICC_SERVICE_ANY_ID) {
+        return &index->providerHead[providerId];
+    }
+
+    if (index->idTable[providerId] == PICC_SERVICE_NO_HANDLER) {
+        if (index->tablesUsed >= PICC_MAX_ID_TABLES) {
+            return NULL;
+        }
+        index->idTable[providerId] = index->tablesUsed;
+        index->tablesUsed++;
+    }
+    return &index->idHead[index->idTable[providerId]][id];
+}
+
 /**
  * @brief Send ACK message (unified through Stack stacking)
  */
@@ -118,14 +345,16 @@ static sint8 PICC_ServiceSendAck(uint8 msgType, uint8 providerId, uint8 consumer
 /**
  * @brief Send message (unified through Stack stacking)
  * 
- * @note Uses static g_txBuffer to avoid stack overflow with large payloads.
- *       This function is NOT thread-safe - only call from single task context.
+ * Header is packed on the caller stack, header and payload are then copied
+ * straight into the stack window (no intermediate packing buffer, no
+ * critical section - safe to call from several tasks).
+ * Payloads above PICC_FRAG_THRESHOLD are handed to the fragmentation layer.
  */
 static sint8 PICC_ServiceSendMessage(const PICC_MsgHeader_t *header,
                                      const uint8 *payload, uint16 payloadLen,
                                      uint8 channelId)
 {
-    uint32 packedLen;
+    uint8 hdrBuf[PICC_HEADER_SIZE];
     sint8 ret;
     
     if (header == NULL) {
@@ -133,20 +362,20 @@ static sint8 PICC_ServiceSendMessage(const PICC_MsgHeader_t *header,
         return -1;
     }
     
-    /* [FIX] Enter critical section to protect g_txBuffer from concurrent access
-     * (Timer callback and Task may call this simultaneously) */
-    taskENTER_CRITICAL();
+    if (payloadLen > PICC_FRAG_THRESHOLD) {
+        ret = PICC_FragSend(header, payload, payloadLen, channelId);
+        if (ret != 0) {
+            HANDLE_ERROR(-15);  /* Service: Failed to add message to stack */
+        }
+        return ret;
+    }
     
-    packedLen = PICC_PackMessage(g_txBuffer, sizeof(g_txBuffer), header, payload, payloadLen);
-    if (packedLen == 0U) {
-        taskEXIT_CRITICAL();
+    if (PICC_PackHeader(hdrBuf, sizeof(hdrBuf), header, payloadLen) == 0U) {
         HANDLE_ERROR(-14);  /* Service: Failed to pack message */
         return -1;
     }
     
-    ret = PICC_StackAddMessageToChannel(channelId, g_txBuffer, packedLen);
-    
-    taskEXIT_CRITICAL();
+    ret = PICC_StackAddMessageParts(channelId, hdrBuf, payload, payloadLen);
     
     if (ret != 0) {
         HANDLE_ERROR(-15);  /* Service: Failed to add message to stack */
@@ -154,6 +383,123 @@ static sint8 PICC_ServiceSendMessage(const PICC_MsgHeader_t *header,
     return ret;
 }
 
+/**
+ * @brief Send Method request message with given session ID
+ */
+static sint8 PICC_ServiceSendRequest(uint8 providerId, uint8 methodId, uint8 sessionId,
+                                     uint8 msgType, const uint8 *data, uint16 len,
+                                     uint8 channelId)
+{
+    PICC_MsgHeader_t header;
+
+    header.providerId = providerId;
+    header.methodId   = methodId;
+    header.consumerId = 0U;  /* Set by caller at higher layer */
+    header.sessionId  = sessionId;
+    header.msgType    = msgType;
+    header.returnCode = (uint8)PICC_RET_OK;
+
+    return PICC_ServiceSendMessage(&header, data, len, channelId);
+}
+
+/**
+ * @brief Release outstanding request slot (in critical section)
+ */
+static void PICC_ServiceFreeRequest(uint8 slot)
+{
+    g_pendingBySession[g_pendingRequests[slot].sessionId] = PICC_SERVICE_NO_HANDLER;
+    g_pendingRequests[slot].isUsed = FALSE;
+    g_requestStats.inFlight--;
+}
+
+/**
+ * @brief Find outstanding request of (ProviderID, MethodID, SessionID) (in critical section)
+ * 
+ * @return Slot, PICC_SERVICE_NO_HANDLER if none
+ */
+static uint8 PICC_ServiceFindRequest(uint8 providerId, uint8 methodId, uint8 sessionId)
+{
+    uint8 slot = g_pendingBySession[sessionId];
+
+    if ((slot == PICC_SERVICE_NO_HANDLER) ||
+        (g_pendingRequests[slot].isUsed == FALSE) ||
+        (g_pendingRequests[slot].providerId != providerId) ||
+        (g_pendingRequests[slot].methodId != methodId)) {
+        return PICC_SERVICE_NO_HANDLER;
+    }
+    return slot;
+}
+
+/**
+ * @brief Complete outstanding request by received Response / ACK
+ * 
+ * @return TRUE if the message completed an outstanding request
+ */
+static boolean PICC_ServiceCompleteRequest(const PICC_MsgHeader_t *header,
+                                           const uint8 *payload, uint16 len)
+{
+    PICC_RequestCallback_t callback;
+    void *cbArg;
+    uint32 rtt;
+    uint8 expectedType;
+    uint8 slot;
+
+    expectedType = (header->msgType == (uint8)PICC_MSG_ACK) ?
+                   (uint8)PICC_MSG_REQUEST_NO_RETURN_WITH_ACK : (uint8)PICC_MSG_REQUEST;
+
+    taskENTER_CRITICAL();
+    slot = PICC_ServiceFindRequest(header->providerId, header->methodId, header->sessionId);
+    if ((slot == PICC_SERVICE_NO_HANDLER) || (g_pendingRequests[slot].msgType != expectedType)) {
+        g_requestStats.unmatched++;
+        taskEXIT_CRITICAL();
+        return FALSE;
+    }
+
+    rtt = (uint32)xTaskGetTickCount() - g_pendingRequests[slot].sendTick;
+    g_requestStats.completed++;
+    g_requestStats.totalRttTicks += rtt;
+    if (rtt < g_requestStats.minRttTicks) {
+        g_requestStats.minRttTicks = rtt;
+    }
+    if (rtt > g_requestStats.maxRttTicks) {
+        g_requestStats.maxRttTicks = rtt;
+    }
+
+    callback = g_pendingRequests[slot].callback;
+    cbArg = g_pendingRequests[slot].cbArg;
+    PICC_ServiceFreeRequest(slot);
+    taskEXIT_CRITICAL();
+
+    if (callback != NULL) {
+        callback(cbArg, PICC_REQUEST_COMPLETED, header->providerId, header->methodId,
+                 header->sessionId, header->returnCode, payload, len);
+    } else if ((g_responseCallback != NULL) && (header->msgType == (uint8)PICC_MSG_RESPONSE)) {
+        g_responseCallback(header->providerId, header->methodId, header->sessionId,
+                           header->returnCode, payload, len);
+    } else {
+        /* No one to notify */
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Clear outstanding request table and statistics
+ */
+static void PICC_ServiceRequestClear(void)
+{
+    uint32 i;
+
+    for (i = 0U; i < PICC_MAX_PENDING_REQUESTS; i++) {
+        g_pendingRequests[i].isUsed = FALSE;
+    }
+    for (i = 0U; i < PICC_SERVICE_ID_NUM; i++) {
+        g_pendingBySession[i] = PICC_SERVICE_NO_HANDLER;
+    }
+    g_requestStats.inFlight = 0U;
+    PICC_ServiceResetRequestStats();
+}
+
 /**
  * @brief Handle Event notification (route to registered handlers)
  */
@@ -161,7 +507,7 @@ static sint8 PICC_ServiceHandleEvent(const PICC_MsgHeader_t *header,
                                      const uint8 *payload, uint16 len,
                                      uint8 instanceId, uint8 channelId)
 {
-    uint32 i;
+    uint8 slot;
     
     /* If Event with ACK, auto reply EVENT_ACK */
     if (header->msgType == (uint8)PICC_MSG_NOTIFICATION_WITH_ACK) {
@@ -173,50 +519,56 @@ static sint8 PICC_ServiceHandleEvent(const PICC_MsgHeader_t *header,
                                   instanceId, channelId);
     }
 
-    /* Route to handler matching ProviderID */
-    for (i = 0U; i < PICC_MAX_EVENT_HANDLERS; i++) {
-        if (g_eventHandlers[i].isUsed && 
-            g_eventHandlers[i].providerId == header->providerId &&
-            g_eventHandlers[i].callback != NULL) {
-            g_eventHandlers[i].callback(header->providerId, header->methodId, payload, len);
-        }
+    /* Route to handlers of (ProviderID, EventID), else of ProviderID */
+    slot = PICC_ServiceIndexLookup(&g_eventIndex, header->providerId, header->methodId);
+    while (slot != PICC_SERVICE_NO_HANDLER) {
+        g_eventHandlers[slot].callback(header->providerId, header->methodId, payload, len);
+        slot = g_eventHandlers[slot].next;
     }
 
     return 0;
 }
 
 /**
- * @brief Handle Method request (route to registered handlers)
+ * @brief Run Method handler of a request and send its Response
+ * 
+ * @param header     Request header
+ * @param payload    Request data
+ * @param len        Request data length
+ * @param channelId  IPCF channel ID (for the Response)
  */
-static sint8 PICC_ServiceHandleRequest(const PICC_MsgHeader_t *header,
-                                       const uint8 *payload, uint16 len,
-                                       uint8 instanceId, uint8 channelId)
+static void PICC_ServiceRunMethod(const PICC_MsgHeader_t *header,
+                                  const uint8 *payload, uint16 len,
+                                  uint8 channelId)
 {
-    uint32 i;
+    uint8 slot;
     uint8 returnCode = (uint8)PICC_RET_OK;
     uint16 rspLen = 0U;
+    uint16 rspMax;
+    uint8 *rspBuf = NULL;
     PICC_MsgHeader_t rspHeader;
 
-    /* If REQUEST_NO_RETURN_WITH_ACK, auto reply ACK */
-    if (header->msgType == (uint8)PICC_MSG_REQUEST_NO_RETURN_WITH_ACK) {
-        (void)PICC_ServiceSendAck((uint8)PICC_MSG_ACK,
-                                  header->providerId,
-                                  header->consumerId,
-                                  header->methodId,
-                                  header->sessionId,
-                                  instanceId, channelId);
-    }
-
-    /* Route to handler matching ProviderID */
-    for (i = 0U; i < PICC_MAX_METHOD_HANDLERS; i++) {
-        if (g_methodHandlers[i].isUsed && 
-            g_methodHandlers[i].localProviderId == header->providerId &&
-            g_methodHandlers[i].callback != NULL) {
-            returnCode = g_methodHandlers[i].callback(header->consumerId,
-                                                      header->methodId,
-                                                      payload, len,
-                                                      g_rspBuffer, &rspLen);
-            break;  /* Only one handler matches */
+    /* Route to handler of (ProviderID, MethodID), else of ProviderID */
+    slot = PICC_ServiceIndexLookup(&g_methodIndex, header->providerId, header->methodId);
+    if (slot != PICC_SERVICE_NO_HANDLER) {
+        /* Response buffer of the declared size from scratch arena, held only
+         * while handling; none for a handler without response data */
+        rspMax = g_methodHandlers[slot].rspMax;
+        if (rspMax != 0U) {
+            rspBuf = (uint8 *)PICC_ArenaAlloc(rspMax, PICC_ARENA_OWNER_SERVICE);
+        }
+        if ((rspMax == 0U) || (rspBuf != NULL)) {
+            returnCode = g_methodHandlers[slot].callback(header->consumerId,
+                                                         header->methodId,
+                                                         payload, len,
+                                                         rspBuf, &rspLen);
+            if (rspLen > rspMax) {
+                HANDLE_ERROR(-51);  /* Service: Method response exceeds declared size */
+                rspLen = 0U;
+                returnCode = (uint8)PICC_RET_NOT_OK;
+            }
+        } else {
+            returnCode = (uint8)PICC_RET_NOT_READY;
         }
     }
 
@@ -229,261 +581,1406 @@ static sint8 PICC_ServiceHandleRequest(const PICC_MsgHeader_t *header,
         rspHeader.msgType    = (uint8)PICC_MSG_RESPONSE;
         rspHeader.returnCode = returnCode;
 
-        (void)PICC_ServiceSendMessage(&rspHeader, g_rspBuffer, rspLen, channelId);
+        (void)PICC_ServiceSendMessage(&rspHeader, rspBuf, rspLen, channelId);
     }
 
-    return 0;
+    PICC_ArenaFree(rspBuf);
 }
 
 /**
- * @brief Handle Method response (Client role)
+ * @brief Answer a request PICC_RET_NOT_READY without running its handler
  */
-static sint8 PICC_ServiceHandleResponse(const PICC_MsgHeader_t *header,
-                                        const uint8 *payload, uint16 len)
+static void PICC_ServiceRejectRequest(const PICC_MsgHeader_t *header, uint8 channelId)
 {
-    if (g_responseCallback != NULL) {
-        g_responseCallback(header->providerId,
-                          header->methodId,
-                          header->sessionId,
-                          header->returnCode,
-                          payload, len);
+    PICC_MsgHeader_t rspHeader;
+
+    if (header->msgType == (uint8)PICC_MSG_REQUEST) {
+        rspHeader.providerId = header->providerId;
+        rspHeader.methodId   = header->methodId;
+        rspHeader.consumerId = header->consumerId;
+        rspHeader.sessionId  = header->sessionId;
+        rspHeader.msgType    = (uint8)PICC_MSG_RESPONSE;
+        rspHeader.returnCode = (uint8)PICC_RET_NOT_READY;
+
+        (void)PICC_ServiceSendMessage(&rspHeader, NULL, 0U, channelId);
     }
-    return 0;
 }
 
-/*==================================================================================================
- *                                         Public Functions - Initialization
- *==================================================================================================*/
-
 /**
- * @brief Initialize service layer (called by PICC_Init)
+ * @brief Queue Method request to the worker of its service
+ * 
+ * @param svc        Worker service slot
+ * @param header     Request header
+ * @param payload    Request data
+ * @param len        Request data length
+ * @param channelId  IPCF channel ID
+ * @return 0 if queued, -1 if the worker task is not running, -2 if the
+ *         queue is full or no memory is left for the request data
  */
-void PICC_ServiceLayerInit(void)
+static sint8 PICC_ServiceQueueRequest(uint8 svc, const PICC_MsgHeader_t *header,
+                                      const uint8 *payload, uint16 len,
+                                      uint8 channelId)
 {
+    PICC_WorkerService_t *ws = &g_workerServices[svc];
+    PICC_ServiceJob_t job;
+    UBaseType_t depth;
     uint32 i;
-    
-    /* Clear registry */
-    for (i = 0U; i < PICC_MAX_EVENT_HANDLERS; i++) {
-        g_eventHandlers[i].isUsed = FALSE;
-        g_eventHandlers[i].callback = NULL;
+
+    if (g_workerTasks[ws->worker] == NULL) {
+        return -1;
     }
-    
-    for (i = 0U; i < PICC_MAX_METHOD_HANDLERS; i++) {
-        g_methodHandlers[i].isUsed = FALSE;
-        g_methodHandlers[i].callback = NULL;
+
+    job.header    = *header;
+    job.payload   = NULL;
+    job.len       = len;
+    job.channelId = channelId;
+    job.queueTick = xTaskGetTickCount();
+
+    /* Request data lives in the Rx buffer, released before the worker runs */
+    if (len != 0U) {
+        job.payload = (uint8 *)PICC_ArenaAlloc(len, PICC_ARENA_OWNER_SERVICE);
+        if (job.payload != NULL) {
+            for (i = 0U; i < len; i++) {
+                job.payload[i] = payload[i];
+            }
+        }
     }
-    
-    g_responseCallback = NULL;
-    g_sessionIdCounter = PICC_SESSION_ID_MIN;
-    g_serviceInitialized = TRUE;
+
+    if (((len != 0U) && (job.payload == NULL)) ||
+        (xQueueSend(ws->queue, &job, 0U) != pdPASS)) {
+        PICC_ArenaFree(job.payload);
+        taskENTER_CRITICAL();
+        ws->stats.rejected++;
+        taskEXIT_CRITICAL();
+        return -2;
+    }
+
+    depth = uxQueueMessagesWaiting(ws->queue);
+    taskENTER_CRITICAL();
+    ws->stats.queued++;
+    ws->stats.depth = (uint16)depth;
+    if (ws->stats.depth > ws->stats.maxDepth) {
+        ws->stats.maxDepth = ws->stats.depth;
+    }
+    taskEXIT_CRITICAL();
+
+    (void)xTaskNotifyGive(g_workerTasks[ws->worker]);
+    return 0;
 }
 
 /**
- * @brief Deinitialize service layer
+ * @brief Handle a queued request on the worker task
  */
-void PICC_ServiceLayerDeinit(void)
+static void PICC_ServiceRunJob(PICC_WorkerService_t *ws, PICC_ServiceJob_t *job)
 {
-    uint32 i;
-    
-    for (i = 0U; i < PICC_MAX_EVENT_HANDLERS; i++) {
-        g_eventHandlers[i].isUsed = FALSE;
+    TickType_t start;
+    uint32 wait;
+    uint32 run;
+
+    start = xTaskGetTickCount();
+    wait = (uint32)(start - job->queueTick);
+
+    /* Dropped by PICC_ServiceLayerDeinit meanwhile: no handler, no Response */
+    if (g_serviceInitialized != FALSE) {
+        PICC_ServiceRunMethod(&job->header, job->payload, job->len, job->channelId);
     }
-    
-    for (i = 0U; i < PICC_MAX_METHOD_HANDLERS; i++) {
-        g_methodHandlers[i].isUsed = FALSE;
+    PICC_ArenaFree(job->payload);
+
+    run = (uint32)(xTaskGetTickCount() - start);
+
+    taskENTER_CRITICAL();
+    ws->stats.processed++;
+    ws->stats.depth = (uint16)uxQueueMessagesWaiting(ws->queue);
+    ws->stats.totalWaitTicks += wait;
+    if (wait > ws->stats.maxWaitTicks) {
+        ws->stats.maxWaitTicks = wait;
     }
-    
-    g_responseCallback = NULL;
-    g_serviceInitialized = FALSE;
+    ws->stats.totalRunTicks += run;
+    if (run > ws->stats.maxRunTicks) {
+        ws->stats.maxRunTicks = run;
+    }
+    taskEXIT_CRITICAL();
 }
 
-/*==================================================================================================
- *                                         Public Functions - Handler Registration
- *==================================================================================================*/
-
 /**
- * @brief Register Event receive handler
+ * @brief Drop queued requests of all worker services (no Response sent)
  */
-sint8 PICC_RegisterEventHandler(uint8 providerId, PICC_EventCallback_t callback)
+static void PICC_ServiceWorkerClear(void)
 {
+    PICC_ServiceJob_t job;
     uint32 i;
-    
-    if (callback == NULL) {
-        HANDLE_ERROR(-16);  /* Service: Event handler callback is NULL */
-        return -1;
-    }
-    
-    /* Find free slot */
-    for (i = 0U; i < PICC_MAX_EVENT_HANDLERS; i++) {
-        if (g_eventHandlers[i].isUsed == FALSE) {
-            g_eventHandlers[i].providerId = providerId;
-            g_eventHandlers[i].callback = callback;
-            g_eventHandlers[i].isUsed = TRUE;
-            return 0;
+
+    for (i = 0U; i < PICC_MAX_WORKER_SERVICES; i++) {
+        g_workerServices[i].isUsed = FALSE;
+        if (g_workerServices[i].queue != NULL) {
+            while (xQueueReceive(g_workerServices[i].queue, &job, 0U) == pdPASS) {
+                PICC_ArenaFree(job.payload);
+            }
         }
     }
-    
-    HANDLE_ERROR(-17);  /* Service: Event handler registry full */
-    return -2;  /* Registry full */
+    for (i = 0U; i < PICC_SERVICE_ID_NUM; i++) {
+        g_workerByProvider[i] = PICC_SERVICE_NO_HANDLER;
+    }
 }
 
 /**
- * @brief Register Method request handler
+ * @brief Handle Method request (route to registered handlers)
+ */
+static sint8 PICC_ServiceHandleRequest(const PICC_MsgHeader_t *header,
+                                       const uint8 *payload, uint16 len,
+                                       uint8 instanceId, uint8 channelId)
+{
+    uint8 svc;
+    sint8 ret;
+
+    /* If REQUEST_NO_RETURN_WITH_ACK, auto reply ACK */
+    if (header->msgType == (uint8)PICC_MSG_REQUEST_NO_RETURN_WITH_ACK) {
+        (void)PICC_ServiceSendAck((uint8)PICC_MSG_ACK,
+                                  header->providerId,
+                                  header->consumerId,
+                                  header->methodId,
+                                  header->sessionId,
+                                  instanceId, channelId);
+    }
+
+    /* Service handled by a worker: queue, the worker sends the Response */
+    svc = g_workerByProvider[header->providerId];
+    if ((svc != PICC_SERVICE_NO_HANDLER) &&
+        (PICC_ServiceIndexLookup(&g_methodIndex, header->providerId, header->methodId) !=
+         PICC_SERVICE_NO_HANDLER)) {
+        ret = PICC_ServiceQueueRequest(svc, header, payload, len, channelId);
+        if (ret == 0) {
+            return 0;
+        }
+        if (ret != -1) {
+            PICC_ServiceRejectRequest(header, channelId);
+            return 0;
+        }
+        /* Worker task not running yet: handle here */
+    }
+
+    PICC_ServiceRunMethod(header, payload, len, channelId);
+    return 0;
+}
+
+/**
+ * @brief Handle Method response (Client role)
+ */
+static sint8 PICC_ServiceHandleResponse(const PICC_MsgHeader_t *header,
+                                        const uint8 *payload, uint16 len)
+{
+    /* Outstanding request: its own callback */
+    if (PICC_ServiceCompleteRequest(header, payload, len) != FALSE) {
+        return 0;
+    }
+
+    if (g_responseCallback != NULL) {
+        g_responseCallback(header->providerId,
+                          header->methodId,
+                          header->sessionId,
+                          header->returnCode,
+                          payload, len);
+    }
+    return 0;
+}
+
+/**
+ * @brief Deliver reassembled message (fragmentation layer callback)
+ */
+static void PICC_ServiceDeliverMessage(const PICC_MsgHeader_t *header,
+                                       const uint8 *payload, uint16 len,
+                                       uint8 instanceId, uint8 channelId)
+{
+    /* Fragments of fragments are not sent, no recursion beyond one level */
+    if (header->msgType != (uint8)PICC_MSG_FRAGMENT) {
+        (void)PICC_ServiceProcessMessage(header, payload, len, instanceId, channelId);
+    }
+}
+
+/**
+ * @brief Get open pipe
+ * 
+ * @return Pipe, NULL if the handle is invalid or the pipe is closed
+ */
+static PICC_Pipe_t* PICC_ServiceGetPipe(sint8 pipe)
+{
+    if ((pipe < 0) || ((uint8)pipe >= PICC_MAX_PIPES) || (g_pipes[pipe].isUsed == FALSE)) {
+        return NULL;
+    }
+    return &g_pipes[pipe];
+}
+
+/**
+ * @brief Free delivered entries at the ring head (in critical section)
+ */
+static void PICC_ServicePipePop(PICC_Pipe_t *p)
+{
+    while ((p->count != 0U) && (p->entries[p->head].state == PICC_PIPE_ENTRY_DELIVERED)) {
+        p->head = (uint8)((p->head + 1U) % PICC_PIPE_MAX_WINDOW);
+        p->count--;
+    }
+    p->stats.outstanding = p->count;
+}
+
+/**
+ * @brief Follow the server limit with a completion (in critical section)
+ * 
+ * PICC_RET_NOT_READY: the server queue is full, keep only the requests still
+ * outstanding. Otherwise grow by one per limit's worth of completions.
+ */
+static void PICC_ServicePipeAdapt(PICC_Pipe_t *p, PICC_RequestStatus_e status, uint8 returnCode)
+{
+    if (status != PICC_REQUEST_COMPLETED) {
+        return;
+    }
+
+    if (returnCode == (uint8)PICC_RET_NOT_READY) {
+        p->stats.notReady++;
+        p->stats.limit = (p->count > 1U) ? (uint8)(p->count - 1U) : 1U;
+        p->okCount = 0U;
+    } else if (p->stats.limit < p->stats.serverLimit) {
+        p->okCount++;
+        if (p->okCount >= p->stats.limit) {
+            p->stats.limit++;
+            p->okCount = 0U;
+        }
+    } else {
+        /* At the limit */
+    }
+}
+
+/**
+ * @brief Take over delivery if the head entry is held and no task delivers (in critical section)
+ * 
+ * @return TRUE if the caller must call PICC_ServicePipeDrain()
+ */
+static boolean PICC_ServicePipeTakeDelivery(PICC_Pipe_t *p)
+{
+    if ((p->config.inOrder == FALSE) || (p->delivering != FALSE) || (p->count == 0U) ||
+        (p->entries[p->head].state != PICC_PIPE_ENTRY_DONE)) {
+        return FALSE;
+    }
+    p->delivering = TRUE;
+    return TRUE;
+}
+
+/**
+ * @brief Deliver held completions in request order
+ * 
+ * Called by the task that set p->delivering. Ends when the head entry is
+ * still outstanding; a completion arriving later delivers itself.
+ */
+static void PICC_ServicePipeDrain(PICC_Pipe_t *p)
+{
+    PICC_PipeEntry_t *e;
+    PICC_PipeEntry_t held;
+
+    for (;;) {
+        taskENTER_CRITICAL();
+        PICC_ServicePipePop(p);
+        if ((p->count == 0U) || (p->entries[p->head].state != PICC_PIPE_ENTRY_DONE)) {
+            p->delivering = FALSE;
+            taskEXIT_CRITICAL();
+            break;
+        }
+        e = &p->entries[p->head];
+        held = *e;
+        e->rspData = NULL;
+        e->state = PICC_PIPE_ENTRY_DELIVERED;
+        p->stats.completed++;
+        taskEXIT_CRITICAL();
+
+        p->config.request.callback(p->config.request.cbArg, held.status, p->providerId,
+                                   p->methodId, held.sessionId, held.returnCode,
+                                   held.rspData, held.rspLen);
+        PICC_ArenaFree(held.rspData);
+    }
+}
+
+/**
+ * @brief Pipe request completion (PICC_RequestCallback_t, cbArg = pipe entry)
+ * 
+ * Out of order: delivered at once. In order: delivered at once when it is
+ * the oldest entry, otherwise held (response copied to the scratch arena)
+ * until the entries before it are delivered.
+ */
+static void PICC_ServicePipeComplete(void *cbArg, PICC_RequestStatus_e status,
+                                     uint8 providerId, uint8 methodId,
+                                     uint8 sessionId, uint8 returnCode,
+                                     const uint8 *rspData, uint16 rspLen)
+{
+    PICC_PipeEntry_t *e = (PICC_PipeEntry_t *)cbArg;
+    PICC_Pipe_t *p = &g_pipes[e->pipe];
+    uint8 *copy = NULL;
+    boolean now;
+    boolean owner = FALSE;
+    uint32 i;
+
+    taskENTER_CRITICAL();
+    e->sessionId = sessionId;
+    PICC_ServicePipeAdapt(p, status, returnCode);
+    now = ((p->config.inOrder == FALSE) ||
+           ((p->delivering == FALSE) && (e == &p->entries[p->head]))) ? TRUE : FALSE;
+    if ((now != FALSE) && (p->config.inOrder != FALSE)) {
+        p->delivering = TRUE;  /* Later completions are held until this one is delivered */
+        owner = TRUE;
+    }
+    taskEXIT_CRITICAL();
+
+    if (now == FALSE) {
+        /* Hold back: copy response, Rx buffer is released after this call */
+        if ((rspData != NULL) && (rspLen != 0U)) {
+            copy = (uint8 *)PICC_ArenaAlloc(rspLen, PICC_ARENA_OWNER_SERVICE);
+            if (copy != NULL) {
+                for (i = 0U; i < rspLen; i++) {
+                    copy[i] = rspData[i];
+                }
+            }
+        }
+
+        taskENTER_CRITICAL();
+        if ((copy == NULL) && (rspData != NULL) && (rspLen != 0U)) {
+            /* No memory to hold it: deliver out of order rather than lose it */
+            p->stats.reorderFailures++;
+            now = TRUE;
+        } else {
+            e->status     = status;
+            e->returnCode = returnCode;
+            e->rspData    = copy;
+            e->rspLen     = rspLen;
+            e->state      = PICC_PIPE_ENTRY_DONE;
+            p->stats.reordered++;
+            /* Entries before it delivered meanwhile: deliver from here */
+            owner = PICC_ServicePipeTakeDelivery(p);
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    if (now != FALSE) {
+        p->config.request.callback(p->config.request.cbArg, status, providerId, methodId,
+                                   sessionId, returnCode, rspData, rspLen);
+        taskENTER_CRITICAL();
+        e->state = PICC_PIPE_ENTRY_DELIVERED;
+        p->stats.completed++;
+        PICC_ServicePipePop(p);
+        if (owner == FALSE) {
+            owner = PICC_ServicePipeTakeDelivery(p);
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    if (owner != FALSE) {
+        PICC_ServicePipeDrain(p);
+    }
+}
+
+/**
+ * @brief Close all pipes, dropping held completions (service layer init/deinit)
+ */
+static void PICC_ServicePipeClear(void)
+{
+    uint32 i;
+    uint32 j;
+
+    for (i = 0U; i < PICC_MAX_PIPES; i++) {
+        for (j = 0U; j < PICC_PIPE_MAX_WINDOW; j++) {
+            if (g_pipes[i].isUsed != FALSE) {
+                PICC_ArenaFree(g_pipes[i].entries[j].rspData);
+            }
+            g_pipes[i].entries[j].rspData = NULL;
+        }
+        g_pipes[i].isUsed = FALSE;
+    }
+}
+
+/*==================================================================================================
+ *                                         Public Functions - Initialization
+ *==================================================================================================*/
+
+/**
+ * @brief Initialize service layer (called by PICC_Init)
+ */
+void PICC_ServiceLayerInit(void)
+{
+    uint32 i;
+    
+    /* Clear registry */
+    for (i = 0U; i < PICC_MAX_EVENT_HANDLERS; i++) {
+        g_eventHandlers[i].isUsed = FALSE;
+        g_eventHandlers[i].callback = NULL;
+    }
+    
+    for (i = 0U; i < PICC_MAX_METHOD_HANDLERS; i++) {
+        g_methodHandlers[i].isUsed = FALSE;
+        g_methodHandlers[i].callback = NULL;
+    }
+    
+    PICC_ServiceIndexClear(&g_eventIndex);
+    PICC_ServiceIndexClear(&g_methodIndex);
+    PICC_ServiceRequestClear();
+    PICC_ServiceWorkerClear();
+    PICC_ServicePipeClear();
+    PICC_FragInit(PICC_ServiceDeliverMessage);
+    
+    g_responseCallback = NULL;
+    g_responseFlags = PICC_HANDLER_FLAG_NONE;
+    g_sessionIdCounter = PICC_SESSION_ID_MIN;
+    g_serviceInitialized = TRUE;
+}
+
+/**
+ * @brief Deinitialize service layer
+ */
+void PICC_ServiceLayerDeinit(void)
+{
+    uint32 i;
+    
+    for (i = 0U; i < PICC_MAX_EVENT_HANDLERS; i++) {
+        g_eventHandlers[i].isUsed = FALSE;
+    }
+    
+    for (i = 0U; i < PICC_MAX_METHOD_HANDLERS; i++) {
+        g_methodHandlers[i].isUsed = FALSE;
+    }
+    
+    PICC_ServiceIndexClear(&g_eventIndex);
+    PICC_ServiceIndexClear(&g_methodIndex);
+    PICC_ServiceRequestClear();  /* Outstanding requests dropped without callback */
+    PICC_ServiceWorkerClear();   /* Queued requests dropped without Response */
+    PICC_ServicePipeClear();     /* Pipes closed, held completions dropped */
+    PICC_FragInit(NULL);         /* Transfers and reassemblies dropped */
+    
+    g_responseCallback = NULL;
+    g_serviceInitialized = FALSE;
+}
+
+/*==================================================================================================
+ *                                         Public Functions - Handler Registration
+ *==================================================================================================*/
+
+/**
+ * @brief Register Event receive handler
+ */
+sint8 PICC_RegisterEventHandler(uint8 providerId, PICC_EventCallback_t callback)
+{
+    return PICC_RegisterEventIdHandler(providerId, PICC_SERVICE_ANY_ID, callback);
+}
+
+/**
+ * @brief Register Event receive handler for one EventID of a provider
+ * 
+ * Several handlers of the same key are all called, in registration order.
+ */
+sint8 PICC_RegisterEventIdHandler(uint8 providerId, uint8 eventId, PICC_EventCallback_t callback)
+{
+    return PICC_RegisterEventIdHandlerEx(providerId, eventId, callback, PICC_HANDLER_FLAG_NONE);
+}
+
+/**
+ * @brief Register Event receive handler for one EventID of a provider, with flags
+ */
+sint8 PICC_RegisterEventIdHandlerEx(uint8 providerId, uint8 eventId,
+                                    PICC_EventCallback_t callback, uint8 flags)
+{
+    sint8 freeSlot = -1;
+    uint8 *entry;
+    uint8 slot;
+    uint32 i;
+    
+    if (callback == NULL) {
+        HANDLE_ERROR(-16);  /* Service: Event handler callback is NULL */
+        return -1;
+    }
+    
+    /* Find free slot */
+    for (i = 0U; i < PICC_MAX_EVENT_HANDLERS; i++) {
+        if (g_eventHandlers[i].isUsed == FALSE) {
+            freeSlot = (sint8)i;
+            break;
+        }
+    }
+    
+    if (freeSlot < 0) {
+        HANDLE_ERROR(-17);  /* Service: Event handler registry full */
+        return -2;  /* Registry full */
+    }
+    
+    g_eventHandlers[freeSlot].providerId = providerId;
+    g_eventHandlers[freeSlot].eventId = eventId;
+    g_eventHandlers[freeSlot].next = PICC_SERVICE_NO_HANDLER;
+    g_eventHandlers[freeSlot].flags = flags;
+    g_eventHandlers[freeSlot].callback = callback;
+    
+    /* Link at end of the handler list of (ProviderID, EventID) */
+    taskENTER_CRITICAL();
+    entry = PICC_ServiceIndexEntry(&g_eventIndex, providerId, eventId);
+    if (entry == NULL) {
+        taskEXIT_CRITICAL();
+        HANDLE_ERROR(-28);  /* Service: No free per-ID handler table */
+        return -3;
+    }
+    if (*entry == PICC_SERVICE_NO_HANDLER) {
+        *entry = (uint8)freeSlot;
+    } else {
+        slot = *entry;
+        while (g_eventHandlers[slot].next != PICC_SERVICE_NO_HANDLER) {
+            slot = g_eventHandlers[slot].next;
+        }
+        g_eventHandlers[slot].next = (uint8)freeSlot;
+    }
+    g_eventHandlers[freeSlot].isUsed = TRUE;
+    taskEXIT_CRITICAL();
+    
+    return 0;
+}
+
+/**
+ * @brief Register Method request handler
  */
 sint8 PICC_RegisterMethodHandler(uint8 localProviderId, PICC_MethodCallback_t callback)
 {
+    return PICC_RegisterMethodIdHandler(localProviderId, PICC_SERVICE_ANY_ID, callback);
+}
+
+/**
+ * @brief Register Method request handler for one MethodID of a provider
+ * 
+ * Only one handler per key: the first registration is kept.
+ */
+sint8 PICC_RegisterMethodIdHandler(uint8 localProviderId, uint8 methodId,
+                                   PICC_MethodCallback_t callback)
+{
+    return PICC_RegisterMethodIdHandlerEx(localProviderId, methodId, callback,
+                                          PICC_HANDLER_FLAG_NONE);
+}
+
+/**
+ * @brief Register Method request handler for one MethodID of a provider, with flags
+ */
+sint8 PICC_RegisterMethodIdHandlerEx(uint8 localProviderId, uint8 methodId,
+                                     PICC_MethodCallback_t callback, uint8 flags)
+{
+    sint8 freeSlot = -1;
+    uint8 *entry;
+    uint32 i;
+    
+    if (callback == NULL) {
+        HANDLE_ERROR(-18);  /* Service: Method handler callback is NULL */
+        return -1;
+    }
+    
+    /* Find free slot */
+    for (i = 0U; i < PICC_MAX_METHOD_HANDLERS; i++) {
+        if (g_methodHandlers[i].isUsed == FALSE) {
+            freeSlot = (sint8)i;
+            break;
+        }
+    }
+    
+    if (freeSlot < 0) {
+        HANDLE_ERROR(-19);  /* Service: Method handler registry full */
+        return -2;  /* Registry full */
+    }
+    
+    g_methodHandlers[freeSlot].localProviderId = localProviderId;
+    g_methodHandlers[freeSlot].methodId = methodId;
+    g_methodHandlers[freeSlot].flags = flags;
+    g_methodHandlers[freeSlot].rspMax = PICC_MAX_PAYLOAD_SIZE;  /* Until declared smaller */
+    g_methodHandlers[freeSlot].callback = callback;
+    
+    taskENTER_CRITICAL();
+    entry = PICC_ServiceIndexEntry(&g_methodIndex, localProviderId, methodId);
+    if (entry == NULL) {
+        taskEXIT_CRITICAL();
+        HANDLE_ERROR(-28);  /* Service: No free per-ID handler table */
+        return -3;
+    }
+    if (*entry != PICC_SERVICE_NO_HANDLER) {
+        taskEXIT_CRITICAL();
+        HANDLE_ERROR(-29);  /* Service: Method handler already registered */
+        return -4;
+    }
+    *entry = (uint8)freeSlot;
+    g_methodHandlers[freeSlot].isUsed = TRUE;
+    taskEXIT_CRITICAL();
+    
+    return 0;
+}
+
+/**
+ * @brief Declare the largest response data of a registered Method handler
+ */
+sint8 PICC_SetMethodResponseSize(uint8 localProviderId, uint8 methodId, uint16 maxRspLen)
+{
+    uint32 i;
+    
+    if (maxRspLen > PICC_MAX_PAYLOAD_SIZE) {
+        return -1;
+    }
+    
+    for (i = 0U; i < PICC_MAX_METHOD_HANDLERS; i++) {
+        if ((g_methodHandlers[i].isUsed != FALSE) &&
+            (g_methodHandlers[i].localProviderId == localProviderId) &&
+            (g_methodHandlers[i].methodId == methodId)) {
+            g_methodHandlers[i].rspMax = maxRspLen;
+            return 0;
+        }
+    }
+    
+    return -2;  /* Handler not registered */
+}
+
+/**
+ * @brief Register Method response handler
+ */
+sint8 PICC_RegisterResponseHandler(PICC_ResponseCallback_t callback)
+{
+    return PICC_RegisterResponseHandlerEx(callback, PICC_HANDLER_FLAG_NONE);
+}
+
+/**
+ * @brief Register Method response handler, with flags
+ */
+sint8 PICC_RegisterResponseHandlerEx(PICC_ResponseCallback_t callback, uint8 flags)
+{
+    taskENTER_CRITICAL();
+    g_responseCallback = callback;
+    g_responseFlags = flags;
+    taskEXIT_CRITICAL();
+    return 0;
+}
+
+/*==================================================================================================
+ *                                         Public Functions - Sending
+ *==================================================================================================*/
+
+/**
+ * @brief Send Event notification
+ */
+sint8 PICC_SendEvent(uint8 providerId, uint8 eventId, uint8 consumerId,
+                     const uint8 *data, uint16 len, PICC_EventType_e withAck,
+                     uint8 channelId)
+{
+    PICC_MsgHeader_t header;
+    sint8 ret;
+
+    if (g_serviceInitialized == FALSE) {
+        HANDLE_ERROR(-20);  /* Service: Not initialized for SendEvent */
+        return -1;
+    }
+
+    header.providerId = providerId;
+    header.methodId   = eventId;
+    header.consumerId = consumerId;
+    header.sessionId  = (withAck == PICC_EVENT_WITH_ACK) ? PICC_GetNextSessionId() : 0x00U;
+    header.msgType    = (withAck == PICC_EVENT_WITH_ACK) ?
+                        (uint8)PICC_MSG_NOTIFICATION_WITH_ACK :
+                        (uint8)PICC_MSG_NOTIFICATION_WITHOUT_ACK;
+    header.returnCode = (uint8)PICC_RET_OK;
+
+    ret = PICC_ServiceSendMessage(&header, data, len, channelId);
+    if (ret != 0) {
+        HANDLE_ERROR(-21);  /* Service: SendEvent failed */
+    }
+    return ret;
+}
+
+/**
+ * @brief Send Method request (Client role)
+ */
+uint8 PICC_ServiceMethodSend(uint8 providerId, uint8 methodId,
+                             const uint8 *data, uint16 len,
+                             PICC_MethodType_e type,
+                             uint8 instanceId, uint8 channelId)
+{
+    uint8 msgType;
+    uint8 sessionId;
+    sint8 ret;
+
+    (void)instanceId;
+
+    if (g_serviceInitialized == FALSE) {
+        HANDLE_ERROR(-22);  /* Service: Not initialized for MethodSend */
+        return 0U;
+    }
+
+    if (PICC_ServiceRequestMsgType(type, &msgType) == FALSE) {
+        HANDLE_ERROR(-23);  /* Service: Invalid method type */
+        return 0U;
+    }
+
+    sessionId = PICC_GetNextSessionId();
+
+    ret = PICC_ServiceSendRequest(providerId, methodId, sessionId, msgType, data, len, channelId);
+    if (ret != 0) {
+        HANDLE_ERROR(-24);  /* Service: MethodSend failed */
+        return 0U;
+    }
+
+    return sessionId;
+}
+
+/**
+ * @brief Send Method response (Server role)
+ */
+sint8 PICC_ServiceResponseSend(uint8 consumerId, uint8 methodId,
+                               uint8 sessionId, uint8 returnCode,
+                               const uint8 *data, uint16 len,
+                               uint8 instanceId, uint8 channelId)
+{
+    PICC_MsgHeader_t header;
+    sint8 ret;
+
+    (void)instanceId;
+
+    if (g_serviceInitialized == FALSE) {
+        HANDLE_ERROR(-25);  /* Service: Not initialized for ResponseSend */
+        return -1;
+    }
+
+    header.providerId = 0U;  /* Set by caller */
+    header.methodId   = methodId;
+    header.consumerId = consumerId;
+    header.sessionId  = sessionId;
+    header.msgType    = (uint8)PICC_MSG_RESPONSE;
+    header.returnCode = returnCode;
+
+    ret = PICC_ServiceSendMessage(&header, data, len, channelId);
+    if (ret != 0) {
+        HANDLE_ERROR(-26);  /* Service: ResponseSend failed */
+    }
+    return ret;
+}
+
+/*==================================================================================================
+ *                                         Public Functions - Outstanding Requests
+ *==================================================================================================*/
+
+/**
+ * @brief Send Method request tracked until its response (Client role)
+ */
+uint8 PICC_ServiceRequestAsync(uint8 providerId, uint8 methodId,
+                               const uint8 *data, uint16 len,
+                               PICC_MethodType_e type,
+                               const PICC_RequestConfig_t *config,
+                               uint8 instanceId, uint8 channelId)
+{
+    PICC_PendingRequest_t *req;
+    sint8 freeSlot = -1;
+    uint8 msgType;
+    uint8 sessionId;
+    uint32 i;
+
+    if (g_serviceInitialized == FALSE) {
+        HANDLE_ERROR(-22);  /* Service: Not initialized for MethodSend */
+        return 0U;
+    }
+
+    if ((config == NULL) || (PICC_ServiceRequestMsgType(type, &msgType) == FALSE)) {
+        HANDLE_ERROR(-23);  /* Service: Invalid method type */
+        return 0U;
+    }
+
+    /* Nothing comes back: nothing to track */
+    if (type == PICC_METHOD_NO_RETURN_WITHOUT_ACK) {
+        return PICC_ServiceMethodSend(providerId, methodId, data, len, type, instanceId, channelId);
+    }
+
+    /* Enter before sending, so a fast response always finds its request */
+    taskENTER_CRITICAL();
+    for (i = 0U; i < PICC_MAX_PENDING_REQUESTS; i++) {
+        if (g_pendingRequests[i].isUsed == FALSE) {
+            freeSlot = (sint8)i;
+            break;
+        }
+    }
+    if (freeSlot < 0) {
+        taskEXIT_CRITICAL();
+        HANDLE_ERROR(-30);  /* Service: Outstanding request table full */
+        return 0U;
+    }
+
+    sessionId = PICC_GetNextSessionId();
+    if (g_pendingBySession[sessionId] != PICC_SERVICE_NO_HANDLER) {
+        taskEXIT_CRITICAL();
+        HANDLE_ERROR(-30);  /* Service: No free session ID */
+        return 0U;
+    }
+
+    req = &g_pendingRequests[freeSlot];
+    req->providerId   = providerId;
+    req->methodId     = methodId;
+    req->sessionId    = sessionId;
+    req->msgType      = msgType;
+    req->channelId    = channelId;
+    req->retriesLeft  = config->maxRetries;
+    req->dataLen      = len;
+    req->canRetry     = ((len <= PICC_REQUEST_RETRY_DATA_SIZE) &&
+                         ((data != NULL) || (len == 0U))) ? TRUE : FALSE;
+    if (req->canRetry != FALSE) {
+        for (i = 0U; i < len; i++) {
+            req->data[i] = data[i];
+        }
+    }
+    req->timeoutTicks = pdMS_TO_TICKS((config->timeoutMs != 0U) ?
+                                      config->timeoutMs : PICC_REQUEST_TIMEOUT_MS);
+    req->sendTick     = (uint32)xTaskGetTickCount();
+    req->callback     = config->callback;
+    req->cbArg        = config->cbArg;
+    req->cbFlags      = config->flags;
+    req->isUsed       = TRUE;
+    g_pendingBySession[sessionId] = (uint8)freeSlot;
+
+    g_requestStats.sent++;
+    g_requestStats.inFlight++;
+    if (g_requestStats.inFlight > g_requestStats.maxInFlight) {
+        g_requestStats.maxInFlight = g_requestStats.inFlight;
+    }
+    taskEXIT_CRITICAL();
+
+    if (PICC_ServiceSendRequest(providerId, methodId, sessionId, msgType,
+                                data, len, channelId) != 0) {
+        /* Not sent: forget the request, caller sees the failure */
+        taskENTER_CRITICAL();
+        PICC_ServiceFreeRequest((uint8)freeSlot);
+        g_requestStats.sent--;
+        taskEXIT_CRITICAL();
+        HANDLE_ERROR(-24);  /* Service: MethodSend failed */
+        return 0U;
+    }
+
+    return sessionId;
+}
+
+/**
+ * @brief Cancel an outstanding request
+ */
+sint8 PICC_ServiceRequestCancel(uint8 providerId, uint8 methodId, uint8 sessionId)
+{
+    PICC_RequestCallback_t callback;
+    void *cbArg;
+    uint8 slot;
+
+    taskENTER_CRITICAL();
+    slot = PICC_ServiceFindRequest(providerId, methodId, sessionId);
+    if (slot == PICC_SERVICE_NO_HANDLER) {
+        taskEXIT_CRITICAL();
+        return -1;
+    }
+    callback = g_pendingRequests[slot].callback;
+    cbArg = g_pendingRequests[slot].cbArg;
+    PICC_ServiceFreeRequest(slot);
+    taskEXIT_CRITICAL();
+
+    if (callback != NULL) {
+        callback(cbArg, PICC_REQUEST_CANCELLED, providerId, methodId, sessionId,
+                 (uint8)PICC_RET_NOT_OK, NULL, 0U);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Outstanding request timeouts/retries - called from PICC periodic task (10ms)
+ * 
+ * Timeouts therefore have a resolution of the 10ms period.
+ */
+void PICC_ServiceRequestProcess(void)
+{
+    PICC_PendingRequest_t *req;
+    PICC_RequestCallback_t callback;
+    void *cbArg;
+    uint8 retryData[PICC_REQUEST_RETRY_DATA_SIZE];
+    uint8 providerId;
+    uint8 methodId;
+    uint8 sessionId;
+    uint8 msgType;
+    uint8 channelId;
+    uint16 len;
+    uint32 now;
     uint32 i;
-    
-    if (callback == NULL) {
-        HANDLE_ERROR(-18);  /* Service: Method handler callback is NULL */
-        return -1;
+    uint32 j;
+    boolean retry;
+
+    if (g_serviceInitialized == FALSE) {
+        return;
     }
-    
-    /* Find free slot */
-    for (i = 0U; i < PICC_MAX_METHOD_HANDLERS; i++) {
-        if (g_methodHandlers[i].isUsed == FALSE) {
-            g_methodHandlers[i].localProviderId = localProviderId;
-            g_methodHandlers[i].callback = callback;
-            g_methodHandlers[i].isUsed = TRUE;
-            return 0;
+
+    for (i = 0U; i < PICC_MAX_PENDING_REQUESTS; i++) {
+        req = &g_pendingRequests[i];
+
+        taskENTER_CRITICAL();
+        now = (uint32)xTaskGetTickCount();
+        if ((req->isUsed == FALSE) || ((now - req->sendTick) < req->timeoutTicks)) {
+            taskEXIT_CRITICAL();
+            continue;
+        }
+
+        providerId = req->providerId;
+        methodId   = req->methodId;
+        sessionId  = req->sessionId;
+        msgType    = req->msgType;
+        channelId  = req->channelId;
+        len        = req->dataLen;
+        callback   = req->callback;
+        cbArg      = req->cbArg;
+
+        retry = ((req->retriesLeft != 0U) && (req->canRetry != FALSE)) ? TRUE : FALSE;
+        if (retry != FALSE) {
+            /* Retransmit with the same session ID, restart timeout */
+            req->retriesLeft--;
+            req->sendTick = now;
+            for (j = 0U; j < len; j++) {
+                retryData[j] = req->data[j];
+            }
+            g_requestStats.retries++;
+        } else {
+            g_requestStats.timeouts++;
+            PICC_ServiceFreeRequest((uint8)i);
+        }
+        taskEXIT_CRITICAL();
+
+        if (retry != FALSE) {
+            /* If this fails, the next timeout retries again or gives up */
+            (void)PICC_ServiceSendRequest(providerId, methodId, sessionId, msgType,
+                                          retryData, len, channelId);
+        } else if (callback != NULL) {
+            callback(cbArg, PICC_REQUEST_TIMEOUT, providerId, methodId, sessionId,
+                     (uint8)PICC_RET_NOT_OK, NULL, 0U);
+        } else {
+            /* Legacy request: no one to notify */
         }
     }
-    
-    HANDLE_ERROR(-19);  /* Service: Method handler registry full */
-    return -2;  /* Registry full */
 }
 
 /**
- * @brief Register Method response handler
+ * @brief Get number of outstanding requests
  */
-sint8 PICC_RegisterResponseHandler(PICC_ResponseCallback_t callback)
+uint16 PICC_ServiceGetInFlight(void)
 {
-    g_responseCallback = callback;
+    return g_requestStats.inFlight;
+}
+
+/**
+ * @brief Get outstanding request statistics
+ */
+sint8 PICC_ServiceGetRequestStats(PICC_RequestStats_t *stats)
+{
+    if (stats == NULL) {
+        return -1;
+    }
+
+    taskENTER_CRITICAL();
+    *stats = g_requestStats;
+    taskEXIT_CRITICAL();
+
     return 0;
 }
 
+/**
+ * @brief Reset outstanding request statistics
+ */
+void PICC_ServiceResetRequestStats(void)
+{
+    uint16 inFlight;
+
+    taskENTER_CRITICAL();
+    inFlight = g_requestStats.inFlight;
+    g_requestStats.sent          = 0U;
+    g_requestStats.completed     = 0U;
+    g_requestStats.timeouts      = 0U;
+    g_requestStats.retries       = 0U;
+    g_requestStats.unmatched     = 0U;
+    g_requestStats.inFlight      = inFlight;
+    g_requestStats.maxInFlight   = inFlight;
+    g_requestStats.totalRttTicks = 0U;
+    g_requestStats.minRttTicks   = 0xFFFFFFFFUL;  /* No completion yet */
+    g_requestStats.maxRttTicks   = 0U;
+    taskEXIT_CRITICAL();
+}
+
 /*==================================================================================================
- *                                         Public Functions - Sending
+ *                                         Public Functions - Request Pipes
  *==================================================================================================*/
 
 /**
- * @brief Send Event notification
+ * @brief Open a request pipe to one Method of a provider
  */
-sint8 PICC_SendEvent(uint8 providerId, uint8 eventId, uint8 consumerId,
-                     const uint8 *data, uint16 len, PICC_EventType_e withAck,
-                     uint8 channelId)
+sint8 PICC_ServicePipeOpen(uint8 providerId, uint8 methodId, const PICC_PipeConfig_t *config,
+                           uint8 instanceId, uint8 channelId)
 {
-    PICC_MsgHeader_t header;
-    sint8 ret;
+    PICC_PipeStats_t empty = {0};
+    PICC_Pipe_t *p;
+    sint8 freeSlot = -1;
+    uint32 i;
 
-    if (g_serviceInitialized == FALSE) {
-        HANDLE_ERROR(-20);  /* Service: Not initialized for SendEvent */
+    if ((config == NULL) || (config->request.callback == NULL) ||
+        (config->window == 0U) || (config->window > PICC_PIPE_MAX_WINDOW) ||
+        ((config->type != PICC_METHOD_WITH_RESPONSE) &&
+         (config->type != PICC_METHOD_NO_RETURN_WITH_ACK))) {
+        HANDLE_ERROR(-23);  /* Service: Invalid method type */
         return -1;
     }
 
-    header.providerId = providerId;
-    header.methodId   = eventId;
-    header.consumerId = consumerId;
-    header.sessionId  = (withAck == PICC_EVENT_WITH_ACK) ? PICC_GetNextSessionId() : 0x00U;
-    header.msgType    = (withAck == PICC_EVENT_WITH_ACK) ?
-                        (uint8)PICC_MSG_NOTIFICATION_WITH_ACK :
-                        (uint8)PICC_MSG_NOTIFICATION_WITHOUT_ACK;
-    header.returnCode = (uint8)PICC_RET_OK;
+    taskENTER_CRITICAL();
+    for (i = 0U; i < PICC_MAX_PIPES; i++) {
+        if (g_pipes[i].isUsed == FALSE) {
+            freeSlot = (sint8)i;
+            g_pipes[i].isUsed = TRUE;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
 
-    ret = PICC_ServiceSendMessage(&header, data, len, channelId);
-    if (ret != 0) {
-        HANDLE_ERROR(-21);  /* Service: SendEvent failed */
+    if (freeSlot < 0) {
+        HANDLE_ERROR(-50);  /* Service: Request pipe table full */
+        return -2;
     }
-    return ret;
+
+    p = &g_pipes[freeSlot];
+    p->providerId = providerId;
+    p->methodId   = methodId;
+    p->instanceId = instanceId;
+    p->channelId  = channelId;
+    p->config     = *config;
+    p->head       = 0U;
+    p->count      = 0U;
+    p->okCount    = 0U;
+    p->delivering = FALSE;
+    for (i = 0U; i < PICC_PIPE_MAX_WINDOW; i++) {
+        p->entries[i].pipe    = (uint8)freeSlot;
+        p->entries[i].rspData = NULL;
+    }
+    p->stats = empty;
+    p->stats.limit       = config->window;
+    p->stats.serverLimit = config->window;
+
+    return freeSlot;
 }
 
 /**
- * @brief Send Method request (Client role)
+ * @brief Send a request on a pipe
  */
-uint8 PICC_ServiceMethodSend(uint8 providerId, uint8 methodId,
-                             const uint8 *data, uint16 len,
-                             PICC_MethodType_e type,
-                             uint8 instanceId, uint8 channelId)
+uint8 PICC_ServicePipeRequest(sint8 pipe, const uint8 *data, uint16 len)
 {
-    PICC_MsgHeader_t header;
+    PICC_Pipe_t *p = PICC_ServiceGetPipe(pipe);
+    PICC_PipeEntry_t *e;
+    PICC_RequestConfig_t reqConfig;
     uint8 sessionId;
-    sint8 ret;
+    boolean owner = FALSE;
 
-    (void)instanceId;
+    if (p == NULL) {
+        return 0U;
+    }
 
-    if (g_serviceInitialized == FALSE) {
-        HANDLE_ERROR(-22);  /* Service: Not initialized for MethodSend */
+    /* Take the next ring entry before sending, a fast response needs it */
+    taskENTER_CRITICAL();
+    if (p->count >= p->stats.limit) {
+        p->stats.windowFull++;
+        taskEXIT_CRITICAL();
         return 0U;
     }
+    e = &p->entries[(p->head + p->count) % PICC_PIPE_MAX_WINDOW];
+    e->state     = PICC_PIPE_ENTRY_WAITING;
+    e->sessionId = 0U;
+    e->rspData   = NULL;
+    p->count++;
+    p->stats.outstanding = p->count;
+    if (p->count > p->stats.maxOutstanding) {
+        p->stats.maxOutstanding = p->count;
+    }
+    taskEXIT_CRITICAL();
 
-    sessionId = PICC_GetNextSessionId();
+    reqConfig = p->config.request;
+    reqConfig.callback = PICC_ServicePipeComplete;
+    reqConfig.cbArg = e;
 
-    header.providerId = providerId;
-    header.methodId   = methodId;
-    header.consumerId = 0U;  /* Set by caller at higher layer */
-    header.sessionId  = sessionId;
-    header.returnCode = (uint8)PICC_RET_OK;
+    sessionId = PICC_ServiceRequestAsync(p->providerId, p->methodId, data, len,
+                                         p->config.type, &reqConfig,
+                                         p->instanceId, p->channelId);
 
-    switch (type) {
-        case PICC_METHOD_WITH_RESPONSE:
-            header.msgType = (uint8)PICC_MSG_REQUEST;
-            break;
-        case PICC_METHOD_NO_RETURN_WITH_ACK:
-            header.msgType = (uint8)PICC_MSG_REQUEST_NO_RETURN_WITH_ACK;
-            break;
-        case PICC_METHOD_NO_RETURN_WITHOUT_ACK:
-            header.msgType = (uint8)PICC_MSG_REQUEST_NO_RETURN_WITHOUT_ACK;
-            break;
-        default:
-            HANDLE_ERROR(-23);  /* Service: Invalid method type */
-            return 0U;
+    taskENTER_CRITICAL();
+    if (sessionId == 0U) {
+        /* Not sent: skipped when it reaches the head */
+        e->state = PICC_PIPE_ENTRY_DELIVERED;
+        PICC_ServicePipePop(p);
+        owner = PICC_ServicePipeTakeDelivery(p);
+    } else {
+        /* Entry may already be completed and reused: session ID set by the completion */
+        p->stats.sent++;
     }
+    taskEXIT_CRITICAL();
 
-    ret = PICC_ServiceSendMessage(&header, data, len, channelId);
-    if (ret != 0) {
-        HANDLE_ERROR(-24);  /* Service: MethodSend failed */
-        return 0U;
+    if (owner != FALSE) {
+        PICC_ServicePipeDrain(p);
     }
 
     return sessionId;
 }
 
 /**
- * @brief Send Method response (Server role)
+ * @brief Set the window limit advertised by the server
  */
-sint8 PICC_ServiceResponseSend(uint8 consumerId, uint8 methodId,
-                               uint8 sessionId, uint8 returnCode,
-                               const uint8 *data, uint16 len,
-                               uint8 instanceId, uint8 channelId)
+sint8 PICC_ServicePipeSetLimit(sint8 pipe, uint8 limit)
 {
-    PICC_MsgHeader_t header;
-    sint8 ret;
+    PICC_Pipe_t *p = PICC_ServiceGetPipe(pipe);
 
-    (void)instanceId;
+    if (p == NULL) {
+        return -1;
+    }
 
-    if (g_serviceInitialized == FALSE) {
-        HANDLE_ERROR(-25);  /* Service: Not initialized for ResponseSend */
+    if (limit == 0U) {
+        limit = 1U;
+    }
+    if (limit > p->config.window) {
+        limit = p->config.window;
+    }
+
+    taskENTER_CRITICAL();
+    p->stats.serverLimit = limit;
+    p->stats.limit = limit;
+    p->okCount = 0U;
+    taskEXIT_CRITICAL();
+
+    return 0;
+}
+
+/**
+ * @brief Close a pipe
+ */
+sint8 PICC_ServicePipeClose(sint8 pipe)
+{
+    PICC_Pipe_t *p = PICC_ServiceGetPipe(pipe);
+    PICC_PendingRequest_t *req;
+    uint8 sessionId;
+    uint32 i;
+
+    if (p == NULL) {
         return -1;
     }
 
-    header.providerId = 0U;  /* Set by caller */
-    header.methodId   = methodId;
-    header.consumerId = consumerId;
-    header.sessionId  = sessionId;
-    header.msgType    = (uint8)PICC_MSG_RESPONSE;
-    header.returnCode = returnCode;
+    /* Cancel outstanding requests of the pipe, they complete through PICC_ServicePipeComplete */
+    for (i = 0U; i < PICC_MAX_PENDING_REQUESTS; i++) {
+        req = &g_pendingRequests[i];
+        taskENTER_CRITICAL();
+        sessionId = ((req->isUsed != FALSE) && (req->callback == PICC_ServicePipeComplete) &&
+                     (((PICC_PipeEntry_t *)req->cbArg)->pipe == (uint8)pipe)) ? req->sessionId : 0U;
+        taskEXIT_CRITICAL();
+        if (sessionId != 0U) {
+            (void)PICC_ServiceRequestCancel(p->providerId, p->methodId, sessionId);
+        }
+    }
 
-    ret = PICC_ServiceSendMessage(&header, data, len, channelId);
-    if (ret != 0) {
-        HANDLE_ERROR(-26);  /* Service: ResponseSend failed */
+    taskENTER_CRITICAL();
+    for (i = 0U; i < PICC_PIPE_MAX_WINDOW; i++) {
+        PICC_ArenaFree(p->entries[i].rspData);
+        p->entries[i].rspData = NULL;
+    }
+    p->count = 0U;
+    p->isUsed = FALSE;
+    taskEXIT_CRITICAL();
+
+    return 0;
+}
+
+/**
+ * @brief Get request pipe statistics
+ */
+sint8 PICC_ServiceGetPipeStats(sint8 pipe, PICC_PipeStats_t *stats)
+{
+    PICC_Pipe_t *p = PICC_ServiceGetPipe(pipe);
+
+    if ((p == NULL) || (stats == NULL)) {
+        return -1;
+    }
+
+    taskENTER_CRITICAL();
+    *stats = p->stats;
+    taskEXIT_CRITICAL();
+
+    return 0;
+}
+
+/*==================================================================================================
+ *                                         Public Functions - Worker Pool
+ *==================================================================================================*/
+
+/**
+ * @brief Handle Method requests of a provider on a worker task
+ */
+sint8 PICC_ServiceSetWorker(uint8 localProviderId, uint8 worker)
+{
+    PICC_ServiceWorkerStats_t empty = {0};
+    sint8 freeSlot = -1;
+    QueueHandle_t queue;
+    uint32 i;
+
+    if (worker >= PICC_SERVICE_WORKER_NUM) {
+        return -1;
+    }
+
+    /* Reassign a provider already handled by a worker */
+    if (g_workerByProvider[localProviderId] != PICC_SERVICE_NO_HANDLER) {
+        g_workerServices[g_workerByProvider[localProviderId]].worker = worker;
+        return 0;
+    }
+
+    for (i = 0U; i < PICC_MAX_WORKER_SERVICES; i++) {
+        if (g_workerServices[i].isUsed == FALSE) {
+            freeSlot = (sint8)i;
+            break;
+        }
+    }
+
+    if (freeSlot < 0) {
+        HANDLE_ERROR(-47);  /* Service: Worker service table full */
+        return -2;
+    }
+
+    /* Queue kept across deinit, created on first use of the slot */
+    if (g_workerServices[freeSlot].queue == NULL) {
+        queue = xQueueCreate(PICC_SERVICE_WORKER_QUEUE_DEPTH, sizeof(PICC_ServiceJob_t));
+        if (queue == NULL) {
+            HANDLE_ERROR(-48);  /* Service: Worker queue creation failed */
+            return -3;
+        }
+        g_workerServices[freeSlot].queue = queue;
+    }
+
+    g_workerServices[freeSlot].providerId = localProviderId;
+    g_workerServices[freeSlot].worker = worker;
+    g_workerServices[freeSlot].stats = empty;
+
+    taskENTER_CRITICAL();
+    g_workerServices[freeSlot].isUsed = TRUE;
+    g_workerByProvider[localProviderId] = (uint8)freeSlot;
+    taskEXIT_CRITICAL();
+
+    return 0;
+}
+
+/**
+ * @brief Get worker queue statistics of a provider
+ */
+sint8 PICC_ServiceGetWorkerStats(uint8 localProviderId, PICC_ServiceWorkerStats_t *stats)
+{
+    uint8 svc;
+
+    if (stats == NULL) {
+        return -1;
+    }
+
+    taskENTER_CRITICAL();
+    svc = g_workerByProvider[localProviderId];
+    if (svc != PICC_SERVICE_NO_HANDLER) {
+        *stats = g_workerServices[svc].stats;
+    }
+    taskEXIT_CRITICAL();
+
+    return (svc != PICC_SERVICE_NO_HANDLER) ? 0 : -2;
+}
+
+/**
+ * @brief Service worker task
+ */
+void PICC_ServiceWorkerTask(void *pvParameters)
+{
+    uint8 worker = (uint8)(uintptr)pvParameters;
+    PICC_WorkerService_t *ws;
+    PICC_ServiceJob_t job;
+    boolean found;
+    uint32 i;
+
+    if (worker >= PICC_SERVICE_WORKER_NUM) {
+        HANDLE_ERROR(-49);  /* Service: Invalid worker task index */
+        vTaskDelete(NULL);
+        return;
+    }
+
+    g_workerTasks[worker] = xTaskGetCurrentTaskHandle();
+
+    for (;;) {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        /* One request per service and round, until all queues are empty */
+        do {
+            found = FALSE;
+            for (i = 0U; i < PICC_MAX_WORKER_SERVICES; i++) {
+                ws = &g_workerServices[i];
+                if ((ws->isUsed != FALSE) && (ws->worker == worker) &&
+                    (xQueueReceive(ws->queue, &job, 0U) == pdPASS)) {
+                    found = TRUE;
+                    PICC_ServiceRunJob(ws, &job);
+                }
+            }
+        } while (found != FALSE);
     }
-    return ret;
 }
 
 /*==================================================================================================
  *                                         Public Functions - Message Processing
  *==================================================================================================*/
 
+/**
+ * @brief Check whether a received message only runs lightweight handlers
+ */
+boolean PICC_ServiceIsDirect(const PICC_MsgHeader_t *header)
+{
+    uint8 flags = PICC_HANDLER_FLAG_DIRECT;
+    uint8 slot;
+
+    if (header == NULL) {
+        return FALSE;
+    }
+
+    switch (header->msgType) {
+        case (uint8)PICC_MSG_NOTIFICATION_WITH_ACK:
+        case (uint8)PICC_MSG_NOTIFICATION_WITHOUT_ACK:
+            slot = PICC_ServiceIndexLookup(&g_eventIndex, header->providerId, header->methodId);
+            while (slot != PICC_SERVICE_NO_HANDLER) {
+                flags &= g_eventHandlers[slot].flags;
+                slot = g_eventHandlers[slot].next;
+            }
+            break;
+
+        case (uint8)PICC_MSG_REQUEST:
+        case (uint8)PICC_MSG_REQUEST_NO_RETURN_WITH_ACK:
+        case (uint8)PICC_MSG_REQUEST_NO_RETURN_WITHOUT_ACK:
+            slot = PICC_ServiceIndexLookup(&g_methodIndex, header->providerId, header->methodId);
+            if ((slot != PICC_SERVICE_NO_HANDLER) &&
+                (g_workerByProvider[header->providerId] == PICC_SERVICE_NO_HANDLER)) {
+                flags = g_methodHandlers[slot].flags;
+            }
+            /* Handled by a worker: only queued on the Rx path */
+            break;
+
+        /* Same callback selection as PICC_ServiceCompleteRequest() */
+        case (uint8)PICC_MSG_RESPONSE:
+        case (uint8)PICC_MSG_ACK:
+            taskENTER_CRITICAL();
+            slot = PICC_ServiceFindRequest(header->providerId, header->methodId, header->sessionId);
+            if ((slot != PICC_SERVICE_NO_HANDLER) && (g_pendingRequests[slot].callback != NULL)) {
+                flags = g_pendingRequests[slot].cbFlags;
+            } else if ((header->msgType == (uint8)PICC_MSG_RESPONSE) && (g_responseCallback != NULL)) {
+                flags = g_responseFlags;
+            } else {
+                /* No one to notify */
+            }
+            taskEXIT_CRITICAL();
+            break;
+
+        /* Reassembled message may go to any handler */
+        case (uint8)PICC_MSG_FRAGMENT:
+            flags = PICC_HANDLER_FLAG_NONE;
+            break;
+
+        default:
+            break;
+    }
+
+    return ((flags & PICC_HANDLER_FLAG_DIRECT) != 0U) ? TRUE : FALSE;
+}
+
 /**
  * @brief Process received message
  */
@@ -512,11 +2009,19 @@ sint8 PICC_ServiceProcessMessage(const PICC_MsgHeader_t *header,
         case (uint8)PICC_MSG_RESPONSE:
             return PICC_ServiceHandleResponse(header, payload, len);
 
-        /* ACK messages - handled automatically by middleware, not reported to app layer */
+        /* Method ACK - completes outstanding NO_RETURN_WITH_ACK request, if any */
         case (uint8)PICC_MSG_ACK:
+            (void)PICC_ServiceCompleteRequest(header, payload, len);
+            break;
+
+        /* Event ACK - handled automatically by middleware, not reported to app layer */
         case (uint8)PICC_MSG_EVENT_ACK:
             break;
 
+        /* Fragment - reassembled message comes back through PICC_ServiceDeliverMessage */
+        case (uint8)PICC_MSG_FRAGMENT:
+            return PICC_FragReceive(header, payload, len, instanceId, channelId);
+
         /* Note: PICC_MSG_LINK_AVAILABLE is handled by PICC_ProcessSingleMessage in picc_api.c
          * before this function is called, so no need to handle it here. */
 
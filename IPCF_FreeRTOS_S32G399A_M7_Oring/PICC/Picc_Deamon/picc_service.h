@@ -3,6 +3,11 @@
  * @brief M-Core Inter-Core Communication Service Layer - Interface Definition
  *
  * Implements Event and Method service processing, including auto ACK reply (middleware layer).
+ * Received messages are dispatched in constant time by (ProviderID, MethodID/EventID).
+ * Outstanding Method requests are tracked with completion callbacks, timeouts and retries.
+ * Payloads above PICC_FRAG_THRESHOLD (up to PICC_FRAG_MAX_SIZE) are fragmented transparently.
+ * Method requests of opted-in services are queued to a worker task pool and answered from there.
+ * Request pipes keep up to a window of requests of one (ProviderID, MethodID) in flight.
  *
  * Copyright 2024 NXP
  * All Rights Reserved.
@@ -38,6 +43,15 @@ typedef enum {
     PICC_EVENT_WITHOUT_ACK        /**< No ACK */
 } PICC_EventType_e;
 
+/**
+ * @brief Outstanding request completion status
+ */
+typedef enum {
+    PICC_REQUEST_COMPLETED = 0U,  /**< Response (or ACK) received */
+    PICC_REQUEST_TIMEOUT,         /**< No response after all retries */
+    PICC_REQUEST_CANCELLED        /**< Cancelled by PICC_ServiceRequestCancel() */
+} PICC_RequestStatus_e;
+
 /*==================================================================================================
  *                                         Callback Function Types
  *==================================================================================================*/
@@ -82,15 +96,157 @@ typedef void (*PICC_ResponseCallback_t)(uint8 providerId, uint8 methodId,
                                         uint8 sessionId, uint8 returnCode,
                                         const uint8 *rspData, uint16 rspLen);
 
+/**
+ * @brief Outstanding request completion callback function type (Client role)
+ * 
+ * Called once per request, from the Rx task (COMPLETED), the periodic task
+ * (TIMEOUT) or the cancelling task (CANCELLED).
+ * 
+ * @param[in] cbArg       User argument from PICC_RequestConfig_t
+ * @param[in] status      Completion status
+ * @param[in] providerId  Service provider ID
+ * @param[in] methodId    Method ID
+ * @param[in] sessionId   Session ID
+ * @param[in] returnCode  Return code (PICC_RET_NOT_OK unless COMPLETED)
+ * @param[in] rspData     Response data (NULL unless COMPLETED)
+ * @param[in] rspLen      Response data length
+ */
+typedef void (*PICC_RequestCallback_t)(void *cbArg, PICC_RequestStatus_e status,
+                                       uint8 providerId, uint8 methodId,
+                                       uint8 sessionId, uint8 returnCode,
+                                       const uint8 *rspData, uint16 rspLen);
+
+/*==================================================================================================
+ *                                         Structure Definitions
+ *==================================================================================================*/
+
+/**
+ * @brief Outstanding request configuration
+ */
+typedef struct {
+    uint16                  timeoutMs;   /**< Time to wait for response per attempt (ms) */
+    uint8                   maxRetries;  /**< Retransmissions after timeout (0 = none) */
+    PICC_RequestCallback_t  callback;    /**< Completion callback (NULL = global response handler) */
+    void                   *cbArg;       /**< User argument passed to callback */
+    uint8                   flags;       /**< Callback flags PICC_HANDLER_FLAG_xxx */
+} PICC_RequestConfig_t;
+
+/**
+ * @brief Outstanding request statistics
+ * 
+ * Round-trip time is measured from the last (re)transmission to the
+ * response, in FreeRTOS ticks. Average RTT = totalRttTicks / completed.
+ */
+typedef struct {
+    uint32  sent;               /**< Requests sent (without retries) */
+    uint32  completed;          /**< Requests completed by response/ACK */
+    uint32  timeouts;           /**< Requests failed by timeout */
+    uint32  retries;            /**< Retransmissions */
+    uint32  unmatched;          /**< Responses/ACKs without outstanding request */
+    uint16  inFlight;           /**< Currently outstanding requests */
+    uint16  maxInFlight;        /**< Peak outstanding requests */
+    uint32  totalRttTicks;      /**< Sum of round-trip times */
+    uint32  minRttTicks;        /**< Smallest round-trip time (0xFFFFFFFF until first completion) */
+    uint32  maxRttTicks;        /**< Largest round-trip time */
+} PICC_RequestStats_t;
+
+/**
+ * @brief Worker queue statistics of a service
+ * 
+ * Times in FreeRTOS ticks. Average wait = totalWaitTicks / processed,
+ * average handler time = totalRunTicks / processed.
+ */
+typedef struct {
+    uint32  queued;             /**< Requests queued to the worker */
+    uint32  rejected;           /**< Requests answered PICC_RET_NOT_READY (queue full, no memory) */
+    uint32  processed;          /**< Requests handled by the worker */
+    uint16  depth;              /**< Currently queued requests */
+    uint16  maxDepth;           /**< Peak queued requests */
+    uint32  totalWaitTicks;     /**< Sum of queueing delays (queued to handler start) */
+    uint32  maxWaitTicks;       /**< Largest queueing delay */
+    uint32  totalRunTicks;      /**< Sum of handler run times (incl. response send) */
+    uint32  maxRunTicks;        /**< Largest handler run time */
+} PICC_ServiceWorkerStats_t;
+
+/**
+ * @brief Request pipe configuration (Client role)
+ */
+typedef struct {
+    uint8                   window;      /**< Maximum outstanding requests (1..PICC_PIPE_MAX_WINDOW) */
+    boolean                 inOrder;     /**< TRUE: completions delivered in request order */
+    PICC_MethodType_e       type;        /**< WITH_RESPONSE or NO_RETURN_WITH_ACK */
+    PICC_RequestConfig_t    request;     /**< Timeout/retries, completion callback (required), flags */
+} PICC_PipeConfig_t;
+
+/**
+ * @brief Request pipe statistics
+ */
+typedef struct {
+    uint32  sent;               /**< Requests sent */
+    uint32  completed;          /**< Completions delivered (any status) */
+    uint32  windowFull;         /**< PICC_ServicePipeRequest() calls refused, window full */
+    uint32  notReady;           /**< PICC_RET_NOT_READY responses (limit lowered) */
+    uint32  reordered;          /**< Completions held back for in-order delivery */
+    uint32  reorderFailures;    /**< Completions delivered out of order (no memory to hold them) */
+    uint8   outstanding;        /**< Current outstanding requests */
+    uint8   maxOutstanding;     /**< Peak outstanding requests */
+    uint8   limit;              /**< Current window limit */
+    uint8   serverLimit;        /**< Limit advertised by the server (window if none) */
+} PICC_PipeStats_t;
+
 /*==================================================================================================
  *                                         Service Registration Limits
  *==================================================================================================*/
 
 /** Maximum number of registered Event handlers */
-#define PICC_MAX_EVENT_HANDLERS     (4U)
+#define PICC_MAX_EVENT_HANDLERS     (32U)
 
 /** Maximum number of registered Method handlers */
-#define PICC_MAX_METHOD_HANDLERS    (4U)
+#define PICC_MAX_METHOD_HANDLERS    (32U)
+
+/** Maximum number of ProviderIDs with per-ID handlers (per handler kind) */
+#define PICC_MAX_ID_TABLES          (8U)
+
+/** Handler for any MethodID/EventID of a provider */
+#define PICC_SERVICE_ANY_ID         (PICC_INVALID_ID)
+
+/** Maximum number of outstanding Method requests */
+#define PICC_MAX_PENDING_REQUESTS   (16U)
+
+/** Request data kept for retransmission (longer requests are not retried) */
+#define PICC_REQUEST_RETRY_DATA_SIZE (64U)
+
+/** Default response timeout (ms) */
+#define PICC_REQUEST_TIMEOUT_MS     (100U)
+
+/** Maximum number of open request pipes */
+#define PICC_MAX_PIPES              (4U)
+
+/** Maximum request pipe window */
+#define PICC_PIPE_MAX_WINDOW        (8U)
+
+/** Number of service worker tasks (PICC_ServiceWorkerTask) */
+#ifndef PICC_SERVICE_WORKER_NUM
+#define PICC_SERVICE_WORKER_NUM     (2U)
+#endif
+
+/** Maximum number of services handled by workers */
+#define PICC_MAX_WORKER_SERVICES    (4U)
+
+/** Queued Method requests per service */
+#ifndef PICC_SERVICE_WORKER_QUEUE_DEPTH
+#define PICC_SERVICE_WORKER_QUEUE_DEPTH (8U)
+#endif
+
+/** Handler registration flags */
+#define PICC_HANDLER_FLAG_NONE      (0x00U)
+
+/**
+ * Lightweight handler: short and never blocks. May be called directly from
+ * the IPCF receive callback (softirq task) when direct Rx processing is on,
+ * otherwise from the Rx task like any other handler.
+ */
+#define PICC_HANDLER_FLAG_DIRECT    (0x01U)
 
 /*==================================================================================================
  *                                         Function Declarations - Internal Init (called by PICC_Init)
@@ -143,6 +299,129 @@ sint8 PICC_ServiceResponseSend(uint8 consumerId, uint8 methodId,
                                const uint8 *data, uint16 len,
                                uint8 instanceId, uint8 channelId);
 
+/**
+ * @brief Send Method request tracked until its response (Client role)
+ * 
+ * The request is kept in the outstanding-request table keyed by
+ * (providerId, methodId, sessionId) until the response (WITH_RESPONSE) or
+ * ACK (NO_RETURN_WITH_ACK) arrives, the timeout expires after all retries,
+ * or it is cancelled. Retries reuse the session ID and need
+ * len <= PICC_REQUEST_RETRY_DATA_SIZE.
+ * NO_RETURN_WITHOUT_ACK requests are sent but not tracked.
+ * 
+ * @param[in] providerId Service provider ID
+ * @param[in] methodId   Method ID
+ * @param[in] data       Request data
+ * @param[in] len        Request data length
+ * @param[in] type       Method type
+ * @param[in] config     Timeout/retry/callback configuration
+ * @param[in] instanceId IPCF instance ID
+ * @param[in] channelId  IPCF channel ID
+ * @return Session ID (>0), returns 0 on failure
+ */
+uint8 PICC_ServiceRequestAsync(uint8 providerId, uint8 methodId,
+                               const uint8 *data, uint16 len,
+                               PICC_MethodType_e type,
+                               const PICC_RequestConfig_t *config,
+                               uint8 instanceId, uint8 channelId);
+
+/**
+ * @brief Cancel an outstanding request (callback called with CANCELLED)
+ * 
+ * @param[in] providerId Service provider ID
+ * @param[in] methodId   Method ID
+ * @param[in] sessionId  Session ID returned by PICC_ServiceRequestAsync()
+ * @return 0 on success, non-zero if no such outstanding request
+ */
+sint8 PICC_ServiceRequestCancel(uint8 providerId, uint8 methodId, uint8 sessionId);
+
+/**
+ * @brief Open a request pipe to one Method of a provider (Client role)
+ * 
+ * A pipe keeps up to a window of requests in flight instead of waiting for
+ * each response, so bulk request/response traffic is no longer bounded by
+ * the round-trip time. Every request is tracked like
+ * PICC_ServiceRequestAsync(); config->request.callback gets each completion,
+ * in request order if config->inOrder (later completions are held in the
+ * scratch arena until the earlier ones are delivered).
+ * 
+ * The window limit follows the server: a PICC_RET_NOT_READY response (server
+ * queue full) lowers it to the requests still outstanding, and it grows back
+ * by one after a limit's worth of successful completions, up to the limit set
+ * with PICC_ServicePipeSetLimit().
+ * 
+ * @param[in] providerId Service provider ID
+ * @param[in] methodId   Method ID
+ * @param[in] config     Pipe configuration
+ * @param[in] instanceId IPCF instance ID
+ * @param[in] channelId  IPCF channel ID
+ * @return Pipe (>= 0), negative on failure
+ */
+sint8 PICC_ServicePipeOpen(uint8 providerId, uint8 methodId, const PICC_PipeConfig_t *config,
+                           uint8 instanceId, uint8 channelId);
+
+/**
+ * @brief Send a request on a pipe
+ * 
+ * @param[in] pipe Pipe from PICC_ServicePipeOpen()
+ * @param[in] data Request data
+ * @param[in] len  Request data length
+ * @return Session ID (>0), 0 if the window is full (retry after a completion) or on failure
+ */
+uint8 PICC_ServicePipeRequest(sint8 pipe, const uint8 *data, uint16 len);
+
+/**
+ * @brief Set the window limit advertised by the server
+ * 
+ * @param[in] pipe  Pipe from PICC_ServicePipeOpen()
+ * @param[in] limit Outstanding requests the server accepts (clamped to 1..window)
+ * @return 0 on success, non-zero on failure
+ */
+sint8 PICC_ServicePipeSetLimit(sint8 pipe, uint8 limit);
+
+/**
+ * @brief Close a pipe
+ * 
+ * Outstanding requests are cancelled (callback called with CANCELLED).
+ * Must not be called while another task sends on the pipe.
+ * 
+ * @param[in] pipe Pipe from PICC_ServicePipeOpen()
+ * @return 0 on success, non-zero on failure
+ */
+sint8 PICC_ServicePipeClose(sint8 pipe);
+
+/**
+ * @brief Get request pipe statistics
+ * 
+ * @param[in]  pipe  Pipe from PICC_ServicePipeOpen()
+ * @param[out] stats Statistics copy
+ * @return 0 on success, non-zero on failure
+ */
+sint8 PICC_ServiceGetPipeStats(sint8 pipe, PICC_PipeStats_t *stats);
+
+/**
+ * @brief Outstanding request timeouts/retries - called from PICC periodic task (10ms)
+ */
+void PICC_ServiceRequestProcess(void);
+
+/**
+ * @brief Get number of outstanding requests
+ */
+uint16 PICC_ServiceGetInFlight(void);
+
+/**
+ * @brief Get outstanding request statistics
+ * 
+ * @param[out] stats Statistics copy
+ * @return 0 on success, non-zero on failure
+ */
+sint8 PICC_ServiceGetRequestStats(PICC_RequestStats_t *stats);
+
+/**
+ * @brief Reset outstanding request statistics (inFlight is kept)
+ */
+void PICC_ServiceResetRequestStats(void);
+
 /**
  * @brief Process received message (called by middleware)
  * 
@@ -168,6 +447,30 @@ sint8 PICC_ServiceProcessMessage(const PICC_MsgHeader_t *header,
  */
 sint8 PICC_RegisterEventHandler(uint8 providerId, PICC_EventCallback_t callback);
 
+/**
+ * @brief Register Event receive handler for one EventID of a provider
+ * 
+ * Handlers of an EventID take precedence over provider-wide handlers.
+ * 
+ * @param[in] providerId Target ProviderID
+ * @param[in] eventId    EventID, or PICC_SERVICE_ANY_ID (same as PICC_RegisterEventHandler)
+ * @param[in] callback   Callback function
+ * @return 0 on success, non-zero on failure
+ */
+sint8 PICC_RegisterEventIdHandler(uint8 providerId, uint8 eventId, PICC_EventCallback_t callback);
+
+/**
+ * @brief Register Event receive handler for one EventID of a provider, with flags
+ * 
+ * @param[in] providerId Target ProviderID
+ * @param[in] eventId    EventID, or PICC_SERVICE_ANY_ID
+ * @param[in] callback   Callback function
+ * @param[in] flags      PICC_HANDLER_FLAG_xxx
+ * @return 0 on success, non-zero on failure
+ */
+sint8 PICC_RegisterEventIdHandlerEx(uint8 providerId, uint8 eventId,
+                                    PICC_EventCallback_t callback, uint8 flags);
+
 /**
  * @brief Register Method request handler (Server role, supports multi-module registration)
  * 
@@ -177,6 +480,45 @@ sint8 PICC_RegisterEventHandler(uint8 providerId, PICC_EventCallback_t callback)
  */
 sint8 PICC_RegisterMethodHandler(uint8 localProviderId, PICC_MethodCallback_t callback);
 
+/**
+ * @brief Register Method request handler for one MethodID of a provider
+ * 
+ * Handler of a MethodID takes precedence over the provider-wide handler.
+ * 
+ * @param[in] localProviderId Local module's ProviderID
+ * @param[in] methodId        MethodID, or PICC_SERVICE_ANY_ID (same as PICC_RegisterMethodHandler)
+ * @param[in] callback        Callback function
+ * @return 0 on success, non-zero on failure
+ */
+sint8 PICC_RegisterMethodIdHandler(uint8 localProviderId, uint8 methodId,
+                                   PICC_MethodCallback_t callback);
+
+/**
+ * @brief Register Method request handler for one MethodID of a provider, with flags
+ * 
+ * @param[in] localProviderId Local module's ProviderID
+ * @param[in] methodId        MethodID, or PICC_SERVICE_ANY_ID
+ * @param[in] callback        Callback function
+ * @param[in] flags           PICC_HANDLER_FLAG_xxx
+ * @return 0 on success, non-zero on failure
+ */
+sint8 PICC_RegisterMethodIdHandlerEx(uint8 localProviderId, uint8 methodId,
+                                     PICC_MethodCallback_t callback, uint8 flags);
+
+/**
+ * @brief Declare the largest response data of a registered Method handler
+ * 
+ * A handler gets a response buffer of PICC_MAX_PAYLOAD_SIZE bytes from the
+ * scratch arena unless declared smaller here; with 0 no buffer is taken and
+ * rspData is NULL. A longer response is dropped and answered PICC_RET_NOT_OK.
+ * 
+ * @param[in] localProviderId Local module's ProviderID
+ * @param[in] methodId        MethodID the handler was registered for, or PICC_SERVICE_ANY_ID
+ * @param[in] maxRspLen       Largest response data length (0 = no response data)
+ * @return 0 on success, non-zero if the handler is not registered or maxRspLen is too large
+ */
+sint8 PICC_SetMethodResponseSize(uint8 localProviderId, uint8 methodId, uint16 maxRspLen);
+
 /**
  * @brief Register Method response handler (Client role)
  * 
@@ -185,6 +527,66 @@ sint8 PICC_RegisterMethodHandler(uint8 localProviderId, PICC_MethodCallback_t ca
  */
 sint8 PICC_RegisterResponseHandler(PICC_ResponseCallback_t callback);
 
+/**
+ * @brief Register Method response handler (Client role), with flags
+ * 
+ * @param[in] callback Callback function
+ * @param[in] flags    PICC_HANDLER_FLAG_xxx
+ * @return 0 on success, non-zero on failure
+ */
+sint8 PICC_RegisterResponseHandlerEx(PICC_ResponseCallback_t callback, uint8 flags);
+
+/**
+ * @brief Check whether a received message only runs lightweight handlers
+ * 
+ * TRUE if every handler the message would be routed to (event, method,
+ * request completion or response handler) is flagged PICC_HANDLER_FLAG_DIRECT,
+ * or the message is handled by the middleware alone.
+ * 
+ * @param[in] header Message header
+ * @return TRUE if the message may be processed in the IPCF receive callback
+ */
+boolean PICC_ServiceIsDirect(const PICC_MsgHeader_t *header);
+
+/**
+ * @brief Handle Method requests of a provider on a worker task
+ * 
+ * Requests of the provider are copied to its own queue and handled in
+ * order by worker task @p worker, which also sends the Response. The Rx
+ * task only queues them, so a slow handler no longer delays other services
+ * or ACK/Response processing. A request that finds the queue full (or no
+ * arena memory for its data) is answered PICC_RET_NOT_READY at once.
+ * Until the worker task runs, requests are handled on the Rx task as before.
+ * Each worker runs at its own priority, set by the application when it
+ * creates the task; services are assigned to the worker of their priority.
+ * 
+ * @param[in] localProviderId Local module's ProviderID
+ * @param[in] worker          Worker index (< PICC_SERVICE_WORKER_NUM)
+ * @return 0 on success, non-zero on failure
+ */
+sint8 PICC_ServiceSetWorker(uint8 localProviderId, uint8 worker);
+
+/**
+ * @brief Get worker queue statistics of a provider
+ * 
+ * @param[in]  localProviderId Local module's ProviderID
+ * @param[out] stats           Statistics copy
+ * @return 0 on success, non-zero if the provider is not handled by a worker
+ */
+sint8 PICC_ServiceGetWorkerStats(uint8 localProviderId, PICC_ServiceWorkerStats_t *stats);
+
+/**
+ * @brief Service worker task
+ * 
+ * Woken by task notification when a request is queued to one of its
+ * services; takes one request per service and round so a busy service
+ * does not starve the others. Created by the application, one task per
+ * worker at the priority of its services.
+ * 
+ * @param[in] pvParameters Worker index (cast from uintptr)
+ */
+void PICC_ServiceWorkerTask(void *pvParameters);
+
 /**
  * @brief Send Event notification
  * 
@@ -5,6 +5,20 @@
  * Implements message stacking functionality:
  * - Send on 10ms period or when buffer is full
  * - Add Counter(2B) + CRC16(2B) before sending
+ * - Pack messages directly into the IPCF buffer (zero-copy), falling back to
+ *   a scratch arena block when no IPCF buffer is available
+ * - Adaptive batching: flush at once when idle, at a byte threshold or at a
+ *   per-message deadline (PICC_StackFlushTask), 10ms period as fallback
+ * - Priority lanes: high lane messages (selected per ProviderID/MethodID)
+ *   bypass aggregation and are sent at once as their own frame
+ * - Lock-free append: fetch-add reservation + commit counter per window, the
+ *   message copy runs with interrupts enabled
+ * - Rx sequence tracking of the received frame counter (gaps, duplicates,
+ *   late frames, wraps) with loss callback and duplicate drop policy
+ * - Heartbeat flags in the frame flag byte; any valid received frame is
+ *   reported to the heartbeat layer as sign of life
+ * - Last-value-wins coalescing of selected events: overwrite in place,
+ *   uncommitted meanwhile so a flush waits for the new value
  *
  * Copyright 2024 NXP
  * All Rights Reserved.
@@ -17,6 +31,7 @@ extern "C" {
 #include "picc_stack.h"
 #include "picc_heartbeat.h"
 #include "picc_trace.h" /* For TX/RX debug trace */
+#include "picc_arena.h" /* For fallback window buffers */
 #include "Picc_main.h"    /* For HANDLE_ERROR */
 #include "ipc-shm.h"
 #include "ipcf_Ip_Cfg_Defines.h"  /* For IPCF_INSTANCE0 */
@@ -31,23 +46,87 @@ extern "C" {
 /** Maximum supported Stack channel count */
 #define PICC_STACK_MAX_INSTANCES (2U)
 
+/** Flush task retry delay when a due frame could not be sent (ticks) */
+#define PICC_STACK_FLUSH_RETRY_TICKS (1U)
+
+/** Window reservation word: closed flag (no reservation possible) */
+#define PICC_STACK_WINDOW_CLOSED     (0x80000000UL)
+
+/** Window reservation word: reserved bytes */
+#define PICC_STACK_WINDOW_SIZE_MASK  (0x7FFFFFFFUL)
+
+/** Append attempts before giving up (window reopened / swapped meanwhile) */
+#define PICC_STACK_APPEND_MAX_TRIES  (6U)
+
+/** Weight of the last frame in the frame size estimate (1 / 2^shift) */
+#define PICC_STACK_FRAME_ESTIMATE_SHIFT (2U)
+
+#if defined(__GNUC__)
+/* LDREX/STREX based on Cortex-M7, interrupts stay enabled */
+#define PICC_STACK_ATOMIC_LOAD(ptr)            __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define PICC_STACK_ATOMIC_CAS(ptr, exp, val)   __atomic_compare_exchange_n((ptr), (exp), (val), 0, \
+                                                   __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#define PICC_STACK_ATOMIC_ADD(ptr, val)        ((void)__atomic_add_fetch((ptr), (val), __ATOMIC_RELEASE))
+#define PICC_STACK_ATOMIC_OR(ptr, val)         ((void)__atomic_fetch_or((ptr), (val), __ATOMIC_ACQ_REL))
+#define PICC_STACK_ATOMIC_XCHG(ptr, val)       __atomic_exchange_n((ptr), (val), __ATOMIC_ACQ_REL)
+#else
+#error "PICC stack: lock-free append requires GCC __atomic builtins"
+#endif
+
+#if (PICC_ARENA_BLOCK_SIZE(PICC_STACK_SHM_PAYLOAD_MAX_SIZE) > PICC_ARENA_QUOTA_STACK)
+#error "PICC_ARENA_QUOTA_STACK: too small for a fallback window"
+#endif
+
 /** Stack instance structure */
 typedef struct {
     PICC_StackConfig_t  config;       /**< Configuration */
     PICC_StackContext_t context;      /**< Context */
+    PICC_StackMetrics_t metrics;      /**< Batching metrics */
+    PICC_StackRxStats_t rxStats;      /**< Rx sequence statistics */
     boolean             initialized;  /**< Whether initialized */
 } PICC_StackInstance_t;
 
+/** Lane selection entry */
+typedef struct {
+    uint8             providerId;   /**< ProviderID */
+    uint8             methodId;     /**< MethodID or PICC_STACK_LANE_ANY_METHOD */
+    PICC_StackLane_e  lane;         /**< Selected lane */
+    boolean           isUsed;       /**< Is slot in use */
+} PICC_StackLaneEntry_t;
+
+/** Coalescing selection entry */
+typedef struct {
+    uint8             providerId;   /**< ProviderID */
+    uint8             eventId;      /**< EventID */
+    boolean           isUsed;       /**< Is slot in use */
+    volatile uint32   coalesced;    /**< Events replaced in place (all channels) */
+} PICC_StackCoalesceEntry_t;
+
 /** Stack instance array (index 0=Channel1, index 1=Channel2) */
 static PICC_StackInstance_t g_stackInstances[PICC_STACK_MAX_INSTANCES];
 
 /** Message receive callback (globally shared) */
 static PICC_StackMsgCallback_t g_stackMsgCallback = NULL;
 
+/** Rx frame loss callback (globally shared) */
+static PICC_StackRxLossCallback_t g_stackRxLossCallback = NULL;
+
+/** Flush task handle (NULL until PICC_StackFlushTask runs) */
+static TaskHandle_t g_stackFlushTask = NULL;
+
+/** Lane selections (shared by all channels) */
+static PICC_StackLaneEntry_t g_stackLaneMap[PICC_STACK_LANE_MAP_SIZE];
+
+/** Coalescing selections (shared by all channels, index = context coalesce slot) */
+static PICC_StackCoalesceEntry_t g_stackCoalesceMap[PICC_STACK_COALESCE_MAP_SIZE];
+
 /*==================================================================================================
  *                                         Private Functions
  *==================================================================================================*/
 
+static void PICC_StackCreditCallback(void *cbArg, const uint8 instance,
+                                     uint8 chanId, uint32 credits);
+
 /**
  * @brief Get Stack instance
  * 
@@ -68,21 +147,422 @@ static PICC_StackInstance_t* PICC_GetStackInstance(uint8 channelId)
 }
 
 /**
- * @brief Actually send stacked data (for specified channel)
+ * @brief IPCF Tx credits replenished callback (IPCF Rx softirq or credit query context)
  * 
- * @param channelId Channel ID
- * @return 0 on success, non-zero on failure
+ * Armed by a failed ipc_shm_acquire_buf(), only records the event.
  */
-static sint8 PICC_StackDoSendForChannel(uint8 channelId)
+static void PICC_StackCreditCallback(void *cbArg, const uint8 instance,
+                                     uint8 chanId, uint32 credits)
+{
+    PICC_StackInstance_t *inst = (PICC_StackInstance_t *)cbArg;
+
+    (void)instance;
+    (void)chanId;
+    (void)credits;
+
+    if (inst != NULL) {
+        inst->context.creditEvent = TRUE;
+    }
+}
+
+/**
+ * @brief Get CRC enable flag (frame byte 0) of a stack instance
+ */
+static uint8 PICC_StackCrcEnableFlag(const PICC_StackInstance_t *inst)
+{
+    return (inst->config.crcEnabled == PICC_STACK_CRC_ENABLED) ?
+           PICC_STACK_CRC_ENABLED : PICC_STACK_CRC_DISABLED;
+}
+
+/**
+ * @brief Get the window producers append to
+ */
+static PICC_StackWindow_t* PICC_StackActiveWindow(PICC_StackInstance_t *inst)
+{
+    return &inst->context.window[inst->context.activeIdx];
+}
+
+/**
+ * @brief Get the window being transmitted / waiting for retransmission
+ */
+static PICC_StackWindow_t* PICC_StackTxWindow(PICC_StackInstance_t *inst)
+{
+    return &inst->context.window[inst->context.activeIdx ^ 1U];
+}
+
+/**
+ * @brief Get payload capacity of a stack window
+ * 
+ * Size of the attached IPCF buffer, or of the largest IPCF buffer of the
+ * channel for a fallback buffer window (a fallback frame always fits into
+ * it), 0 for a window without buffer.
+ */
+static uint32 PICC_StackWindowCapacity(const PICC_StackWindow_t *win)
+{
+    return win->capacity;
+}
+
+/**
+ * @brief Get maximum payload size of a frame on a channel
+ */
+static uint32 PICC_StackMaxPayload(const PICC_StackInstance_t *inst)
+{
+    return (uint32)inst->context.maxFrameSize - PICC_STACK_OVERHEAD_SIZE;
+}
+
+/**
+ * @brief Get IPCF buffer size to request for a window holding used bytes
+ * 
+ * Room for the expected frame on top of the stacked bytes, so a typical
+ * batch fits without moving to a larger buffer, but a lone ACK does not tie
+ * up the largest pool buffer.
+ */
+static uint32 PICC_StackFrameRequest(const PICC_StackInstance_t *inst, uint32 used)
+{
+    uint32 size = used + (uint32)inst->context.frameEstimate + PICC_STACK_OVERHEAD_SIZE;
+
+    if (size > (uint32)inst->context.maxFrameSize) {
+        size = inst->context.maxFrameSize;
+    }
+    return size;
+}
+
+/**
+ * @brief Acquire an IPCF buffer of at least size bytes (in critical section)
+ * 
+ * @param inst     Stack instance
+ * @param size     Requested frame size
+ * @param capacity [OUT] Payload capacity of the buffer
+ * @return IPCF buffer, NULL if remote is not ready or no buffer is free
+ */
+static uint8* PICC_StackAcquireFrame(const PICC_StackInstance_t *inst, uint32 size,
+                                     uint32 *capacity)
+{
+    uint8 *buf = NULL;
+    uint32 bufSize;
+
+    if (ipc_shm_is_remote_ready(IPCF_INSTANCE0) == 0) {
+        buf = (uint8 *)ipc_shm_acquire_buf(IPCF_INSTANCE0, inst->config.channelId, size);
+    }
+    if (buf != NULL) {
+        /* Pool buffer may be larger than requested: use all of it */
+        bufSize = ipc_shm_buf_size(IPCF_INSTANCE0, inst->config.channelId, buf);
+        if ((bufSize < size) || (bufSize > (uint32)inst->context.maxFrameSize)) {
+            bufSize = size;
+        }
+        *capacity = bufSize - PICC_STACK_OVERHEAD_SIZE;
+    }
+    return buf;
+}
+
+/**
+ * @brief Get stacked bytes reserved in a stack window
+ */
+static uint32 PICC_StackWindowUsed(const PICC_StackWindow_t *win)
+{
+    return win->reserved & PICC_STACK_WINDOW_SIZE_MASK;
+}
+
+/**
+ * @brief Attach a buffer to an empty stack window (in critical section)
+ * 
+ * Acquires the IPCF buffer up front so messages are packed straight into
+ * shared memory and the frame is not copied again at send time. The buffer
+ * is the smallest one fitting the first message and the expected frame.
+ * If remote is not ready or no IPCF buffer is free, a scratch arena block is
+ * used instead - not an error. A window that already has a buffer is kept.
+ * 
+ * @param inst     Stack instance
+ * @param win      Empty window
+ * @param firstLen Length of the first message
+ */
+static void PICC_StackAttachBuffer(const PICC_StackInstance_t *inst, PICC_StackWindow_t *win,
+                                   uint32 firstLen)
+{
+    uint32 capacity = 0U;
+
+    if ((win->shmBuf != NULL) || (win->buffer != NULL)) {
+        return;
+    }
+
+    win->shmBuf = PICC_StackAcquireFrame(inst, PICC_StackFrameRequest(inst, firstLen), &capacity);
+    if (win->shmBuf == NULL) {
+        capacity = PICC_StackMaxPayload(inst);
+        win->buffer = (uint8 *)PICC_ArenaAlloc(capacity, PICC_ARENA_OWNER_STACK);
+        if (win->buffer == NULL) {
+            capacity = 0U;
+        }
+    }
+    win->capacity = (uint16)capacity;
+}
+
+/**
+ * @brief Move a full zero-copy window to a larger buffer (in critical section)
+ * 
+ * Keeps batching instead of flushing a small buffer: the stacked bytes are
+ * copied into a larger IPCF buffer, or into an arena block (largest frame)
+ * when none is free, and the small buffer is given back to IPCF. Only done
+ * while no producer copies into the window (committed == reserved), so no
+ * reservation or pending coalesce copy points into the old buffer; offsets
+ * stay the same. The copy is bounded by the capacity of the smaller pools.
+ * 
+ * @param inst Stack instance
+ * @param win  Active window
+ * @param len  Length of the message that did not fit
+ * @return TRUE if the window now has room for len more bytes
+ */
+static boolean PICC_StackGrowWindow(PICC_StackInstance_t *inst, PICC_StackWindow_t *win,
+                                    uint32 len)
+{
+    uint32 used = PICC_StackWindowUsed(win);
+    uint32 capacity = 0U;
+    uint8 *shmBuf;
+    uint8 *block = NULL;
+    uint8 *dst;
+    uint32 i;
+
+    if ((win->shmBuf == NULL) || ((win->reserved & PICC_STACK_WINDOW_CLOSED) != 0U) ||
+        (win->committed != used) || ((used + len) > PICC_StackMaxPayload(inst))) {
+        return FALSE;
+    }
+    if ((used + len) <= PICC_StackWindowCapacity(win)) {
+        return TRUE;  /* Grown by another producer meanwhile */
+    }
+
+    shmBuf = PICC_StackAcquireFrame(inst, PICC_StackFrameRequest(inst, used + len), &capacity);
+    if ((shmBuf != NULL) && ((used + len) > capacity)) {
+        (void)ipc_shm_return_buf(IPCF_INSTANCE0, inst->config.channelId, shmBuf);
+        shmBuf = NULL;
+    }
+    if (shmBuf != NULL) {
+        dst = &shmBuf[PICC_STACK_CRC_ENABLE_SIZE];
+    } else {
+        capacity = PICC_StackMaxPayload(inst);
+        block = (uint8 *)PICC_ArenaAlloc(capacity, PICC_ARENA_OWNER_STACK);
+        if (block == NULL) {
+            return FALSE;
+        }
+        dst = block;
+    }
+
+    for (i = 0U; i < used; i++) {
+        dst[i] = win->shmBuf[PICC_STACK_CRC_ENABLE_SIZE + i];
+    }
+    (void)ipc_shm_return_buf(IPCF_INSTANCE0, inst->config.channelId, win->shmBuf);
+    win->shmBuf = shmBuf;
+    win->buffer = block;
+    win->capacity = (uint16)capacity;
+    inst->metrics.windowGrows++;
+    return TRUE;
+}
+
+/**
+ * @brief Open an empty stack window for the first message of a frame
+ * 
+ * Must be called in critical section with a closed, empty window.
+ * 
+ * @param inst     Stack instance
+ * @param win      Closed, empty active window
+ * @param firstLen Length of the first message
+ */
+static void PICC_StackOpenWindow(const PICC_StackInstance_t *inst, PICC_StackWindow_t *win,
+                                 uint32 firstLen)
+{
+    PICC_StackAttachBuffer(inst, win, firstLen);
+
+    win->committed = 0U;
+    win->msgCount = 0U;
+    win->openSeq++;      /* Coalescing slots of the previous frame are stale */
+    win->reserved = 0U;  /* Open: reservations allowed from now on */
+}
+
+/**
+ * @brief Reserve room for a message in a stack window (lock-free)
+ * 
+ * Fetch-add on the reservation word, done as compare-and-swap so the
+ * capacity and the closed flag set by a flush are honored atomically.
+ * 
+ * @param inst   Stack instance
+ * @param win    Active window
+ * @param len    Bytes to reserve
+ * @param offset Reserved offset in window data
+ * @return 0 on success, -1 if window is closed, -2 if window is full (or has no buffer)
+ */
+static sint8 PICC_StackReserve(PICC_StackInstance_t *inst, PICC_StackWindow_t *win,
+                               uint32 len, uint32 *offset)
+{
+    uint32 cur;
+
+    cur = PICC_STACK_ATOMIC_LOAD(&win->reserved);
+    for (;;) {
+        if ((cur & PICC_STACK_WINDOW_CLOSED) != 0U) {
+            return -1;
+        }
+        if ((cur + len) > PICC_StackWindowCapacity(win)) {
+            return -2;
+        }
+        if (PICC_STACK_ATOMIC_CAS(&win->reserved, &cur, cur + len)) {
+            break;
+        }
+        /* Another producer reserved meanwhile, cur reloaded by CAS */
+        PICC_STACK_ATOMIC_ADD(&inst->metrics.reserveRetries, 1U);
+    }
+
+    *offset = cur;
+    return 0;
+}
+
+/**
+ * @brief Get write position of stacked data in a stack window
+ */
+static uint8* PICC_StackWindowData(PICC_StackWindow_t *win)
+{
+    if (win->shmBuf != NULL) {
+        return &win->shmBuf[PICC_STACK_CRC_ENABLE_SIZE];
+    }
+    return win->buffer;
+}
+
+/**
+ * @brief Record batching metrics of a sent frame (in critical section)
+ * 
+ * @param inst     Stack instance
+ * @param reason   Flush reason
+ * @param msgCount Messages in frame
+ * @param bytes    Stacked bytes in frame
+ * @param openTick Tick the oldest message of the frame was added
+ */
+static void PICC_StackUpdateMetrics(PICC_StackInstance_t *inst, PICC_StackFlushReason_e reason,
+                                    uint16 msgCount, uint16 bytes, uint32 openTick)
+{
+    PICC_StackMetrics_t *m = &inst->metrics;
+    TickType_t now = xTaskGetTickCount();
+    uint32 delay = (uint32)(now - (TickType_t)openTick);
+
+    m->frames++;
+    m->messages += msgCount;
+    m->bytes += bytes;
+    if (msgCount > m->maxBatchMsgs) {
+        m->maxBatchMsgs = msgCount;
+    }
+    if (bytes > m->maxBatchBytes) {
+        m->maxBatchBytes = bytes;
+    }
+    m->totalDelayTicks += delay;
+    if (delay > m->maxDelayTicks) {
+        m->maxDelayTicks = delay;
+    }
+    m->flushCount[reason]++;
+
+    inst->context.lastTxTick = (uint32)now;
+}
+
+/**
+ * @brief Build and transmit the frame of a swapped-out window
+ * 
+ * Runs outside critical section (window owned by the caller via txBusy),
+ * only the IPCF driver calls are serialized with producers opening
+ * zero-copy windows on the same channel.
+ * 
+ * @param inst    Stack instance
+ * @param win     Window to transmit
+ * @param counter Tx counter of the frame
+ * @return 0 on success, -1 if no IPCF buffer (data kept), -2 on IPCF Tx error
+ */
+static sint8 PICC_StackTransmitWindow(PICC_StackInstance_t *inst, PICC_StackWindow_t *win,
+                                      uint16 counter)
 {
-    PICC_StackInstance_t *inst;
     uint8 *shmBuf;
     uint16 totalLen;
     uint16 crc;
     uint32 i;
     sint8 err;
-    uint8 crcEnableFlag;
     uint16 counterOffset;
+    uint8 hbFlags;
+
+    /* Calculate total length: CRC_Enable(1B) + data + Counter(2B) + CRC16(2B) */
+    totalLen = PICC_STACK_CRC_ENABLE_SIZE + win->usedSize +
+               PICC_STACK_COUNTER_SIZE + PICC_STACK_CRC_SIZE;
+
+    if (win->shmBuf != NULL) {
+        /* Zero-copy window: stacked packets already in IPCF buffer */
+        shmBuf = win->shmBuf;
+    } else {
+        /* Get IPCF send buffer */
+        taskENTER_CRITICAL();
+        shmBuf = (uint8 *)ipc_shm_acquire_buf(IPCF_INSTANCE0, inst->config.channelId, totalLen);
+        taskEXIT_CRITICAL();
+        if (shmBuf == NULL) {
+            /* IPCF buffer temporarily unavailable (all buffers in flight).
+             * Keep data for retry - do NOT clear.
+             */
+            return -1;  /* Signal failure, but data preserved for retry */
+        }
+
+        /* [Bytes 1~N] Copy stacked protocol packets */
+        for (i = 0U; i < win->usedSize; i++) {
+            shmBuf[PICC_STACK_CRC_ENABLE_SIZE + i] = win->buffer[i];
+        }
+    }
+
+    /* [Byte 0] Fill CRC enable flag + pending heartbeat flags */
+    hbFlags = PICC_STACK_ATOMIC_XCHG(&inst->context.hbFlags, 0U);
+    shmBuf[0] = PICC_StackCrcEnableFlag(inst) | hbFlags;
+
+    /* [Bytes N+1, N+2] Fill Counter (big-endian) */
+    counterOffset = PICC_STACK_CRC_ENABLE_SIZE + win->usedSize;
+    shmBuf[counterOffset]      = (uint8)(counter >> 8U);
+    shmBuf[counterOffset + 1U] = (uint8)(counter & 0xFFU);
+
+    /* Calculate CRC16 (on CRC_Enable + data + Counter) in one pass, outside of
+     * any critical section. No running CRC: producers commit out of order,
+     * coalescing rewrites committed events and byte 0 is only final here */
+    crc = PICC_CRC16(shmBuf, (uint32)counterOffset + PICC_STACK_COUNTER_SIZE);
+
+    /* [Last 2 Bytes] Fill CRC16 (big-endian) */
+    shmBuf[counterOffset + PICC_STACK_COUNTER_SIZE]      = (uint8)(crc >> 8U);
+    shmBuf[counterOffset + PICC_STACK_COUNTER_SIZE + 1U] = (uint8)(crc & 0xFFU);
+
+    /* [DEBUG] Record TX data for TRACE32 observation (before send attempt) */
+    PICC_TraceTx(inst->config.channelId, shmBuf, totalLen);
+
+    /* Send */
+    taskENTER_CRITICAL();
+    err = ipc_shm_tx(IPCF_INSTANCE0, inst->config.channelId, shmBuf, totalLen);
+    if ((err != 0) && (shmBuf != win->shmBuf)) {
+        /* Zero-copy window keeps its IPCF buffer and data for retry */
+        (void)ipc_shm_return_buf(IPCF_INSTANCE0, inst->config.channelId, shmBuf);
+    }
+    taskEXIT_CRITICAL();
+
+    if (err != 0) {
+        PICC_STACK_ATOMIC_OR(&inst->context.hbFlags, hbFlags);  /* Go with the retry */
+        HANDLE_ERROR(-32);  /* Stack: IPCF TX failed */
+        return -2;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Actually send stacked data (for specified channel)
+ * 
+ * Ping-pong: the active window is swapped out under critical section (a
+ * pointer swap) and transmitted outside of it, so producers keep appending
+ * to the other window meanwhile. A frame that could not be sent stays in the
+ * swapped-out window and is retried first.
+ * 
+ * @param channelId Channel ID
+ * @param reason    Flush reason (for metrics)
+ * @return 0 on success, non-zero on failure
+ */
+static sint8 PICC_StackDoSendForChannel(uint8 channelId, PICC_StackFlushReason_e reason)
+{
+    PICC_StackInstance_t *inst;
+    PICC_StackWindow_t *win;
+    uint16 counter;
+    uint8 round;
+    sint8 ret = 0;
     
     inst = PICC_GetStackInstance(channelId);
     if (inst == NULL || inst->initialized == FALSE) {
@@ -99,94 +579,599 @@ static sint8 PICC_StackDoSendForChannel(uint8 channelId)
         return 0;  /* Return success - normal condition during startup */
     }
 
-    /* Enter critical section to protect context, avoid racing with PICC_StackAddMessage */
-    taskENTER_CRITICAL();
+    /* Round 1 may only retry a pending frame, round 2 then sends the active window */
+    for (round = 0U; round < PICC_STACK_WINDOW_NUM; round++) {
+        taskENTER_CRITICAL();
+
+        if (inst->context.txBusy != FALSE) {
+            /* Another task is transmitting on this channel, data preserved */
+            taskEXIT_CRITICAL();
+            return -1;
+        }
+
+        if (inst->context.txPending == FALSE) {
+            win = PICC_StackActiveWindow(inst);
+            if (PICC_StackWindowUsed(win) == 0U) {
+                taskEXIT_CRITICAL();
+                break;  /* No data to send */
+            }
+            /* Close: no further reservation, size of the frame is now fixed */
+            PICC_STACK_ATOMIC_OR(&win->reserved, PICC_STACK_WINDOW_CLOSED);
+            win->usedSize = (uint16)PICC_StackWindowUsed(win);
+            /* Swap: producers continue in the other (empty) window */
+            inst->context.activeIdx ^= 1U;
+            inst->context.txPending = TRUE;
+        }
+
+        win = PICC_StackTxWindow(inst);
+        if (win->committed != (uint32)win->usedSize) {
+            /* A preempted producer is still copying into the window: retry later */
+            inst->metrics.commitWaits++;
+            taskEXIT_CRITICAL();
+            ret = -1;
+            break;
+        }
+        counter = inst->context.txCounter;
+        inst->context.txBusy = TRUE;
+
+        taskEXIT_CRITICAL();
+
+        ret = PICC_StackTransmitWindow(inst, win, counter);
+
+        taskENTER_CRITICAL();
+        if (ret == 0) {
+            /* Update counter */
+            inst->context.txCounter++;
+            if (inst->context.txCounter == 0U) {
+                inst->context.txCounter = 1U;  /* Avoid zero value */
+            }
 
-    if (inst->context.usedSize == 0U) {
+            PICC_StackUpdateMetrics(inst, reason, win->msgCount, win->usedSize, win->openTick);
+            /* Expected frame size for the buffer of the next window */
+            inst->context.frameEstimate = (uint16)(inst->context.frameEstimate -
+                (inst->context.frameEstimate >> PICC_STACK_FRAME_ESTIMATE_SHIFT) +
+                (win->usedSize >> PICC_STACK_FRAME_ESTIMATE_SHIFT));
+
+            /* Clear window - IPCF buffer now owned by remote */
+            win->shmBuf = NULL;
+            PICC_ArenaFree(win->buffer);
+            win->buffer = NULL;
+            win->capacity = 0U;
+            win->usedSize = 0U;
+            win->msgCount = 0U;
+            win->committed = 0U;
+            win->reserved = PICC_STACK_WINDOW_CLOSED;
+            inst->context.txPending = FALSE;
+            inst->context.flushRequest = FALSE;
+        }
+        inst->context.txBusy = FALSE;
         taskEXIT_CRITICAL();
-        return 0;  /* No data to send */
+
+        if (ret != 0) {
+            break;
+        }
     }
 
-    /* Calculate total length: CRC_Enable(1B) + data + Counter(2B) + CRC16(2B) */
-    totalLen = PICC_STACK_CRC_ENABLE_SIZE + inst->context.usedSize + 
-               PICC_STACK_COUNTER_SIZE + PICC_STACK_CRC_SIZE;
+    return ret;
+}
+
+/**
+ * @brief Get lane of a message from its ProviderID/MethodID
+ */
+static PICC_StackLane_e PICC_StackGetLane(const uint8 *data, uint32 len)
+{
+    PICC_StackLane_e lane = PICC_STACK_LANE_NORMAL;
+    uint32 i;
+
+    if (len < PICC_HEADER_SIZE) {
+        return PICC_STACK_LANE_NORMAL;
+    }
+
+    for (i = 0U; i < PICC_STACK_LANE_MAP_SIZE; i++) {
+        if ((g_stackLaneMap[i].isUsed == FALSE) || (g_stackLaneMap[i].providerId != data[0])) {
+            continue;
+        }
+        if (g_stackLaneMap[i].methodId == data[1]) {
+            return g_stackLaneMap[i].lane;  /* Exact selection wins */
+        }
+        if (g_stackLaneMap[i].methodId == PICC_STACK_LANE_ANY_METHOD) {
+            lane = g_stackLaneMap[i].lane;
+        }
+    }
+
+    return lane;
+}
+
+/**
+ * @brief Get coalescing selection of an event message from its ProviderID/EventID
+ * 
+ * @return Selection index, -1 if the message is not coalesced
+ */
+static sint8 PICC_StackGetCoalesce(const uint8 *data, uint32 len)
+{
+    uint32 i;
+
+    if ((len < PICC_HEADER_SIZE) ||
+        ((data[4] != (uint8)PICC_MSG_NOTIFICATION_WITH_ACK) &&
+         (data[4] != (uint8)PICC_MSG_NOTIFICATION_WITHOUT_ACK))) {
+        return -1;
+    }
+
+    for (i = 0U; i < PICC_STACK_COALESCE_MAP_SIZE; i++) {
+        if ((g_stackCoalesceMap[i].isUsed != FALSE) &&
+            (g_stackCoalesceMap[i].providerId == data[0]) &&
+            (g_stackCoalesceMap[i].eventId == data[1])) {
+            return (sint8)i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Overwrite the pending copy of a coalesced event with a newer one
+ * 
+ * The old copy is uncommitted under critical section, so a flush closing
+ * the window meanwhile waits (commitWaits) until the new value is copied in,
+ * exactly like for a producer still copying a new message.
+ * 
+ * @param inst     Stack instance
+ * @param sel      Coalescing selection index
+ * @param part1    First part (whole message, or packed header)
+ * @param part1Len First part length
+ * @param part2    Second part (payload, can be NULL)
+ * @param part2Len Second part length
+ * @return TRUE if replaced, FALSE if the event must be appended
+ */
+static boolean PICC_StackReplacePending(PICC_StackInstance_t *inst, sint8 sel,
+                                        const uint8 *part1, uint32 part1Len,
+                                        const uint8 *part2, uint32 part2Len)
+{
+    PICC_StackCoalesceSlot_t *slot = &inst->context.coalesce[sel];
+    PICC_StackWindow_t *win;
+    uint8 *dst = NULL;
+    uint32 len = part1Len + part2Len;
+    uint32 i;
+
+    taskENTER_CRITICAL();
+    win = PICC_StackActiveWindow(inst);
+    if ((slot->valid != FALSE) && (slot->busy == FALSE) && ((uint32)slot->len == len) &&
+        (slot->winIdx == inst->context.activeIdx) && (slot->openSeq == win->openSeq) &&
+        ((win->reserved & PICC_STACK_WINDOW_CLOSED) == 0U)) {
+        dst = &PICC_StackWindowData(win)[slot->offset];
+        /* Same ConsumerID and message type only */
+        if ((dst[2] == part1[2]) && (dst[4] == part1[4])) {
+            slot->busy = TRUE;
+            PICC_STACK_ATOMIC_ADD(&win->committed, 0U - len);
+        } else {
+            dst = NULL;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if (dst == NULL) {
+        return FALSE;
+    }
+
+    for (i = 0U; i < part1Len; i++) {
+        dst[i] = part1[i];
+    }
+    for (i = 0U; i < part2Len; i++) {
+        dst[part1Len + i] = part2[i];
+    }
+
+    slot->busy = FALSE;
+    PICC_STACK_ATOMIC_ADD(&win->committed, len);
+
+    PICC_STACK_ATOMIC_ADD(&inst->metrics.coalesced, 1U);
+    PICC_STACK_ATOMIC_ADD(&g_stackCoalesceMap[sel].coalesced, 1U);
+    return TRUE;
+}
+
+/**
+ * @brief Send one message at once as its own frame (high priority lane)
+ * 
+ * Bypasses the aggregation window: the pending aggregate stays queued and
+ * is sent after this frame. Uses the channel Tx counter like any frame,
+ * owning it through txBusy while the frame is built outside of critical
+ * section. Without message (part1Len 0) an empty heartbeat control frame
+ * is sent.
+ * 
+ * @param inst     Stack instance
+ * @param part1    First part (whole message, or packed header, can be NULL)
+ * @param part1Len First part length
+ * @param part2    Second part (payload, can be NULL)
+ * @param part2Len Second part length
+ * @return 0 on success, non-zero if the frame could not be sent
+ */
+static sint8 PICC_StackSendSingle(PICC_StackInstance_t *inst,
+                                  const uint8 *part1, uint32 part1Len,
+                                  const uint8 *part2, uint32 part2Len)
+{
+    uint8 *shmBuf;
+    uint32 len;
+    uint32 totalLen;
+    uint32 counterOffset;
+    uint32 i;
+    uint16 counter;
+    uint16 crc;
+    uint8 hbFlags;
+    sint8 err;
+
+    if (ipc_shm_is_remote_ready(IPCF_INSTANCE0) != 0) {
+        return -1;
+    }
+
+    len = part1Len + part2Len;
+    totalLen = PICC_STACK_OVERHEAD_SIZE + len;
+
+    taskENTER_CRITICAL();
+
+    /* Aggregate being transmitted owns the Tx counter: join it instead */
+    if (inst->context.txBusy != FALSE) {
+        taskEXIT_CRITICAL();
+        return -1;
+    }
 
-    /* Get IPCF send buffer */
     shmBuf = (uint8 *)ipc_shm_acquire_buf(IPCF_INSTANCE0, inst->config.channelId, totalLen);
     if (shmBuf == NULL) {
-        /* IPCF buffer temporarily unavailable (all buffers in flight).
-         * Keep data for retry next period - do NOT clear.
-         */
         taskEXIT_CRITICAL();
-        return -1;  /* Signal failure, but data preserved for retry */
+        return -1;
     }
 
-    /* [Byte 0] Fill CRC enable flag */
-    crcEnableFlag = (inst->config.crcEnabled == PICC_STACK_CRC_ENABLED) ? 
-                    PICC_STACK_CRC_ENABLED : PICC_STACK_CRC_DISABLED;
-    shmBuf[0] = crcEnableFlag;
+    inst->context.txBusy = TRUE;
+    counter = inst->context.txCounter;
 
-    /* [Bytes 1~N] Copy stacked protocol packets */
-    for (i = 0U; i < inst->context.usedSize; i++) {
-        shmBuf[PICC_STACK_CRC_ENABLE_SIZE + i] = inst->context.buffer[i];
-    }
+    taskEXIT_CRITICAL();
 
-    /* [Bytes N+1, N+2] Fill Counter (big-endian) */
-    counterOffset = PICC_STACK_CRC_ENABLE_SIZE + inst->context.usedSize;
-    shmBuf[counterOffset]      = (uint8)(inst->context.txCounter >> 8U);
-    shmBuf[counterOffset + 1U] = (uint8)(inst->context.txCounter & 0xFFU);
+    /* [Byte 0] CRC enable flag + pending heartbeat flags, [Bytes 1~N] message */
+    hbFlags = PICC_STACK_ATOMIC_XCHG(&inst->context.hbFlags, 0U);
+    shmBuf[0] = PICC_StackCrcEnableFlag(inst) | hbFlags;
+    for (i = 0U; i < part1Len; i++) {
+        shmBuf[PICC_STACK_CRC_ENABLE_SIZE + i] = part1[i];
+    }
+    for (i = 0U; i < part2Len; i++) {
+        shmBuf[PICC_STACK_CRC_ENABLE_SIZE + part1Len + i] = part2[i];
+    }
 
-    /* Calculate CRC16 (on CRC_Enable + data + Counter) */
+    /* Counter + CRC16 (big-endian) */
+    counterOffset = PICC_STACK_CRC_ENABLE_SIZE + len;
+    shmBuf[counterOffset]      = (uint8)(counter >> 8U);
+    shmBuf[counterOffset + 1U] = (uint8)(counter & 0xFFU);
     crc = PICC_CRC16(shmBuf, counterOffset + PICC_STACK_COUNTER_SIZE);
-
-    /* [Last 2 Bytes] Fill CRC16 (big-endian) */
     shmBuf[counterOffset + PICC_STACK_COUNTER_SIZE]      = (uint8)(crc >> 8U);
     shmBuf[counterOffset + PICC_STACK_COUNTER_SIZE + 1U] = (uint8)(crc & 0xFFU);
 
-    /* [DEBUG] Record TX data for TRACE32 observation (before send attempt) */
     PICC_TraceTx(inst->config.channelId, shmBuf, totalLen);
 
-    /* Send */
-    /* Note: Assumes ipc_shm_tx is fast enough and non-blocking */
+    taskENTER_CRITICAL();
     err = ipc_shm_tx(IPCF_INSTANCE0, inst->config.channelId, shmBuf, totalLen);
     if (err != 0) {
-        (void)ipc_shm_release_buf(IPCF_INSTANCE0, inst->config.channelId, shmBuf);
+        (void)ipc_shm_return_buf(IPCF_INSTANCE0, inst->config.channelId, shmBuf);
+        PICC_STACK_ATOMIC_OR(&inst->context.hbFlags, hbFlags);
+    } else {
+        inst->context.txCounter++;
+        if (inst->context.txCounter == 0U) {
+            inst->context.txCounter = 1U;  /* Avoid zero value */
+        }
+
+        if (len != 0U) {
+            PICC_StackUpdateMetrics(inst, PICC_STACK_FLUSH_REASON_HIGH_LANE, 1U, (uint16)len,
+                                    (uint32)xTaskGetTickCount());
+        } else {
+            PICC_StackUpdateMetrics(inst, PICC_STACK_FLUSH_REASON_HEARTBEAT, 0U, 0U,
+                                    (uint32)xTaskGetTickCount());
+        }
+    }
+    inst->context.txBusy = FALSE;
+    taskEXIT_CRITICAL();
+
+    return (err != 0) ? -2 : 0;
+}
+
+/**
+ * @brief Process all stack channels - send buffered data
+ * 
+ * Called from PICC periodic task (10ms).
+ * Replaces the timer-based approach for better code organization.
+ */
+void PICC_StackProcess(void)
+{
+    uint8 i;
+    PICC_StackInstance_t *inst;
+    
+    for (i = 0U; i < PICC_STACK_MAX_INSTANCES; i++) {
+        inst = &g_stackInstances[i];
+        if (inst->initialized != FALSE) {
+            (void)PICC_StackDoSendForChannel(inst->config.channelId, PICC_STACK_FLUSH_REASON_PERIOD);
+
+            /* Heartbeat flag that found no frame to ride on */
+            if (inst->context.hbFlags != 0U) {
+                (void)PICC_StackSendHeartbeat(inst->config.channelId, 0U);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Get tick of the oldest message not yet sent (in critical section)
+ * 
+ * @param inst     Stack instance
+ * @param openTick Tick the oldest pending message was added
+ * @return TRUE if the channel has data pending
+ */
+static boolean PICC_StackOldestPending(PICC_StackInstance_t *inst, uint32 *openTick)
+{
+    if (inst->context.txPending != FALSE) {
+        *openTick = PICC_StackTxWindow(inst)->openTick;  /* Older than active window */
+        return TRUE;
+    }
+    if (PICC_StackWindowUsed(PICC_StackActiveWindow(inst)) != 0U) {
+        *openTick = PICC_StackActiveWindow(inst)->openTick;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/**
+ * @brief Send frames that are due by batching policy
+ * 
+ * @return Ticks until the next deadline, portMAX_DELAY if none pending
+ */
+static TickType_t PICC_StackFlushDue(void)
+{
+    uint8 i;
+    PICC_StackInstance_t *inst;
+    TickType_t waitTicks = portMAX_DELAY;
+    TickType_t deadline;
+    TickType_t age;
+    TickType_t left;
+    uint32 openTick;
+    PICC_StackFlushReason_e reason;
+    boolean due;
+
+    for (i = 0U; i < PICC_STACK_MAX_INSTANCES; i++) {
+        inst = &g_stackInstances[i];
+        if (inst->initialized == FALSE) {
+            continue;
+        }
+
+        deadline = pdMS_TO_TICKS(inst->config.flushDeadlineMs);
+        due = FALSE;
+        reason = PICC_STACK_FLUSH_REASON_DEADLINE;
+
+        taskENTER_CRITICAL();
+        if (PICC_StackOldestPending(inst, &openTick) != FALSE) {
+            age = xTaskGetTickCount() - (TickType_t)openTick;
+            if (inst->context.flushRequest != FALSE) {
+                due = TRUE;
+                reason = (PICC_StackFlushReason_e)inst->context.flushReason;
+            } else if ((inst->config.flushDeadlineMs != 0U) && (age >= deadline)) {
+                due = TRUE;
+            } else {
+                /* Not due yet */
+            }
+        }
+        inst->context.flushRequest = FALSE;
         taskEXIT_CRITICAL();
-        HANDLE_ERROR(-32);  /* Stack: IPCF TX failed */
+
+        if (due != FALSE) {
+            (void)PICC_StackDoSendForChannel(inst->config.channelId, reason);
+        }
+
+        /* Wake up again at the deadline of the oldest pending message */
+        taskENTER_CRITICAL();
+        if ((inst->config.flushDeadlineMs != 0U) &&
+            (PICC_StackOldestPending(inst, &openTick) != FALSE)) {
+            age = xTaskGetTickCount() - (TickType_t)openTick;
+            /* Deadline passed but frame not sent (no IPCF buffer): retry soon */
+            left = (age >= deadline) ? PICC_STACK_FLUSH_RETRY_TICKS : (deadline - age);
+            if (left < waitTicks) {
+                waitTicks = left;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    return waitTicks;
+}
+
+/**
+ * @brief Stack flush task - adaptive batching
+ */
+void PICC_StackFlushTask(void *pvParameters)
+{
+    TickType_t waitTicks = portMAX_DELAY;
+
+    (void)pvParameters;
+
+    g_stackFlushTask = xTaskGetCurrentTaskHandle();
+
+    for (;;) {
+        /* Wait for flush request, or until the nearest deadline */
+        (void)ulTaskNotifyTake(pdTRUE, waitTicks);
+
+        waitTicks = PICC_StackFlushDue();
+    }
+}
+
+/**
+ * @brief Append a message (header part + payload part) to a channel
+ * 
+ * Lock-free fast path: room is reserved in the active window by fetch-add,
+ * both parts are copied with interrupts enabled (several producers may copy
+ * in parallel) and the copy is published through the commit counter.
+ * Critical sections are only entered to open an empty window (first
+ * message) or when the window is full.
+ * 
+ * @param channelId  Channel ID
+ * @param part1      First part (whole message, or packed header)
+ * @param part1Len   First part length
+ * @param part2      Second part (payload, can be NULL)
+ * @param part2Len   Second part length
+ * @return 0 on success, non-zero on failure
+ */
+static sint8 PICC_StackAppend(uint8 channelId, const uint8 *part1, uint32 part1Len,
+                              const uint8 *part2, uint32 part2Len)
+{
+    PICC_StackInstance_t *inst;
+    PICC_StackWindow_t *win;
+    uint8 *dst;
+    uint32 len;
+    uint32 offset = 0U;
+    uint32 i;
+    uint8 tries;
+    TickType_t now;
+    boolean firstMsg;
+    boolean flushed = FALSE;
+    boolean attached = FALSE;
+    boolean grown = FALSE;
+    boolean highLane = FALSE;
+    boolean notify = FALSE;
+    sint8 sel = -1;
+    sint8 ret = -1;
+    
+    inst = PICC_GetStackInstance(channelId);
+    if (inst == NULL || inst->initialized == FALSE) {
+        return -1;
+    }
+
+    len = part1Len + part2Len;
+    if ((part1 == NULL) || (part1Len == 0U) || ((part2 == NULL) && (part2Len != 0U))) {
+        HANDLE_ERROR(-33);  /* Stack: AddMessage data is NULL or len is 0 */
         return -2;
     }
 
-    /* Update counter */
-    inst->context.txCounter++;
-    if (inst->context.txCounter == 0U) {
-        inst->context.txCounter = 1U;  /* Avoid zero value */
+    /* Check again (single message too large) */
+    if (len > PICC_StackMaxPayload(inst)) {
+        HANDLE_ERROR(-34);  /* Stack: Message too large */
+        return -3;
     }
 
-    /* Clear buffer */
-    inst->context.usedSize = 0U;
+    /* High priority lane: bypass aggregation, send as own frame */
+    if ((inst->config.highLaneEnabled != FALSE) &&
+        (PICC_StackGetLane(part1, part1Len) == PICC_STACK_LANE_HIGH)) {
+        if (PICC_StackSendSingle(inst, part1, part1Len, part2, part2Len) == 0) {
+            return 0;
+        }
+        /* Own frame not possible: join aggregate and flush it at once */
+        highLane = TRUE;
+    } else {
+        /* Last value wins: overwrite the copy still pending in the aggregate */
+        sel = PICC_StackGetCoalesce(part1, part1Len);
+        if ((sel >= 0) &&
+            (PICC_StackReplacePending(inst, sel, part1, part1Len, part2, part2Len) != FALSE)) {
+            return 0;
+        }
+    }
 
-    taskEXIT_CRITICAL();
+    /* Reserve room in the active window */
+    win = NULL;
+    for (tries = 0U; tries < PICC_STACK_APPEND_MAX_TRIES; tries++) {
+        win = PICC_StackActiveWindow(inst);
+        ret = PICC_StackReserve(inst, win, len, &offset);
+        if (ret == 0) {
+            break;
+        }
 
-    return 0;
-}
+        if (ret == -1) {
+            /* Window closed: open it (first message), or a flush swapped meanwhile */
+            taskENTER_CRITICAL();
+            win = PICC_StackActiveWindow(inst);
+            if (win->reserved == PICC_STACK_WINDOW_CLOSED) {
+                PICC_StackOpenWindow(inst, win, len);
+            }
+            taskEXIT_CRITICAL();
+        } else if ((PICC_StackWindowUsed(win) == 0U) && (attached == FALSE)) {
+            /* Empty window without buffer (none free when opened): try again */
+            attached = TRUE;
+            taskENTER_CRITICAL();
+            win = PICC_StackActiveWindow(inst);
+            if (win->reserved == 0U) {
+                PICC_StackAttachBuffer(inst, win, len);
+            }
+            taskEXIT_CRITICAL();
+        } else if ((grown == FALSE) && (PICC_StackWindowCapacity(win) < PICC_StackMaxPayload(inst))) {
+            /* Small IPCF buffer full: move to a larger one and keep batching */
+            grown = TRUE;
+            taskENTER_CRITICAL();
+            win = PICC_StackActiveWindow(inst);
+            (void)PICC_StackGrowWindow(inst, win, len);
+            taskEXIT_CRITICAL();
+        } else if (flushed == FALSE) {
+            /* Buffer full - try to send current buffer first. A failed send
+             * (Tx busy, commit pending) may still have swapped in an empty
+             * window, so the reservation is retried in any case */
+            flushed = TRUE;
+            (void)PICC_StackDoSendForChannel(channelId, PICC_STACK_FLUSH_REASON_FULL);
+        } else {
+            break;
+        }
+    }
+
+    if (ret != 0) {
+        /* Window still full after the flush attempt - return error to prevent buffer overflow */
+        return -4;
+    }
+
+    /* Copy outside of any critical section, reservation is exclusive */
+    now = xTaskGetTickCount();
+    firstMsg = (offset == 0U) ? TRUE : FALSE;
+    if (firstMsg != FALSE) {
+        win->openTick = (uint32)now;
+    }
+
+    dst = &PICC_StackWindowData(win)[offset];
+    for (i = 0U; i < part1Len; i++) {
+        dst[i] = part1[i];
+    }
+    for (i = 0U; i < part2Len; i++) {
+        dst[part1Len + i] = part2[i];
+    }
+
+    /* Coalesced event: remember the copy, window cannot be sent before commit */
+    if (sel >= 0) {
+        taskENTER_CRITICAL();
+        inst->context.coalesce[sel].offset  = offset;
+        inst->context.coalesce[sel].len     = (uint16)len;
+        inst->context.coalesce[sel].openSeq = win->openSeq;
+        inst->context.coalesce[sel].winIdx  = (uint8)(win - &inst->context.window[0]);
+        inst->context.coalesce[sel].valid   = TRUE;
+        taskEXIT_CRITICAL();
+    }
+
+    /* Publish: flush transmits the window only once committed == reserved */
+    PICC_STACK_ATOMIC_ADD(&win->msgCount, 1U);
+    PICC_STACK_ATOMIC_ADD(&win->committed, len);
+
+    /* Adaptive batching: request flush from flush task */
+    if (highLane != FALSE) {
+        inst->context.flushReason = (uint8)PICC_STACK_FLUSH_REASON_HIGH_LANE;
+        inst->context.flushRequest = TRUE;
+    } else if ((firstMsg != FALSE) && (inst->config.flushOnIdle != FALSE) &&
+        ((now - (TickType_t)inst->context.lastTxTick) >= pdMS_TO_TICKS(PICC_STACK_IDLE_GAP_MS))) {
+        inst->context.flushReason = (uint8)PICC_STACK_FLUSH_REASON_IDLE;
+        inst->context.flushRequest = TRUE;
+    } else if ((inst->config.flushThreshold != 0U) &&
+               ((offset + len) >= inst->config.flushThreshold) &&
+               (inst->context.flushRequest == FALSE)) {
+        inst->context.flushReason = (uint8)PICC_STACK_FLUSH_REASON_THRESHOLD;
+        inst->context.flushRequest = TRUE;
+    } else {
+        /* Keep batching */
+    }
+
+    /* Wake flush task on request, or to arm the deadline of a new window */
+    if ((inst->context.flushRequest != FALSE) ||
+        ((firstMsg != FALSE) && (inst->config.flushDeadlineMs != 0U))) {
+        notify = TRUE;
+    }
 
-/**
- * @brief Process all stack channels - send buffered data
- * 
- * Called from PICC periodic task (10ms).
- * Replaces the timer-based approach for better code organization.
- */
-void PICC_StackProcess(void)
-{
-    uint8 i;
-    PICC_StackInstance_t *inst;
-    
-    for (i = 0U; i < PICC_STACK_MAX_INSTANCES; i++) {
-        inst = &g_stackInstances[i];
-        if (inst->initialized != FALSE) {
-            (void)PICC_StackDoSendForChannel(inst->config.channelId);
-        }
+    if ((notify != FALSE) && (g_stackFlushTask != NULL)) {
+        (void)xTaskNotifyGive(g_stackFlushTask);
     }
+
+    return 0;
 }
 
 /*==================================================================================================
@@ -202,6 +1187,8 @@ void PICC_StackProcess(void)
 sint8 PICC_StackInitChannel(const PICC_StackConfig_t *config)
 {
     PICC_StackInstance_t *inst;
+    uint32 maxFrameSize;
+    uint8 w;
     
     if (config == NULL) {
         HANDLE_ERROR(-1);  /* Config parameter is NULL */
@@ -222,10 +1209,49 @@ sint8 PICC_StackInitChannel(const PICC_StackConfig_t *config)
     inst->config = *config;
     
     /* Initialize context */
-    inst->context.usedSize    = 0U;
+    for (w = 0U; w < PICC_STACK_WINDOW_NUM; w++) {
+        inst->context.window[w].buffer    = NULL;
+        inst->context.window[w].shmBuf    = NULL;
+        inst->context.window[w].reserved  = PICC_STACK_WINDOW_CLOSED;  /* Opened by first message */
+        inst->context.window[w].committed = 0U;
+        inst->context.window[w].msgCount  = 0U;
+        inst->context.window[w].usedSize  = 0U;
+        inst->context.window[w].openTick  = 0U;
+        inst->context.window[w].openSeq   = 0U;
+        inst->context.window[w].capacity  = 0U;
+    }
+    for (w = 0U; w < PICC_STACK_COALESCE_MAP_SIZE; w++) {
+        inst->context.coalesce[w].valid = FALSE;
+        inst->context.coalesce[w].busy  = FALSE;
+    }
+    inst->context.activeIdx   = 0U;
+    inst->context.txPending   = FALSE;
+    inst->context.txBusy      = FALSE;
+    /* Channel starts idle */
+    inst->context.lastTxTick  = (uint32)(xTaskGetTickCount() - pdMS_TO_TICKS(PICC_STACK_IDLE_GAP_MS));
+    inst->context.flushRequest = FALSE;
+    inst->context.flushReason = (uint8)PICC_STACK_FLUSH_REASON_PERIOD;
     inst->context.txCounter   = 1U;
-    inst->context.rxCounter   = 0U;
+    inst->context.rxSeq.counter  = 0U;
+    inst->context.rxSeq.synced   = FALSE;
+    inst->context.rxSeq.seenMask = 0U;
     inst->context.timerRunning = FALSE;
+    inst->context.creditEvent  = FALSE;
+    inst->context.hbFlags      = 0U;
+    inst->context.frameEstimate = 0U;
+    
+    /* Frame size limit from the IPCF pool configuration of the channel */
+    maxFrameSize = ipc_shm_max_buf_size(IPCF_INSTANCE0, config->channelId);
+    if ((maxFrameSize <= PICC_STACK_OVERHEAD_SIZE) || (maxFrameSize > PICC_STACK_SHM_FRAME_SIZE)) {
+        maxFrameSize = PICC_STACK_SHM_FRAME_SIZE;
+    }
+    inst->context.maxFrameSize = (uint16)maxFrameSize;
+    
+    /* Get notified when A-core releases buffers after a failed acquire */
+    if (ipc_shm_register_credit_cb(IPCF_INSTANCE0, config->channelId,
+                                   PICC_StackCreditCallback, inst) != 0) {
+        HANDLE_ERROR(-39);  /* Stack: credit callback registration failed */
+    }
     
     /* NOTE: Timer removed - PICC_StackProcess() is called from PICC_PeriodicTask */
     inst->initialized = TRUE;
@@ -241,6 +1267,8 @@ sint8 PICC_StackInitChannel(const PICC_StackConfig_t *config)
 void PICC_StackDeinitChannel(uint8 channelId)
 {
     PICC_StackInstance_t *inst;
+    PICC_StackWindow_t *win;
+    uint8 w;
     
     inst = PICC_GetStackInstance(channelId);
     if (inst == NULL || inst->initialized == FALSE) {
@@ -248,8 +1276,23 @@ void PICC_StackDeinitChannel(uint8 channelId)
     }
     
     /* NOTE: Timer removed - no timer cleanup needed */
-    inst->context.usedSize = 0U;
+    taskENTER_CRITICAL();
+    for (w = 0U; w < PICC_STACK_WINDOW_NUM; w++) {
+        win = &inst->context.window[w];
+        if (win->shmBuf != NULL) {
+            /* Give back IPCF buffer of unsent zero-copy window */
+            (void)ipc_shm_return_buf(IPCF_INSTANCE0, inst->config.channelId, win->shmBuf);
+            win->shmBuf = NULL;
+        }
+        PICC_ArenaFree(win->buffer);
+        win->buffer = NULL;
+        win->capacity = 0U;
+        win->reserved = PICC_STACK_WINDOW_CLOSED;
+        win->usedSize = 0U;
+    }
+    inst->context.txPending = FALSE;
     inst->initialized = FALSE;
+    taskEXIT_CRITICAL();
 }
 
 /**
@@ -262,50 +1305,16 @@ void PICC_StackDeinitChannel(uint8 channelId)
  */
 sint8 PICC_StackAddMessageToChannel(uint8 channelId, const uint8 *data, uint32 len)
 {
-    PICC_StackInstance_t *inst;
-    uint32 i;
-    sint8 ret = 0;
-    
-    inst = PICC_GetStackInstance(channelId);
-    if (inst == NULL || inst->initialized == FALSE) {
-        return -1;
-    }
-
-    if ((data == NULL) || (len == 0U)) {
-        HANDLE_ERROR(-33);  /* Stack: AddMessage data is NULL or len is 0 */
-        return -2;
-    }
-
-    /* Check again (single message too large) */
-    if (len > PICC_STACK_PAYLOAD_MAX_SIZE) {
-        HANDLE_ERROR(-34);  /* Stack: Message too large */
-        return -3;
-    }
-
-    /* Enter critical section */
-    taskENTER_CRITICAL();
-
-    /* Check if would exceed buffer */
-    if ((inst->context.usedSize + len) > PICC_STACK_PAYLOAD_MAX_SIZE) {
-        /* Buffer full - try to send current buffer first */
-        ret = PICC_StackDoSendForChannel(channelId);
-        if (ret != 0) {
-            /* Send failed - return error to prevent buffer overflow */
-            taskEXIT_CRITICAL();
-            return -4;
-        }
-    }
-
-    /* Add to buffer */
-    for (i = 0U; i < len; i++) {
-        inst->context.buffer[inst->context.usedSize] = data[i];
-        inst->context.usedSize++;
-    }
-
-    /* Exit critical section */
-    taskEXIT_CRITICAL();
+    return PICC_StackAppend(channelId, data, len, NULL, 0U);
+}
 
-    return ret;
+/**
+ * @brief Add message given as packed header + payload to channel's stack buffer
+ */
+sint8 PICC_StackAddMessageParts(uint8 channelId, const uint8 *header,
+                                const uint8 *payload, uint16 payloadLen)
+{
+    return PICC_StackAppend(channelId, header, PICC_HEADER_SIZE, payload, (uint32)payloadLen);
 }
 
 /**
@@ -325,13 +1334,49 @@ sint8 PICC_StackFlushChannel(uint8 channelId)
         return -1;
     }
 
-    ret = PICC_StackDoSendForChannel(channelId);
+    ret = PICC_StackDoSendForChannel(channelId, PICC_STACK_FLUSH_REASON_EXPLICIT);
     if (ret != 0 && ret != -1) {  /* -1 is buffer unavailable, normal case */
         HANDLE_ERROR(-36);  /* Stack: FlushChannel send failed */
     }
     return ret;
 }
 
+/**
+ * @brief Send heartbeat flag with the next frame of a channel
+ * 
+ * @param channelId Channel ID
+ * @param hbFlag    Heartbeat flag (0: only retry a pending flag)
+ * @return 0 on success, non-zero if the flag is still pending
+ */
+sint8 PICC_StackSendHeartbeat(uint8 channelId, uint8 hbFlag)
+{
+    PICC_StackInstance_t *inst;
+    uint32 openTick;
+    boolean pending;
+
+    inst = PICC_GetStackInstance(channelId);
+    if (inst == NULL || inst->initialized == FALSE) {
+        return -1;
+    }
+
+    PICC_STACK_ATOMIC_OR(&inst->context.hbFlags, (uint8)(hbFlag & PICC_STACK_FLAG_HB_MASK));
+
+    taskENTER_CRITICAL();
+    pending = PICC_StackOldestPending(inst, &openTick);
+    taskEXIT_CRITICAL();
+
+    if (pending != FALSE) {
+        /* Ride on the pending aggregate, a Pong must not wait for batching */
+        if ((inst->context.hbFlags & PICC_STACK_FLAG_HB_PONG) != 0U) {
+            (void)PICC_StackDoSendForChannel(channelId, PICC_STACK_FLUSH_REASON_HEARTBEAT);
+        }
+        return 0;
+    }
+
+    /* Nothing to ride on: empty control frame */
+    return PICC_StackSendSingle(inst, NULL, 0U, NULL, 0U);
+}
+
 /**
  * @brief Clear buffer for specified channel (discard pending data)
  * 
@@ -340,17 +1385,103 @@ sint8 PICC_StackFlushChannel(uint8 channelId)
 void PICC_StackClearBuffer(uint8 channelId)
 {
     PICC_StackInstance_t *inst;
+    PICC_StackWindow_t *win;
     
     inst = PICC_GetStackInstance(channelId);
     if (inst == NULL || inst->initialized == FALSE) {
         return;
     }
     
+    /* Clear buffer by resetting reservation (IPCF buffers kept for reuse).
+     * A window a producer is still copying into is left alone. */
     taskENTER_CRITICAL();
-    inst->context.usedSize = 0U;  /* Clear buffer by resetting used size */
+    win = PICC_StackActiveWindow(inst);
+    if ((win->reserved != PICC_STACK_WINDOW_CLOSED) &&
+        (win->committed == PICC_StackWindowUsed(win))) {
+        win->committed = 0U;
+        win->msgCount = 0U;
+        win->openSeq++;
+        win->reserved = 0U;
+    }
+    win = PICC_StackTxWindow(inst);
+    if ((inst->context.txPending != FALSE) && (inst->context.txBusy == FALSE) &&
+        (win->committed == (uint32)win->usedSize)) {
+        /* Drop frame waiting for retransmission too */
+        win->usedSize = 0U;
+        win->msgCount = 0U;
+        win->committed = 0U;
+        win->reserved = PICC_STACK_WINDOW_CLOSED;
+        inst->context.txPending = FALSE;
+    }
     taskEXIT_CRITICAL();
 }
 
+/**
+ * @brief Track received frame counter (Rx task context)
+ * 
+ * @param inst      Stack instance
+ * @param rxCounter Received frame counter
+ * @return TRUE to process the frame, FALSE to drop it (duplicate)
+ */
+static boolean PICC_StackRxSequence(PICC_StackInstance_t *inst, uint16 rxCounter)
+{
+    PICC_StackRxStats_t *stats = &inst->rxStats;
+    uint16 last = inst->context.rxSeq.counter;
+    uint16 expected;
+    uint16 missing;
+
+    stats->frames++;
+
+    switch (PICC_FrameSeqTrack(&inst->context.rxSeq, rxCounter, &missing)) {
+        case PICC_FRAME_SEQ_GAP:
+            expected = (uint16)(last + 1U);
+            if (expected == 0U) {
+                expected = 1U;
+            }
+            stats->gaps++;
+            stats->lostFrames += missing;
+            if (g_stackRxLossCallback != NULL) {
+                g_stackRxLossCallback(inst->config.channelId, expected, rxCounter, missing);
+            }
+            if (rxCounter < last) {
+                stats->wraps++;
+            }
+            break;
+
+        case PICC_FRAME_SEQ_NEXT:
+            if (rxCounter < last) {
+                stats->wraps++;
+            }
+            break;
+
+        case PICC_FRAME_SEQ_DUPLICATE:
+            stats->duplicates++;
+            if (inst->config.rxDropDuplicates != FALSE) {
+                stats->dropped++;
+                return FALSE;
+            }
+            break;
+
+        case PICC_FRAME_SEQ_LATE:
+            /* Late frame filling an earlier gap: it was not lost after all */
+            stats->reordered++;
+            if (stats->lostFrames != 0U) {
+                stats->lostFrames--;
+            }
+            break;
+
+        case PICC_FRAME_SEQ_RESYNC:
+            stats->resyncs++;
+            break;
+
+        default:
+            /* First frame: baseline */
+            break;
+    }
+
+    return TRUE;
+}
+
 /**
  * @brief Process received stacked data
  
@@ -363,7 +1494,7 @@ sint8 PICC_StackProcessRx(const uint8 *data, uint32 len,
                           uint8 instanceId, uint8 channelId)
 {
     PICC_StackInstance_t *inst;
-    uint8 crcEnableFlag;
+    uint8 frameFlags;
     uint16 rxCounter;
     uint16 crcReceived;
     uint16 crcCalculated;
@@ -390,8 +1521,8 @@ sint8 PICC_StackProcessRx(const uint8 *data, uint32 len,
     /* [DEBUG] Record RX data for TRACE32 observation */
     PICC_TraceRx(channelId, data, len);
 
-    /* [Byte 0] Parse CRC enable flag */
-    crcEnableFlag = data[0];
+    /* [Byte 0] Parse frame flags (CRC enable flag + heartbeat flags) */
+    frameFlags = data[0];
 
     /* Calculate counter offset: len - CRC16(2B) - Counter(2B) */
     counterOffset = len - PICC_STACK_CRC_SIZE - PICC_STACK_COUNTER_SIZE;
@@ -404,7 +1535,7 @@ sint8 PICC_StackProcessRx(const uint8 *data, uint32 len,
     crcReceived = (uint16)((uint16)data[len - 2U] << 8U) | (uint16)data[len - 1U];
 
     /* Verify CRC if enabled */
-    if (crcEnableFlag == PICC_STACK_CRC_ENABLED) {
+    if ((frameFlags & PICC_STACK_FLAG_CRC_MASK) == PICC_STACK_CRC_ENABLED) {
         /* Calculate CRC16 (excluding last 2 bytes CRC) */
         crcCalculated = PICC_CRC16(data, len - PICC_STACK_CRC_SIZE);
 
@@ -414,15 +1545,21 @@ sint8 PICC_StackProcessRx(const uint8 *data, uint32 len,
         }
     }
 
-    /* Store receive counter to corresponding channel instance */
-    inst->context.rxCounter = rxCounter;
+    /* Track receive counter, drop duplicate if configured */
+    if (PICC_StackRxSequence(inst, rxCounter) == FALSE) {
+        return 0;  /* Duplicate dropped - not an error */
+    }
+
+    /* Any valid frame is a sign of life, Ping flag is answered */
+    PICC_HeartbeatNotifyRx(instanceId, channelId, (uint8)(frameFlags & PICC_STACK_FLAG_HB_MASK));
 
     /* Parse stacked messages */
     /* Payload length = total - CRC_Enable(1B) - Counter(2B) - CRC16(2B) */
     payloadLen = len - PICC_STACK_OVERHEAD_SIZE;
     offset = PICC_STACK_CRC_ENABLE_SIZE;  /* Start after CRC enable flag */
 
-    /* [R6] Check if heartbeat message (special format 9 bytes, no protocol header) */
+    /* [R6] Legacy heartbeat message (special format 9 bytes, no protocol header),
+     * still sent by peers without heartbeat flags */
     if (payloadLen == PICC_HEARTBEAT_MSG_SIZE) {
         const uint8 *heartbeatData = &data[offset];
         if (PICC_HeartbeatIsPing(heartbeatData, PICC_HEARTBEAT_MSG_SIZE) != FALSE) {
@@ -431,9 +1568,7 @@ sint8 PICC_StackProcessRx(const uint8 *data, uint32 len,
             return 1;  /* Processed 1 heartbeat message */
         }
         if (PICC_HeartbeatIsPong(heartbeatData, PICC_HEARTBEAT_MSG_SIZE) != FALSE) {
-            /* Received Pong, reset heartbeat count */
-            PICC_HeartbeatReset(instanceId, channelId);
-            return 1;  /* Processed 1 heartbeat message */
+            return 1;  /* Pong: sign of life already noted above */
         }
     }
 
@@ -464,6 +1599,262 @@ sint8 PICC_StackProcessRx(const uint8 *data, uint32 len,
     return msgCount;
 }
 
+/**
+ * @brief Get IPCF Tx credits for the pending stacked frame
+ */
+uint32 PICC_StackGetTxCredits(uint8 channelId)
+{
+    PICC_StackInstance_t *inst;
+    PICC_StackWindow_t *win;
+    uint32 frameLen;
+
+    inst = PICC_GetStackInstance(channelId);
+    if (inst == NULL || inst->initialized == FALSE) {
+        return 0U;
+    }
+
+    /* Open zero-copy window already holds the buffer for the pending frame,
+     * the next window asks for the expected frame size */
+    win = PICC_StackActiveWindow(inst);
+    if (win->shmBuf != NULL) {
+        return 1U + ipc_shm_tx_credits(IPCF_INSTANCE0, inst->config.channelId,
+                                       PICC_StackFrameRequest(inst, PICC_HEADER_SIZE));
+    }
+
+    /* Pending frame, or smallest frame carrying one protocol message */
+    frameLen = PICC_StackWindowUsed(win);
+    if (frameLen < PICC_HEADER_SIZE) {
+        frameLen = PICC_HEADER_SIZE;
+    }
+    frameLen += PICC_STACK_OVERHEAD_SIZE;
+
+    return ipc_shm_tx_credits(IPCF_INSTANCE0, inst->config.channelId, frameLen);
+}
+
+/**
+ * @brief Check and clear the Tx credits replenished event
+ */
+boolean PICC_StackTakeCreditEvent(uint8 channelId)
+{
+    PICC_StackInstance_t *inst;
+    boolean event;
+
+    inst = PICC_GetStackInstance(channelId);
+    if (inst == NULL || inst->initialized == FALSE) {
+        return FALSE;
+    }
+
+    taskENTER_CRITICAL();
+    event = inst->context.creditEvent;
+    inst->context.creditEvent = FALSE;
+    taskEXIT_CRITICAL();
+
+    return event;
+}
+
+/**
+ * @brief Select the lane of a ProviderID/MethodID on all channels
+ */
+sint8 PICC_StackSetLane(uint8 providerId, uint8 methodId, PICC_StackLane_e lane)
+{
+    sint8 freeSlot = -1;
+    uint32 i;
+    sint8 ret = 0;
+
+    taskENTER_CRITICAL();
+
+    for (i = 0U; i < PICC_STACK_LANE_MAP_SIZE; i++) {
+        if (g_stackLaneMap[i].isUsed != FALSE) {
+            if ((g_stackLaneMap[i].providerId == providerId) &&
+                (g_stackLaneMap[i].methodId == methodId)) {
+                break;  /* Update existing selection */
+            }
+        } else if (freeSlot < 0) {
+            freeSlot = (sint8)i;
+        } else {
+            /* Keep first free slot */
+        }
+    }
+
+    if (i < PICC_STACK_LANE_MAP_SIZE) {
+        if (lane == PICC_STACK_LANE_NORMAL) {
+            g_stackLaneMap[i].isUsed = FALSE;  /* Normal lane is the default */
+        } else {
+            g_stackLaneMap[i].lane = lane;
+        }
+    } else if (lane == PICC_STACK_LANE_NORMAL) {
+        /* Nothing to remove */
+    } else if (freeSlot >= 0) {
+        g_stackLaneMap[freeSlot].providerId = providerId;
+        g_stackLaneMap[freeSlot].methodId   = methodId;
+        g_stackLaneMap[freeSlot].lane       = lane;
+        g_stackLaneMap[freeSlot].isUsed     = TRUE;
+    } else {
+        ret = -1;
+    }
+
+    taskEXIT_CRITICAL();
+
+    if (ret != 0) {
+        HANDLE_ERROR(-40);  /* Stack: lane selection table full */
+    }
+    return ret;
+}
+
+/**
+ * @brief Enable last-value-wins coalescing of a ProviderID/EventID on all channels
+ */
+sint8 PICC_StackSetCoalesce(uint8 providerId, uint8 eventId, boolean enable)
+{
+    sint8 freeSlot = -1;
+    uint32 i;
+    uint32 c;
+    sint8 ret = 0;
+
+    taskENTER_CRITICAL();
+
+    for (i = 0U; i < PICC_STACK_COALESCE_MAP_SIZE; i++) {
+        if (g_stackCoalesceMap[i].isUsed != FALSE) {
+            if ((g_stackCoalesceMap[i].providerId == providerId) &&
+                (g_stackCoalesceMap[i].eventId == eventId)) {
+                break;  /* Existing selection */
+            }
+        } else if (freeSlot < 0) {
+            freeSlot = (sint8)i;
+        } else {
+            /* Keep first free slot */
+        }
+    }
+
+    if (i < PICC_STACK_COALESCE_MAP_SIZE) {
+        if (enable == FALSE) {
+            g_stackCoalesceMap[i].isUsed = FALSE;
+        }
+    } else if (enable == FALSE) {
+        /* Nothing to remove */
+    } else if (freeSlot >= 0) {
+        i = (uint32)freeSlot;
+        /* Pending copies recorded for a previous selection of this slot are stale */
+        for (c = 0U; c < PICC_STACK_MAX_INSTANCES; c++) {
+            g_stackInstances[c].context.coalesce[i].valid = FALSE;
+        }
+        g_stackCoalesceMap[i].providerId = providerId;
+        g_stackCoalesceMap[i].eventId    = eventId;
+        g_stackCoalesceMap[i].coalesced  = 0U;
+        g_stackCoalesceMap[i].isUsed     = TRUE;
+    } else {
+        ret = -1;
+    }
+
+    taskEXIT_CRITICAL();
+
+    if (ret != 0) {
+        HANDLE_ERROR(-45);  /* Stack: coalescing selection table full */
+    }
+    return ret;
+}
+
+/**
+ * @brief Get number of events coalesced for a ProviderID/EventID selection
+ */
+uint32 PICC_StackGetCoalesced(uint8 providerId, uint8 eventId)
+{
+    uint32 i;
+
+    for (i = 0U; i < PICC_STACK_COALESCE_MAP_SIZE; i++) {
+        if ((g_stackCoalesceMap[i].isUsed != FALSE) &&
+            (g_stackCoalesceMap[i].providerId == providerId) &&
+            (g_stackCoalesceMap[i].eventId == eventId)) {
+            return g_stackCoalesceMap[i].coalesced;
+        }
+    }
+
+    return 0U;
+}
+
+/**
+ * @brief Get batching metrics of a channel
+ */
+sint8 PICC_StackGetMetrics(uint8 channelId, PICC_StackMetrics_t *metrics)
+{
+    PICC_StackInstance_t *inst;
+
+    inst = PICC_GetStackInstance(channelId);
+    if ((inst == NULL) || (inst->initialized == FALSE) || (metrics == NULL)) {
+        return -1;
+    }
+
+    taskENTER_CRITICAL();
+    *metrics = inst->metrics;
+    taskEXIT_CRITICAL();
+
+    return 0;
+}
+
+/**
+ * @brief Reset batching metrics of a channel
+ */
+void PICC_StackResetMetrics(uint8 channelId)
+{
+    PICC_StackInstance_t *inst;
+    PICC_StackMetrics_t empty = {0};
+
+    inst = PICC_GetStackInstance(channelId);
+    if (inst == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    inst->metrics = empty;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Register Rx frame loss callback (globally shared)
+ */
+sint8 PICC_StackRegisterRxLossCallback(PICC_StackRxLossCallback_t callback)
+{
+    g_stackRxLossCallback = callback;
+    return 0;
+}
+
+/**
+ * @brief Get Rx sequence statistics of a channel
+ */
+sint8 PICC_StackGetRxStats(uint8 channelId, PICC_StackRxStats_t *stats)
+{
+    PICC_StackInstance_t *inst;
+
+    inst = PICC_GetStackInstance(channelId);
+    if ((inst == NULL) || (inst->initialized == FALSE) || (stats == NULL)) {
+        return -1;
+    }
+
+    taskENTER_CRITICAL();
+    *stats = inst->rxStats;
+    taskEXIT_CRITICAL();
+
+    return 0;
+}
+
+/**
+ * @brief Reset Rx sequence statistics of a channel
+ */
+void PICC_StackResetRxStats(uint8 channelId)
+{
+    PICC_StackInstance_t *inst;
+    PICC_StackRxStats_t empty = {0};
+
+    inst = PICC_GetStackInstance(channelId);
+    if (inst == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    inst->rxStats = empty;
+    taskEXIT_CRITICAL();
+}
+
 /**
  * @brief Register message receive callback (globally shared)
  */
@@ -5,6 +5,22 @@
  * Implements message stacking functionality:
  * - Send on 10ms period or when buffer is full
  * - Add Counter(2B) + CRC16(2B) before sending
+ * - Pack messages directly into the IPCF buffer (zero-copy), falling back to
+ *   a scratch arena block (picc_arena.h) when no IPCF buffer is available
+ * - Adaptive batching: flush at once when idle, at a byte threshold or at a
+ *   per-message deadline (PICC_StackFlushTask), 10ms period as fallback
+ * - Priority lanes: high lane messages (selected per ProviderID/MethodID)
+ *   bypass aggregation and are sent at once as their own frame
+ * - Ping-pong windows: producers append to one window while the other one
+ *   is transmitted or waits for retransmission
+ * - Lock-free append: producers reserve room with an atomic fetch-add and
+ *   copy in parallel with interrupts enabled
+ * - Rx sequence tracking: gaps, duplicates, late frames and wraps of the
+ *   received frame counter are counted, duplicates optionally dropped
+ * - Heartbeat piggybacking: Ping/Pong travel as flags of the frame flag byte,
+ *   an empty control frame is sent only when no aggregate is pending
+ * - Event coalescing: for selected ProviderID/EventID a newer event replaces
+ *   the copy still pending in the aggregate (last value wins)
  *
  * Copyright 2024 NXP
  * All Rights Reserved.
@@ -33,6 +49,12 @@ extern "C" {
 #define PICC_STACK_CRC_ENABLED          (0x00U)  /**< CRC enabled */
 #define PICC_STACK_CRC_DISABLED         (0x01U)  /**< CRC disabled */
 
+/** Frame flag byte (byte 0): CRC enable flag + heartbeat state of the sender */
+#define PICC_STACK_FLAG_CRC_MASK        (0x01U)  /**< CRC enable flag bit */
+#define PICC_STACK_FLAG_HB_PING         (0x40U)  /**< Heartbeat: sender asks for a sign of life */
+#define PICC_STACK_FLAG_HB_PONG         (0x80U)  /**< Heartbeat: answer to a Ping flag */
+#define PICC_STACK_FLAG_HB_MASK         (PICC_STACK_FLAG_HB_PING | PICC_STACK_FLAG_HB_PONG)
+
 /** Stack buffer maximum size (supports up to 4095 bytes IPCF frame + 5 bytes overhead) */
 #define PICC_STACK_MAX_SIZE             (4100U)
 
@@ -48,6 +70,39 @@ extern "C" {
 /** Maximum payload size */
 #define PICC_STACK_PAYLOAD_MAX_SIZE     (PICC_STACK_MAX_SIZE - PICC_STACK_OVERHEAD_SIZE)
 
+/** Upper bound of a stacked frame; the effective limit is the largest IPCF pool buffer of the channel */
+#define PICC_STACK_SHM_FRAME_SIZE       (4096U)
+
+/** Number of stack windows per channel (ping-pong) */
+#define PICC_STACK_WINDOW_NUM           (2U)
+
+/** Upper bound of the payload size of a stack window */
+#define PICC_STACK_SHM_PAYLOAD_MAX_SIZE (PICC_STACK_SHM_FRAME_SIZE - PICC_STACK_OVERHEAD_SIZE)
+
+/** Default flush threshold: send once stacked data reaches this size (bytes, 0 = only when full) */
+#define PICC_STACK_FLUSH_THRESHOLD      (1024U)
+
+/** Default per-message deadline: max queuing delay before send (ms, 0 = period only) */
+#define PICC_STACK_FLUSH_DEADLINE_MS    (1U)
+
+/** Default idle flush: send first message at once when channel is idle */
+#define PICC_STACK_FLUSH_ON_IDLE        (TRUE)
+
+/** Channel is idle when no frame was sent for at least this time (ms) */
+#define PICC_STACK_IDLE_GAP_MS          (2U)
+
+/** Maximum number of ProviderID/MethodID lane selections */
+#define PICC_STACK_LANE_MAP_SIZE        (8U)
+
+/** Lane selection wildcard: all methods of a provider */
+#define PICC_STACK_LANE_ANY_METHOD      (PICC_INVALID_ID)
+
+/** Maximum number of ProviderID/EventID coalescing selections */
+#define PICC_STACK_COALESCE_MAP_SIZE    (8U)
+
+/** Default Rx duplicate policy: drop frames whose counter was already received */
+#define PICC_STACK_RX_DROP_DUPLICATES   (FALSE)
+
 /*==================================================================================================
  *                                         Callback Function Types
  *==================================================================================================*/
@@ -72,6 +127,44 @@ typedef void (*PICC_StackMsgCallback_t)(const PICC_MsgHeader_t *header,
                                         const uint8 *payload, uint16 len,
                                         uint8 instanceId, uint8 channelId);
 
+/**
+ * @brief Rx frame loss callback function type (Rx task context)
+ * 
+ * @param[in] channelId Channel ID
+ * @param[in] expected  Counter expected next
+ * @param[in] received  Counter received
+ * @param[in] lost      Frames missing in between
+ */
+typedef void (*PICC_StackRxLossCallback_t)(uint8 channelId, uint16 expected,
+                                           uint16 received, uint16 lost);
+
+/*==================================================================================================
+ *                                         Enum Types
+ *==================================================================================================*/
+
+/**
+ * @brief Reason a stacked frame was sent
+ */
+typedef enum {
+    PICC_STACK_FLUSH_REASON_PERIOD = 0U,    /**< Periodic task (PICC_StackProcess) */
+    PICC_STACK_FLUSH_REASON_FULL,           /**< Next message did not fit */
+    PICC_STACK_FLUSH_REASON_EXPLICIT,       /**< PICC_StackFlushChannel() */
+    PICC_STACK_FLUSH_REASON_IDLE,           /**< First message on idle channel */
+    PICC_STACK_FLUSH_REASON_THRESHOLD,      /**< Byte threshold reached */
+    PICC_STACK_FLUSH_REASON_DEADLINE,       /**< Oldest message reached its deadline */
+    PICC_STACK_FLUSH_REASON_HIGH_LANE,      /**< High priority lane message */
+    PICC_STACK_FLUSH_REASON_HEARTBEAT,      /**< Heartbeat flag (Pong, or control frame) */
+    PICC_STACK_FLUSH_REASON_NUM             /**< Number of flush reasons */
+} PICC_StackFlushReason_e;
+
+/**
+ * @brief Stack lane
+ */
+typedef enum {
+    PICC_STACK_LANE_NORMAL = 0U,    /**< Aggregated with other messages (default) */
+    PICC_STACK_LANE_HIGH            /**< Sent at once as its own frame, bypassing aggregation */
+} PICC_StackLane_e;
+
 /*==================================================================================================
  *                                         Structure Definitions
  *==================================================================================================*/
@@ -84,17 +177,120 @@ typedef struct {
     uint16  maxSize;        /**< Maximum stack size */
     uint16  periodMs;       /**< Send period (ms) */
     boolean crcEnabled;     /**< CRC enable flag (TRUE=enabled, default) */
+    uint16  flushThreshold; /**< Send once stacked data reaches this size (bytes, 0 = only when full) */
+    uint16  flushDeadlineMs; /**< Max queuing delay of a message (ms, 0 = period only) */
+    boolean flushOnIdle;    /**< Send first message at once when channel is idle */
+    boolean highLaneEnabled; /**< Honor high priority lane selections on this channel */
+    boolean rxDropDuplicates; /**< Drop received frames whose counter was already seen */
 } PICC_StackConfig_t;
 
+/**
+ * @brief Stack Rx sequence statistics (per channel)
+ * 
+ * Counters follow the Tx counter scheme of the remote: +1 per frame,
+ * 0 skipped on wrap. A frame far behind the newest one (remote restart)
+ * restarts tracking (resyncs).
+ */
+typedef struct {
+    uint32  frames;                 /**< Frames with valid CRC */
+    uint32  gaps;                   /**< Jumps forward (frames missing) */
+    uint32  lostFrames;             /**< Frames missing in total (late frames subtracted) */
+    uint32  duplicates;             /**< Frames with a counter already received */
+    uint32  reordered;              /**< Late frames filling an earlier gap */
+    uint32  wraps;                  /**< Counter wraps */
+    uint32  resyncs;                /**< Tracking restarts */
+    uint32  dropped;                /**< Duplicates dropped by policy */
+} PICC_StackRxStats_t;
+
+/**
+ * @brief Stack batching metrics (per channel)
+ * 
+ * Queuing delay is measured for the oldest message of each frame, i.e. the
+ * worst delay of that frame, in FreeRTOS ticks.
+ * Average batch = messages / frames, average delay = totalDelayTicks / frames.
+ */
+typedef struct {
+    uint32  frames;                 /**< Frames sent */
+    uint32  messages;               /**< Messages sent */
+    uint32  bytes;                  /**< Stacked bytes sent (without frame overhead) */
+    uint16  maxBatchMsgs;           /**< Largest frame (messages) */
+    uint16  maxBatchBytes;          /**< Largest frame (stacked bytes) */
+    uint32  totalDelayTicks;        /**< Sum of queuing delays */
+    uint32  maxDelayTicks;          /**< Largest queuing delay */
+    uint32  flushCount[PICC_STACK_FLUSH_REASON_NUM]; /**< Frames sent per flush reason */
+    uint32  reserveRetries;         /**< Append reservations retried on contention */
+    uint32  commitWaits;            /**< Flushes postponed by a copy still in progress */
+    uint32  coalesced;              /**< Events replaced in place by a newer value */
+    uint32  windowGrows;            /**< Full windows moved to a larger buffer */
+} PICC_StackMetrics_t;
+
+/**
+ * @brief Stack window (one half of the ping-pong context)
+ * 
+ * When shmBuf is set, pending messages are packed at shmBuf[1..N] and
+ * buffer is unused; otherwise they are packed at buffer[0..N-1], a scratch
+ * arena block held until the frame is sent. A window with neither has no
+ * room (IPCF buffers and arena exhausted).
+ * 
+ * The IPCF buffer is the smallest pool buffer fitting the first message and
+ * the expected frame size; a window that fills up is moved to a larger one
+ * (or to an arena block) before it is flushed.
+ * 
+ * Producers reserve [offset, offset+len) by fetch-add on reserved, copy
+ * without any lock and then add len to committed. A flush closes the window
+ * (closed flag in reserved) and transmits it once committed has caught up.
+ */
+typedef struct {
+    uint8  *buffer;                          /**< Fallback buffer (arena block) when no IPCF buffer, NULL if none */
+    uint8  *shmBuf;                          /**< IPCF buffer of open zero-copy window, NULL if none */
+    volatile uint32 reserved;                /**< Reserved bytes | closed flag */
+    volatile uint32 committed;               /**< Bytes copied in by producers */
+    volatile uint16 msgCount;                /**< Messages in window */
+    uint16  usedSize;                        /**< Stacked bytes, fixed when window is closed */
+    uint32  openTick;                        /**< Tick the oldest message of window was added */
+    uint16  openSeq;                         /**< Incremented each time the window is (re)opened */
+    uint16  capacity;                        /**< Payload capacity of the attached buffer, 0 if none */
+} PICC_StackWindow_t;
+
+/**
+ * @brief Pending copy of a coalesced event (per channel and selection)
+ * 
+ * Valid while window[winIdx] is still open with the same openSeq.
+ */
+typedef struct {
+    uint32  offset;                          /**< Offset of the message in window data */
+    uint16  len;                             /**< Message length (header + payload) */
+    uint16  openSeq;                         /**< openSeq of the window when added */
+    uint8   winIdx;                          /**< Window holding the message */
+    boolean valid;                           /**< Pending copy recorded */
+    volatile boolean busy;                   /**< Being replaced by a producer */
+} PICC_StackCoalesceSlot_t;
+
 /**
  * @brief Stack buffer context
+ * 
+ * Producers append to window[activeIdx]. A flush swaps the windows under
+ * critical section and transmits the other window outside of it, so
+ * producers are not locked out by acquire/copy/CRC/IPCF Tx. A frame that
+ * could not be sent stays in the other window (txPending) and is retried
+ * first by the next flush, while producers keep filling the active window.
  */
 typedef struct {
-    uint8   buffer[PICC_STACK_MAX_SIZE];    /**< Stack buffer */
-    uint16  usedSize;                        /**< Used size */
+    PICC_StackWindow_t window[PICC_STACK_WINDOW_NUM]; /**< Ping-pong windows */
+    volatile uint8 activeIdx;                /**< Window producers append to */
+    volatile boolean txPending;              /**< Other window holds a frame to (re)transmit */
+    volatile boolean txBusy;                 /**< Other window being transmitted */
+    uint32  lastTxTick;                      /**< Tick the last frame was sent */
+    volatile boolean flushRequest;           /**< Flush requested from flush task */
+    uint8   flushReason;                     /**< Reason of flush request @see PICC_StackFlushReason_e */
     uint16  txCounter;                       /**< Transmit counter */
-    uint16  rxCounter;                       /**< Receive counter (for verification) */
+    PICC_FrameSeq_t rxSeq;                   /**< Receive counter tracking */
     boolean timerRunning;                    /**< Is timer running */
+    volatile boolean creditEvent;            /**< IPCF Tx credits replenished since last check */
+    volatile uint8 hbFlags;                  /**< Heartbeat flags for the next frame */
+    uint16  maxFrameSize;                    /**< Largest frame: largest IPCF pool buffer of the channel */
+    uint16  frameEstimate;                   /**< Running average of sent frame payloads (bytes) */
+    PICC_StackCoalesceSlot_t coalesce[PICC_STACK_COALESCE_MAP_SIZE]; /**< Per coalescing selection */
 } PICC_StackContext_t;
 
 /*==================================================================================================
@@ -128,6 +324,21 @@ void PICC_StackDeinitChannel(uint8 channelId);
  */
 sint8 PICC_StackAddMessageToChannel(uint8 channelId, const uint8 *data, uint32 len);
 
+/**
+ * @brief Add message given as packed header + payload to channel's stack buffer
+ * 
+ * Same as PICC_StackAddMessageToChannel(), header and payload are copied
+ * straight into the stack window so no packing buffer is needed.
+ * 
+ * @param[in] channelId  Channel ID
+ * @param[in] header     Packed protocol header (PICC_HEADER_SIZE bytes)
+ * @param[in] payload    Payload data (can be NULL if payloadLen is 0)
+ * @param[in] payloadLen Payload length
+ * @return 0 on success, non-zero on failure
+ */
+sint8 PICC_StackAddMessageParts(uint8 channelId, const uint8 *header,
+                                const uint8 *payload, uint16 payloadLen);
+
 /**
  * @brief Immediately send specified channel stack buffer contents
  * 
@@ -138,6 +349,20 @@ sint8 PICC_StackAddMessageToChannel(uint8 channelId, const uint8 *data, uint32 l
  */
 sint8 PICC_StackFlushChannel(uint8 channelId);
 
+/**
+ * @brief Send heartbeat flag with the next frame of a channel
+ * 
+ * The flag rides on the pending aggregate (a Pong flushes it at once).
+ * Without pending data an empty control frame
+ * [Flags 1B][Counter 2B][CRC16 2B] is sent; if that is not possible the
+ * flag stays pending and is sent by PICC_StackProcess().
+ * 
+ * @param[in] channelId Channel ID
+ * @param[in] hbFlag    PICC_STACK_FLAG_HB_PING or PICC_STACK_FLAG_HB_PONG
+ * @return 0 on success, non-zero if the flag is still pending
+ */
+sint8 PICC_StackSendHeartbeat(uint8 channelId, uint8 hbFlag);
+
 /**
  * @brief Process received stacked data
  * 
@@ -169,6 +394,114 @@ void PICC_StackClearBuffer(uint8 channelId);
  */
 sint8 PICC_StackRegisterMsgCallback(PICC_StackMsgCallback_t callback);
 
+/**
+ * @brief Get IPCF Tx credits for the pending stacked frame
+ * 
+ * Non-blocking query of free A-core buffers large enough for the frame that
+ * would be sent now (at least one protocol header). When 0 is returned, the
+ * credit event of the channel is armed (see PICC_StackTakeCreditEvent).
+ * 
+ * @param[in] channelId Channel ID
+ * @return Number of available Tx credits, 0 if none or invalid channel
+ */
+uint32 PICC_StackGetTxCredits(uint8 channelId);
+
+/**
+ * @brief Check and clear the Tx credits replenished event
+ * 
+ * The event is set from IPCF Rx context when the A-core releases buffers after
+ * a failed send, so producers can retry as soon as credits are back instead of
+ * waiting for a blind backoff.
+ * 
+ * @param[in] channelId Channel ID
+ * @return TRUE if credits were replenished since last call
+ */
+boolean PICC_StackTakeCreditEvent(uint8 channelId);
+
+/**
+ * @brief Select the lane of a ProviderID/MethodID on all channels
+ * 
+ * High lane messages are not aggregated: each is sent at once as its own
+ * small frame, ahead of the pending aggregate of the channel. If that is not
+ * possible (e.g. no IPCF buffer free), the message joins the aggregate and
+ * the aggregate is flushed at once instead.
+ * An exact ProviderID/MethodID selection takes precedence over a
+ * PICC_STACK_LANE_ANY_METHOD selection of the same provider.
+ * 
+ * @param[in] providerId ProviderID (message header byte 0)
+ * @param[in] methodId   MethodID (message header byte 1), or PICC_STACK_LANE_ANY_METHOD
+ * @param[in] lane       Lane (PICC_STACK_LANE_NORMAL removes the selection)
+ * @return 0 on success, non-zero on failure (selection table full)
+ */
+sint8 PICC_StackSetLane(uint8 providerId, uint8 methodId, PICC_StackLane_e lane);
+
+/**
+ * @brief Enable last-value-wins coalescing of a ProviderID/EventID on all channels
+ * 
+ * While an event of the selection is still pending in the aggregate of a
+ * channel (window not yet closed for transmission), a newer event with the
+ * same ConsumerID, message type and length overwrites it in place instead of
+ * being appended, so only the latest value is sent. Otherwise the event is
+ * appended as usual. Meant for periodic state events whose older values are
+ * stale once a newer one exists; an overwritten WITH_ACK event is never
+ * acknowledged. High lane events are sent at once and not coalesced.
+ * 
+ * @param[in] providerId ProviderID (message header byte 0)
+ * @param[in] eventId    EventID (message header byte 1)
+ * @param[in] enable     TRUE to coalesce, FALSE to remove the selection
+ * @return 0 on success, non-zero on failure (selection table full)
+ */
+sint8 PICC_StackSetCoalesce(uint8 providerId, uint8 eventId, boolean enable);
+
+/**
+ * @brief Get number of events coalesced for a ProviderID/EventID selection
+ * 
+ * @param[in] providerId ProviderID
+ * @param[in] eventId    EventID
+ * @return Events replaced in place on all channels, 0 if not selected
+ */
+uint32 PICC_StackGetCoalesced(uint8 providerId, uint8 eventId);
+
+/**
+ * @brief Register Rx frame loss callback (globally shared)
+ * 
+ * @param[in] callback Callback function (NULL to remove)
+ * @return 0 on success
+ */
+sint8 PICC_StackRegisterRxLossCallback(PICC_StackRxLossCallback_t callback);
+
+/**
+ * @brief Get Rx sequence statistics of a channel
+ * 
+ * @param[in]  channelId Channel ID
+ * @param[out] stats     Statistics snapshot
+ * @return 0 on success, non-zero on failure
+ */
+sint8 PICC_StackGetRxStats(uint8 channelId, PICC_StackRxStats_t *stats);
+
+/**
+ * @brief Reset Rx sequence statistics of a channel
+ * 
+ * @param[in] channelId Channel ID
+ */
+void PICC_StackResetRxStats(uint8 channelId);
+
+/**
+ * @brief Get batching metrics of a channel
+ * 
+ * @param[in]  channelId Channel ID
+ * @param[out] metrics   Metrics snapshot
+ * @return 0 on success, non-zero on failure
+ */
+sint8 PICC_StackGetMetrics(uint8 channelId, PICC_StackMetrics_t *metrics);
+
+/**
+ * @brief Reset batching metrics of a channel
+ * 
+ * @param[in] channelId Channel ID
+ */
+void PICC_StackResetMetrics(uint8 channelId);
+
 /**
  * @brief Process all stack channels - send buffered data
  * 
@@ -176,6 +509,18 @@ sint8 PICC_StackRegisterMsgCallback(PICC_StackMsgCallback_t callback);
  */
 void PICC_StackProcess(void);
 
+/**
+ * @brief Stack flush task - adaptive batching
+ * 
+ * Woken by task notification when a channel requests an idle or threshold
+ * flush, and by timeout when the oldest pending message of a channel reaches
+ * its deadline. Created by the application, same priority as the PICC
+ * periodic task so a burst from an equal priority producer is batched.
+ * 
+ * @param[in] pvParameters Unused
+ */
+void PICC_StackFlushTask(void *pvParameters);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -2,9 +2,11 @@
  * @file picc_trace.c
  * @brief M-Core Inter-Core Communication Debug Trace - Implementation
  *
- * Implements TX/RX data trace for TRACE32 debugging observation.
- * Uses 2D circular buffer to record periodic TX/RX data.
- * Data format per row: data[row][0]=channelId, data[row][1]=dataLen, data[row][2..]=actual data
+ * Implements TX/RX message trace for TRACE32 debugging observation.
+ * One binary record per message in a lock-free ring (non-cacheable RAM):
+ * writers reserve a record with an atomic increment of head, fill it and
+ * publish it by writing its sequence number last. No critical section,
+ * several tasks may trace at the same time.
  *
  * Copyright 2024 NXP
  * All Rights Reserved.
@@ -18,241 +20,179 @@ extern "C" {
 #include "FreeRTOS.h"
 #include "task.h"
 
+/*==================================================================================================
+ *                                         Private Macros
+ *==================================================================================================*/
+
+/** DWT cycle counter, enabled by portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() */
+#define PICC_TRACE_DWT_CYCCNT       (*(volatile uint32 *)0xE0001004U)
+
+/** Aggregate frame overhead: [CRC_Enable 1B] ... [Counter 2B][CRC 2B] */
+#define PICC_TRACE_FRAME_HEAD       (1U)
+#define PICC_TRACE_FRAME_TAIL       (4U)
+
+#if defined(__GNUC__)
+/** Reserve record (returns previous head) */
+#define PICC_TRACE_RESERVE()        __atomic_fetch_add(&g_piccTrace.head, 1U, __ATOMIC_RELAXED)
+/** Publish record: contents visible before seq */
+#define PICC_TRACE_PUBLISH(r, s)    __atomic_store_n(&(r)->seq, (s), __ATOMIC_RELEASE)
+#else
+#error "picc_trace.c: atomic builtins required for the trace ring"
+#endif
+
 /*==================================================================================================
  *                                         Global Variables
  *==================================================================================================*/
-#define TX_RX_FILETER    1
+
 /**
- * @brief Global trace data - accessible in TRACE32
- * 
- * Usage in TRACE32:
- *   g_piccTrace.tx.data[row][0] = channelId
- *   g_piccTrace.tx.data[row][1] = dataLen
- *   g_piccTrace.tx.data[row][2..] = actual TX data
- *   g_piccTrace.tx.writeIndex = last written row
- *   
- *   g_piccTrace.rx.data[row][0] = channelId
- *   g_piccTrace.rx.data[row][1] = dataLen
- *   g_piccTrace.rx.data[row][2..] = actual RX data
- *   g_piccTrace.rx.writeIndex = last written row
+ * @brief Global trace ring - accessible in TRACE32
+ *
+ * Non-cacheable: the debugger reads SRAM directly while the M7 runs.
  */
-PICC_ChannelTrace_t g_piccTrace = {0};
+PICC_TraceRing_t g_piccTrace
+    __attribute__((section(".mcal_bss_no_cacheable")));
 
 /*==================================================================================================
- *                                         Public Functions
+ *                                         Private Functions
  *==================================================================================================*/
 
 /**
- * @brief Initialize trace module
+ * @brief Write one record
+ *
+ * @param[in] msgPtr     Protocol message, NULL for a frame-only record
+ * @param[in] payloadLen Payload length of the message
  */
-void PICC_TraceInit(void)
+static void PICC_TraceWrite(uint8 dir, uint8 channelId, uint32 timestamp, uint16 frameCounter,
+                            uint32 len, const uint8 *msgPtr, uint16 payloadLen)
 {
-    uint32 row;
-    uint32 col;
-    
-    /* Clear TX buffer */
-    for (row = 0U; row < PICC_TRACE_MAX_ROWS; row++) {
-        for (col = 0U; col < PICC_TRACE_MAX_COLS; col++) {
-            g_piccTrace.tx.data[row][col] = 0U;
+    PICC_TraceRecord_t *rec;
+    uint32 copyLen = 0U;
+    uint32 idx;
+    uint32 i;
+
+    /* Reserve record - owned exclusively until published */
+    idx = PICC_TRACE_RESERVE();
+    rec = &g_piccTrace.rec[idx & (PICC_TRACE_DEPTH - 1U)];
+    rec->seq = 0U;  /* Incomplete while being written */
+
+    rec->timestamp    = timestamp;
+    rec->channelId    = channelId;
+    rec->dir          = dir;
+    rec->frameCounter = frameCounter;
+    rec->frameLen     = (len > 0xFFFFU) ? 0xFFFFU : (uint16)len;
+    if (msgPtr != NULL) {
+        rec->flags = 0U;
+        for (i = 0U; i < PICC_HEADER_SIZE; i++) {
+            rec->header[i] = msgPtr[i];
         }
-    }
-    g_piccTrace.tx.writeIndex = 0U;
-    
-    /* Clear RX buffer */
-    for (row = 0U; row < PICC_TRACE_MAX_ROWS; row++) {
-        for (col = 0U; col < PICC_TRACE_MAX_COLS; col++) {
-            g_piccTrace.rx.data[row][col] = 0U;
+        copyLen = (payloadLen < PICC_TRACE_PAYLOAD_BYTES) ? payloadLen : PICC_TRACE_PAYLOAD_BYTES;
+        for (i = 0U; i < copyLen; i++) {
+            rec->payload[i] = msgPtr[PICC_HEADER_SIZE + i];
+        }
+    } else {
+        rec->flags = PICC_TRACE_FLAG_FRAME_ONLY;
+        for (i = 0U; i < PICC_HEADER_SIZE; i++) {
+            rec->header[i] = 0U;
         }
     }
-    g_piccTrace.rx.writeIndex = 0U;
+    for (i = copyLen; i < PICC_TRACE_PAYLOAD_BYTES; i++) {
+        rec->payload[i] = 0U;
+    }
+
+    PICC_TRACE_PUBLISH(rec, idx + 1U);
 }
 
 /**
- * @brief Record TX data - Parse stacked packet and store each message separately
- * 
- * Stacked packet format: [CRC_Enable 1B][N protocol messages...][Counter 2B][CRC 2B]
+ * @brief Record every message of an aggregate frame
+ *
+ * Frame format: [CRC_Enable 1B][N protocol messages...][Counter 2B][CRC 2B]
  * Each protocol message: [Header 8B][Payload variable]
- * Header format: [ProviderID][MethodID][ConsumerID][SessionID][MsgType][ReturnCode][Length 2B big-endian]
- * 
- * Output per row: data[row][0]=channelId, data[row][1]=msgLen, data[row][2..]=single message
+ * A frame without any traced message (heartbeat only) gets a frame-only
+ * record, so a frame counter gap in the trace is a real gap.
  */
-void PICC_TraceTx(uint8 channelId, const uint8 *data, uint32 len)
+static void PICC_TraceFrame(uint8 dir, uint8 channelId, const uint8 *data, uint32 len)
 {
-    uint32 col;
-    uint8 row;
+    const uint8 *msgPtr;
+    uint32 timestamp;
     uint32 offset;
+    uint32 end;
     uint32 msgLen;
+    uint32 numTraced = 0U;
     uint16 payloadLen;
-    uint32 copyLen;
-    const uint8 *msgPtr;
-    
-    if (data == NULL || len == 0U) {
+    uint16 frameCounter;
+
+    if ((data == NULL) || (g_piccTrace.enabled == 0U)) {
         return;
     }
-    
-    /* Minimum stacked packet: [CRC_Enable 1B][Header 8B][Counter 2B][CRC 2B] = 13 bytes */
-    if (len < 13U) {
+
+    /* Minimum frame: [CRC_Enable 1B][Counter 2B][CRC 2B] = 5 bytes (empty heartbeat frame) */
+    if (len < (PICC_TRACE_FRAME_HEAD + PICC_TRACE_FRAME_TAIL)) {
         return;
     }
-    
-    /* [FIX] Enter critical section to protect trace buffer from concurrent access */
-    taskENTER_CRITICAL();
-    
-    /* Parse stacked packet: skip CRC_Enable byte (offset 0), parse messages until Counter/CRC */
-    /* Stacked data ends at len - 4 (2B counter + 2B CRC) */
-    offset = 1U;  /* Skip CRC_Enable byte */
-    
-    while (offset + PICC_HEADER_SIZE <= (len - 4U)) {
+
+    timestamp = PICC_TRACE_DWT_CYCCNT;
+    end = len - PICC_TRACE_FRAME_TAIL;
+    frameCounter = ((uint16)data[end] << 8U) | (uint16)data[end + 1U];
+
+    for (offset = PICC_TRACE_FRAME_HEAD; (offset + PICC_HEADER_SIZE) <= end; offset += msgLen) {
         msgPtr = &data[offset];
-        
-        /* [USER REQUEST] Filter only ping/pong messages (ProviderID=0xFF or MethodID=0xFF)
-         * Keep all other messages including Link (MethodID=0x00) and all application messages. */
-        if ((msgPtr[0] == 0xFFU) || (msgPtr[1] == 0xFFU)) {
-            /* Skip ping/pong message: parse its length and move to next */
-            payloadLen = ((uint16)msgPtr[6] << 8U) | (uint16)msgPtr[7];
-            offset += PICC_HEADER_SIZE + payloadLen;
-            continue;
-        }
-        
-        /* Get payload length from header bytes 6-7 (big-endian) */
         payloadLen = ((uint16)msgPtr[6] << 8U) | (uint16)msgPtr[7];
         msgLen = PICC_HEADER_SIZE + payloadLen;
-        
+
         /* Sanity check: message should not exceed remaining data */
-        if (offset + msgLen > (len - 4U)) {
+        if ((offset + msgLen) > end) {
             break;
         }
-        
-        /* Get current write row */
-        row = g_piccTrace.tx.writeIndex;
-        
-        /* data[row][0] = channelId */
-        g_piccTrace.tx.data[row][0] = channelId;
-        
-        /* data[row][1] = msgLen (single message length) */
-        g_piccTrace.tx.data[row][1] = (msgLen > 255U) ? 255U : (uint8)msgLen;
-        
-        /* Limit copy length (reserve 2 bytes for channelId and msgLen) */
-        copyLen = msgLen;
-        if (copyLen > (PICC_TRACE_MAX_COLS - 2U)) {
-            copyLen = PICC_TRACE_MAX_COLS - 2U;
-        }
-        
-        /* Copy single message starting from column 2 */
-        for (col = 0U; col < copyLen; col++) {
-            g_piccTrace.tx.data[row][col + 2U] = msgPtr[col];
-        }
-        
-        /* Clear remaining columns */
-        for (col = copyLen + 2U; col < PICC_TRACE_MAX_COLS; col++) {
-            g_piccTrace.tx.data[row][col] = 0U;
-        }
-        
-        /* Update write index (circular) */
-        g_piccTrace.tx.writeIndex++;
-        if (g_piccTrace.tx.writeIndex >= PICC_TRACE_MAX_ROWS) {
-            g_piccTrace.tx.writeIndex = 0U;
+
+        if ((PICC_TRACE_SKIP_HEARTBEAT != FALSE) &&
+            ((msgPtr[0] == 0xFFU) || (msgPtr[1] == 0xFFU))) {
+            continue;
         }
-        
-        /* Move to next message in stacked packet */
-        offset += msgLen;
+
+        PICC_TraceWrite(dir, channelId, timestamp, frameCounter, len, msgPtr, payloadLen);
+        numTraced++;
+    }
+
+    if (numTraced == 0U) {
+        PICC_TraceWrite(dir, channelId, timestamp, frameCounter, len, NULL, 0U);
     }
-    
-    taskEXIT_CRITICAL();
 }
 
+/*==================================================================================================
+ *                                         Public Functions
+ *==================================================================================================*/
+
 /**
- * @brief Record RX data - Parse stacked packet and store each message separately
- * 
- * Stacked packet format: [CRC_Enable 1B][N protocol messages...][Counter 2B][CRC 2B]
- * Each protocol message: [Header 8B][Payload variable]
- * Header format: [ProviderID][MethodID][ConsumerID][SessionID][MsgType][ReturnCode][Length 2B big-endian]
- * 
- * Output per row: data[row][0]=channelId, data[row][1]=msgLen, data[row][2..]=single message
+ * @brief Initialize trace module
  */
-void PICC_TraceRx(uint8 channelId, const uint8 *data, uint32 len)
+void PICC_TraceInit(void)
 {
-    uint32 col;
-    uint8 row;
-    uint32 offset;
-    uint32 msgLen;
-    uint16 payloadLen;
-    uint32 copyLen;
-    const uint8 *msgPtr;
-    
-    if (data == NULL || len == 0U) {
-        return;
-    }
-    
-    /* Minimum stacked packet: [CRC_Enable 1B][Header 8B][Counter 2B][CRC 2B] = 13 bytes */
-    if (len < 13U) {
-        return;
-    }
-    
-    /* [FIX] Enter critical section to protect trace buffer from concurrent access */
-    taskENTER_CRITICAL();
-    
-    /* Parse stacked packet: skip CRC_Enable byte (offset 0), parse messages until Counter/CRC */
-    /* Stacked data ends at len - 4 (2B counter + 2B CRC) */
-    offset = 1U;  /* Skip CRC_Enable byte */
-    
-    while (offset + PICC_HEADER_SIZE <= (len - 4U)) {
-        msgPtr = &data[offset];
-        
-        /* [USER REQUEST] Filter only ping/pong messages (ProviderID=0xFF or MethodID=0xFF)
-         * Keep all other messages including Link (MethodID=0x00) and all application messages. */
-        if ((msgPtr[0] == 0xFFU) || (msgPtr[1] == 0xFFU)) {
-            /* Skip ping/pong message: parse its length and move to next */
-            payloadLen = ((uint16)msgPtr[6] << 8U) | (uint16)msgPtr[7];
-            offset += PICC_HEADER_SIZE + payloadLen;
-            continue;
-        }
-        
-        /* Get payload length from header bytes 6-7 (big-endian) */
-        payloadLen = ((uint16)msgPtr[6] << 8U) | (uint16)msgPtr[7];
-        msgLen = PICC_HEADER_SIZE + payloadLen;
-        
-        /* Sanity check: message should not exceed remaining data */
-        if (offset + msgLen > (len - 4U)) {
-            break;
-        }
-        
-        /* Get current write row */
-        row = g_piccTrace.rx.writeIndex;
-        
-        /* data[row][0] = channelId */
-        g_piccTrace.rx.data[row][0] = channelId;
-        
-        /* data[row][1] = msgLen (single message length) */
-        g_piccTrace.rx.data[row][1] = (msgLen > 255U) ? 255U : (uint8)msgLen;
-        
-        /* Limit copy length (reserve 2 bytes for channelId and msgLen) */
-        copyLen = msgLen;
-        if (copyLen > (PICC_TRACE_MAX_COLS - 2U)) {
-            copyLen = PICC_TRACE_MAX_COLS - 2U;
-        }
-        
-        /* Copy single message starting from column 2 */
-        for (col = 0U; col < copyLen; col++) {
-            g_piccTrace.rx.data[row][col + 2U] = msgPtr[col];
-        }
-        
-        /* Clear remaining columns */
-        for (col = copyLen + 2U; col < PICC_TRACE_MAX_COLS; col++) {
-            g_piccTrace.rx.data[row][col] = 0U;
-        }
-        
-        /* Update write index (circular) */
-        g_piccTrace.rx.writeIndex++;
-        if (g_piccTrace.rx.writeIndex >= PICC_TRACE_MAX_ROWS) {
-            g_piccTrace.rx.writeIndex = 0U;
-        }
-        
-        /* Move to next message in stacked packet */
-        offset += msgLen;
+    uint32 i;
+
+    g_piccTrace.enabled = 0U;
+    for (i = 0U; i < PICC_TRACE_DEPTH; i++) {
+        g_piccTrace.rec[i].seq = 0U;
     }
-    
-    taskEXIT_CRITICAL();
+    g_piccTrace.head        = 0U;
+    g_piccTrace.depth       = PICC_TRACE_DEPTH;
+    g_piccTrace.cyclesPerUs = (uint32)(configCPU_CLOCK_HZ / 1000000UL);
+    g_piccTrace.enabled     = 1U;
+}
+
+/**
+ * @brief Record TX data - one record per message of the stacked packet
+ */
+void PICC_TraceTx(uint8 channelId, const uint8 *data, uint32 len)
+{
+    PICC_TraceFrame(PICC_TRACE_DIR_TX, channelId, data, len);
+}
+
+/**
+ * @brief Record RX data - one record per message of the stacked packet
+ */
+void PICC_TraceRx(uint8 channelId, const uint8 *data, uint32 len)
+{
+    PICC_TraceFrame(PICC_TRACE_DIR_RX, channelId, data, len);
 }
 
 /**
@@ -264,9 +204,9 @@ void PICC_TraceClear(void)
 }
 
 /**
- * @brief Get trace buffer pointer for external access
+ * @brief Get trace ring pointer for external access
  */
-PICC_ChannelTrace_t* PICC_TraceGetChannel(uint8 channelId)
+PICC_TraceRing_t* PICC_TraceGetChannel(uint8 channelId)
 {
     (void)channelId;  /* Unused, kept for API compatibility */
     return &g_piccTrace;
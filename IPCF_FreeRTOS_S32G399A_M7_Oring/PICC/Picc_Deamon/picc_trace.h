@@ -2,9 +2,12 @@
  * @file picc_trace.h
  * @brief M-Core Inter-Core Communication Debug Trace - Interface Definition
  *
- * Provides TX/RX data trace for TRACE32 debugging observation.
- * Uses 2D array to record multiple entries for periodic data observation.
- * Data format per row: data[row][0]=channelId, data[row][1]=dataLen, data[row][2..]=actual data
+ * Provides TX/RX message trace for TRACE32 debugging observation.
+ * Every message of a sent/received aggregate is recorded as one compact binary
+ * record (DWT timestamp, channel, frame counter, header, truncated payload,
+ * sequence number) in a lock-free ring placed in non-cacheable RAM, so the
+ * debugger reads it coherently while the target runs.
+ * debug_scripts/picc_trace_timeline.cmm decodes the ring into a timeline.
  *
  * Copyright 2024 NXP
  * All Rights Reserved.
@@ -23,82 +26,111 @@ extern "C" {
  *                                         Macro Definitions
  *==================================================================================================*/
 
-/** Maximum data columns per trace entry (increased to capture full stacked packets) */
-#define PICC_TRACE_MAX_COLS    (32U)
+/** Trace ring depth in records (power of 2, override from build settings) */
+#ifndef PICC_TRACE_DEPTH
+#define PICC_TRACE_DEPTH            (256U)
+#endif
+
+#if (PICC_TRACE_DEPTH == 0U) || ((PICC_TRACE_DEPTH & (PICC_TRACE_DEPTH - 1U)) != 0U)
+#error "PICC_TRACE_DEPTH: must be a power of 2"
+#endif
+
+/** Payload bytes kept per record (rest truncated) */
+#define PICC_TRACE_PAYLOAD_BYTES    (8U)
 
-/** Maximum trace entries (rows) for periodic observation */
-#define PICC_TRACE_MAX_ROWS    (10U)
+/** Skip heartbeat ping/pong messages (ProviderID=0xFF or MethodID=0xFF) */
+#define PICC_TRACE_SKIP_HEARTBEAT   (TRUE)
+
+/** Record direction */
+#define PICC_TRACE_DIR_TX           (0U)
+#define PICC_TRACE_DIR_RX           (1U)
+
+/**
+ * Record flags: frame-only record, written for a frame without any traced
+ * message (heartbeat only), so the frame counter sequence stays complete.
+ * Header and payload are zero.
+ */
+#define PICC_TRACE_FLAG_FRAME_ONLY  (0x0001U)
 
 /*==================================================================================================
  *                                         Type Definitions
  *==================================================================================================*/
 
 /**
- * @brief Trace buffer structure (TX or RX)
- * 
- * 2D circular buffer for periodic data observation in TRACE32:
- *   data[row][0] = channelId
- *   data[row][1] = dataLen (actual payload length)
- *   data[row][2..] = actual payload data
- * 
- * writeIndex indicates the next row to be written (circular).
+ * @brief Trace record (32 bytes, one per message, or one per frame without
+ *        traced message)
+ *
+ * seq is written last: 0 = never written, otherwise ring position + 1.
+ * A record is complete when seq is non-zero and matches its position.
  */
 typedef struct {
-    uint8   data[PICC_TRACE_MAX_ROWS][PICC_TRACE_MAX_COLS];  /**< 2D data buffer */
-    uint8   writeIndex;                                       /**< Current write row index */
-} PICC_TraceBuffer_t;
+    volatile uint32 seq;                                /**< Sequence number (1, 2, ...) */
+    uint32  timestamp;                                  /**< DWT cycle counter */
+    uint8   channelId;                                  /**< IPCF channel ID */
+    uint8   dir;                                        /**< PICC_TRACE_DIR_TX / PICC_TRACE_DIR_RX */
+    uint16  frameCounter;                               /**< Counter of the aggregate frame */
+    uint8   header[PICC_HEADER_SIZE];                   /**< Protocol header (wire format) */
+    uint8   payload[PICC_TRACE_PAYLOAD_BYTES];          /**< First payload bytes (zero padded) */
+    uint16  frameLen;                                   /**< Length of the aggregate frame */
+    uint16  flags;                                      /**< PICC_TRACE_FLAG_xxx */
+} PICC_TraceRecord_t;
 
 /**
- * @brief Complete trace data structure
+ * @brief Trace ring
+ *
+ * head counts records ever reserved; the newest record is
+ * rec[(head - 1) % depth]. Writers reserve with an atomic increment and
+ * own their record exclusively, no critical section.
  */
 typedef struct {
-    PICC_TraceBuffer_t tx;  /**< TX trace buffer */
-    PICC_TraceBuffer_t rx;  /**< RX trace buffer */
-} PICC_ChannelTrace_t;
+    volatile uint32 head;                               /**< Records reserved */
+    volatile uint32 enabled;                            /**< 0 stops recording (freeze for dump) */
+    uint32  depth;                                      /**< PICC_TRACE_DEPTH */
+    uint32  cyclesPerUs;                                /**< Timestamp ticks per microsecond */
+    PICC_TraceRecord_t rec[PICC_TRACE_DEPTH];           /**< Records */
+} PICC_TraceRing_t;
 
 /*==================================================================================================
  *                                         Global Variables (for TRACE32)
  *==================================================================================================*/
 
-/** 
- * @brief Trace data - accessible in TRACE32
- * 
- * g_piccTrace.tx.data[row][0] = channelId
- * g_piccTrace.tx.data[row][1] = dataLen
- * g_piccTrace.tx.data[row][2..] = TX data
- * g_piccTrace.tx.writeIndex = current write position
- * 
- * g_piccTrace.rx.data[row][0] = channelId
- * g_piccTrace.rx.data[row][1] = dataLen
- * g_piccTrace.rx.data[row][2..] = RX data
- * g_piccTrace.rx.writeIndex = current write position
+/**
+ * @brief Trace ring - accessible in TRACE32 (non-cacheable RAM)
+ *
+ * g_piccTrace.head             = records reserved so far
+ * g_piccTrace.enabled          = set to 0 to freeze the ring
+ * g_piccTrace.rec[n].seq       = sequence number
+ * g_piccTrace.rec[n].header[]  = ProviderID, MethodID, ConsumerID, SessionID,
+ *                                MsgType, ReturnCode, Length (BE)
+ * g_piccTrace.rec[n].flags     = PICC_TRACE_FLAG_FRAME_ONLY: frame without
+ *                                traced message
  */
-extern PICC_ChannelTrace_t g_piccTrace;
+extern PICC_TraceRing_t g_piccTrace;
 
 /*==================================================================================================
  *                                         Function Declarations
  *==================================================================================================*/
 
 /**
- * @brief Initialize trace module
+ * @brief Initialize trace module (clears ring, enables recording)
  */
 void PICC_TraceInit(void);
 
 /**
  * @brief Record TX data
- * 
+ *
  * @param[in] channelId Channel ID
- * @param[in] data      Data to record
- * @param[in] len       Data length
+ * @param[in] data      Aggregate frame
+ * @param[in] len       Frame length
  */
 void PICC_TraceTx(uint8 channelId, const uint8 *data, uint32 len);
 
 /**
  * @brief Record RX data
- * 
+ *
  * @param[in] channelId Channel ID
- * @param[in] data      Data to record
- * @param[in] len       Data length
+ * @param[in] data      Aggregate frame
+ * @param[in] len       Frame length
  */
 void PICC_TraceRx(uint8 channelId, const uint8 *data, uint32 len);
 
@@ -108,12 +140,12 @@ void PICC_TraceRx(uint8 channelId, const uint8 *data, uint32 len);
 void PICC_TraceClear(void);
 
 /**
- * @brief Get trace buffer pointer for external access
- * 
+ * @brief Get trace ring pointer for external access
+ *
  * @param[in] channelId Channel ID (unused, kept for API compatibility)
- * @return Pointer to trace structure
+ * @return Pointer to trace ring
  */
-PICC_ChannelTrace_t* PICC_TraceGetChannel(uint8 channelId);
+PICC_TraceRing_t* PICC_TraceGetChannel(uint8 channelId);
 
 #if defined(__cplusplus)
 }
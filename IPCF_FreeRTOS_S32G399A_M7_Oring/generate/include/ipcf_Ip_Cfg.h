@@ -39,6 +39,8 @@ extern "C"{
 
 void ctrl_chan_rx_cb(void *arg, const uint8 instance, uint8 chan_id, void *mem);
 void data_chan_rx_cb(void *arg, const uint8 instance, uint8 chan_id, void *buf, uint32 size);
+void data_chan_rx_batch_cb(void *arg, const uint8 instance, uint8 chan_id,
+		const struct ipc_shm_buf *bufs, uint32 num_bufs);
 
 extern const void* rx_cb_arg;
 
@@ -114,6 +114,7 @@ static struct ipc_shm_channel_cfg ipcf_shm_cfg_channels0[3] = {
 				.pools = ipcf_shm_cfg_buf_pools0_1,
 				.rx_cb = data_chan_rx_cb,
 				.cb_arg = &rx_cb_arg,
+				.rx_batch_cb = data_chan_rx_batch_cb,
 			},
 		},
 	},
@@ -125,6 +126,7 @@ static struct ipc_shm_channel_cfg ipcf_shm_cfg_channels0[3] = {
 				.pools = ipcf_shm_cfg_buf_pools0_2,
 				.rx_cb = data_chan_rx_cb,
 				.cb_arg = &rx_cb_arg,
+				.rx_batch_cb = data_chan_rx_batch_cb,
 			},
 		},
 	},
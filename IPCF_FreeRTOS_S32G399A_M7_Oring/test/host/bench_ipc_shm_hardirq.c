@@ -0,0 +1,202 @@
+/**
+ * @file bench_ipc_shm_hardirq.c
+ * @brief Host measurement: IPCF inter-core ISR cost for 1 to 8 instances
+ *
+ * Builds the FreeRTOS OS layer and the S32G3 hardware layer of IPCF and times
+ * ipc_shm_hardirq() (shared ISR) with one instance ringing and with all
+ * instances ringing, and ipc_shm_hardirq_instance() (rx interrupt per
+ * instance) for reference. Up to four instances share an MSCM rx interrupt
+ * (one per remote core: A53, M7_1, M7_2, M7_3 seen from M7_0), more take a
+ * second one.
+ *
+ * The MSCM inter-core status registers are plain host memory mapped at their
+ * target address, IP_MSCM is the host copy in stub/ipcf/S32G399A_MSCM.h.
+ * Every measurement is repeated several times and keeps its shortest mean,
+ * so host preemption does not show up.
+ *
+ * Build and run against a source tree T (this tree: T=../..) from this directory:
+ *   gcc -std=gnu99 -O2 -Wall -DIPCF_TYPES -DCPU_TYPE=64 -DDISABLE_MCAL_INTERMODULE_ASR_CHECK \
+ *       -DS32G3XX -DIPC_SHM_MAX_INSTANCES=8U -Istub/ipcf -Istub -I$T/IPCF/src/common \
+ *       -I$T/IPCF/src/os -I$T/IPCF/src/hw -I$T/IPCF/src/hw/s32g3xx -I$T/generate/include \
+ *       bench_ipc_shm_hardirq.c $T/IPCF/src/os/freertos/ipc-os-freertos.c \
+ *       $T/IPCF/src/hw/s32g3xx/ipc-hw-s32g3xx.c -o bench_ipc_shm_hardirq
+ *   ./bench_ipc_shm_hardirq
+ *
+ * For a before/after comparison build the same file against a second
+ * checkout (git worktree add <dir> <revision>) and compare the reports.
+ * Host times are only comparable with each other, not with the M7: on the
+ * target every MSCM status read is a peripheral access.
+ *
+ * Copyright 2024 NXP
+ * All Rights Reserved.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+#include "ipc-shm.h"
+#include "ipc-os.h"
+#include "ipc-hw.h"
+#include "ipc-hw-platform.h"
+
+#define BENCH_MAX_INSTANCES     (8U)
+#define BENCH_PER_LINE          (4U)
+#define BENCH_CALLS             (200000UL)
+#define BENCH_RUNS              (5U)
+
+/* Page holding the MSCM inter-core status registers */
+#define BENCH_MSCM_PAGE         ((uintptr)IPC_IRCP0ISR0 & ~(uintptr)0xFFFU)
+#define BENCH_MSCM_MAP_SIZE     (0x2000U)
+
+MSCM_Type g_hostMscm;
+
+void HostEnterCritical(void)
+{
+}
+
+void HostExitCritical(void)
+{
+}
+
+/* Rx interrupt and remote core of each instance, local core is M7_0 */
+static const sint16 g_rxIrq[2] = {(sint16)MSCM_INT0_IRQn, (sint16)MSCM_INT1_IRQn};
+static const uint8 g_rxMsi[2] = {0U, 1U};
+static const struct ipc_shm_remote_core g_remote[BENCH_PER_LINE] = {
+    { .type = IPC_CORE_A53, .index = IPC_CORE_INDEX_0 },
+    { .type = IPC_CORE_M7, .index = IPC_CORE_INDEX_1 },
+    { .type = IPC_CORE_M7, .index = IPC_CORE_INDEX_2 },
+    { .type = IPC_CORE_M7, .index = IPC_CORE_INDEX_3 },
+};
+static const uint32 g_remoteBit[BENCH_PER_LINE] = {
+    (uint32)1U << IPC_A53_0, (uint32)1U << IPC_M7_1,
+    (uint32)1U << IPC_M7_2, (uint32)1U << IPC_M7_3
+};
+
+static struct ipc_shm_cfg g_cfg[BENCH_MAX_INSTANCES];
+
+static uint32 BenchRxCb(const uint8 instance, uint32 budget)
+{
+    (void)instance;
+    (void)budget;
+    return 0U;
+}
+
+static uint64 NowNs(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64)ts.tv_sec * 1000000000ULL) + (uint64)ts.tv_nsec;
+}
+
+/**
+ * @brief Status register of the local core (M7_0) for an MSCM rx interrupt
+ */
+static volatile uint32 *StatusReg(uint8 msi)
+{
+    return &IPC_MSCM_IRCPnIRx->IRCPnIRx[IPC_M7_0][msi].IPC_ISR;
+}
+
+/**
+ * @brief Ring instances (bit per instance) by setting their MSCM status bits
+ */
+static void Ring(uint32 instances)
+{
+    uint8 i;
+
+    for (i = 0U; i < BENCH_MAX_INSTANCES; i++) {
+        if (((instances >> i) & 1U) != 0U) {
+            *StatusReg(g_rxMsi[i / BENCH_PER_LINE]) |= g_remoteBit[i % BENCH_PER_LINE];
+        }
+    }
+}
+
+/**
+ * @brief Shortest mean time (ns) of one ISR call over BENCH_RUNS runs
+ *
+ * @param[in] instances Instances ringing before each call (bit per instance)
+ * @param[in] shared    Shared ISR, else ipc_shm_hardirq_instance() per ringing instance
+ */
+static double Measure(uint32 instances, boolean shared)
+{
+    double best = 0.0;
+    double mean;
+    uint64 start;
+    uint32 run;
+    uint32 n;
+    uint8 i;
+
+    for (run = 0U; run < BENCH_RUNS; run++) {
+        start = NowNs();
+        for (n = 0U; n < BENCH_CALLS; n++) {
+            Ring(instances);
+            if (shared != FALSE) {
+                ipc_shm_hardirq();
+            } else {
+                for (i = 0U; i < BENCH_MAX_INSTANCES; i++) {
+                    if (((instances >> i) & 1U) != 0U) {
+                        ipc_shm_hardirq_instance(i);
+                    }
+                }
+            }
+            /* the host status registers are not write-1-to-clear */
+            *StatusReg(g_rxMsi[0]) = 0U;
+            *StatusReg(g_rxMsi[1]) = 0U;
+        }
+        mean = (double)(NowNs() - start) / (double)BENCH_CALLS;
+        if ((run == 0U) || (mean < best)) {
+            best = mean;
+        }
+    }
+    return best;
+}
+
+int main(void)
+{
+    void *map;
+    uint8 num;
+    uint8 i;
+    sint8 err = IPC_SHM_E_OK;
+
+    map = mmap((void *)BENCH_MSCM_PAGE, BENCH_MSCM_MAP_SIZE, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if (map != (void *)BENCH_MSCM_PAGE) {
+        printf("bench_ipc_shm_hardirq: cannot map MSCM registers at 0x%lx\n",
+               (unsigned long)BENCH_MSCM_PAGE);
+        return 1;
+    }
+    g_hostMscm.CPXNUM = IPC_M7_0;
+
+    printf("instances  shared ISR, one rang  shared ISR, all rang  ISR per instance, all rang\n");
+    for (num = 1U; num <= BENCH_MAX_INSTANCES; num++) {
+        for (i = 0U; i < num; i++) {
+            g_cfg[i].local_core.type = IPC_CORE_M7;
+            g_cfg[i].local_core.index = IPC_CORE_INDEX_0;
+            g_cfg[i].remote_core = g_remote[i % BENCH_PER_LINE];
+            g_cfg[i].inter_core_rx_irq = g_rxIrq[i / BENCH_PER_LINE];
+            g_cfg[i].inter_core_tx_irq = IPC_IRQ_NONE;
+            if ((ipc_hw_init(i, &g_cfg[i]) != IPC_SHM_E_OK) ||
+                (ipc_os_init(i, &g_cfg[i], BenchRxCb) != IPC_SHM_E_OK)) {
+                err = -IPC_SHM_E_INVAL;
+            }
+        }
+        if (err != IPC_SHM_E_OK) {
+            printf("bench_ipc_shm_hardirq: init of %u instances failed\n", (unsigned)num);
+            return 1;
+        }
+
+        printf("%9u  %17.1f ns  %17.1f ns  %23.1f ns\n", (unsigned)num,
+               Measure((uint32)1U << (num - 1U), TRUE),
+               Measure(((uint32)1U << num) - 1U, TRUE),
+               Measure(((uint32)1U << num) - 1U, FALSE));
+
+        for (i = 0U; i < num; i++) {
+            ipc_os_free(i);
+            ipc_hw_free(i);
+        }
+    }
+
+    (void)munmap(map, BENCH_MSCM_MAP_SIZE);
+    return 0;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file bench_picc_crc16.c
+ * @brief Host measurement: CRC16 time per frame for each engine (PICC_CRC16)
+ *
+ * Times PICC_CRC16() over a full stack frame (PICC_STACK_MAX_SIZE, 4100
+ * bytes) and over a small frame (one header and 56 bytes of payload), so
+ * the flash cost of each PICC_CRC16_ENGINE (32 B, 512 B, 2 KB, 4 KB tables)
+ * can be weighed against its speed. Built once per engine, like
+ * test_picc_crc16.c. Every measurement is repeated several times and keeps
+ * its shortest mean, so host preemption does not show up.
+ *
+ * Build and run from this directory:
+ *   for e in 0 1 4 8; do
+ *     gcc -std=gnu99 -O2 -Wall -DIPCF_TYPES -DCPU_TYPE=64 -DDISABLE_MCAL_INTERMODULE_ASR_CHECK -Istub \
+ *         -I../../PICC/Picc_Deamon -I../../IPCF/src/common -I../../generate/include \
+ *         -DPICC_CRC16_ENGINE=$e bench_picc_crc16.c ../../PICC/Picc_Deamon/picc_protocol.c \
+ *         -o bench_picc_crc16 && ./bench_picc_crc16
+ *   done
+ *
+ * Host times are only comparable with each other, not with the M7.
+ *
+ * Copyright 2024 NXP
+ * All Rights Reserved.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "picc_protocol.h"
+#include "picc_stack.h"
+
+#define BENCH_SMALL_SIZE    (PICC_HEADER_SIZE + 56U)
+#define BENCH_BYTES         (200000000UL)   /* CRC bytes per run */
+#define BENCH_RUNS          (5U)
+
+int g_hostErrors = 0;
+
+static uint8 g_frame[PICC_STACK_MAX_SIZE];
+static volatile uint16 g_sink;
+
+static uint64 NowNs(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64)ts.tv_sec * 1000000000ULL) + (uint64)ts.tv_nsec;
+}
+
+/**
+ * @brief Shortest mean time (ns) of one CRC over len bytes
+ */
+static double Measure(uint32 len)
+{
+    uint32 frames = (uint32)(BENCH_BYTES / len);
+    double best = 0.0;
+    double mean;
+    uint64 start;
+    uint32 run;
+    uint32 n;
+    uint16 crc = 0U;
+
+    for (run = 0U; run < BENCH_RUNS; run++) {
+        start = NowNs();
+        for (n = 0U; n < frames; n++) {
+            /* Offset by the last CRC so every call depends on the one before */
+            g_frame[0] = (uint8)crc;
+            crc = PICC_CRC16(g_frame, len);
+        }
+        mean = (double)(NowNs() - start) / (double)frames;
+        if ((run == 0U) || (mean < best)) {
+            best = mean;
+        }
+    }
+    g_sink = crc;
+    return best;
+}
+
+int main(void)
+{
+    static const char *const names[9] = {
+        "nibble", "table", "", "", "slice4", "", "", "", "slice8"
+    };
+    uint32 i;
+    double full;
+    double small;
+
+    for (i = 0U; i < PICC_STACK_MAX_SIZE; i++) {
+        g_frame[i] = (uint8)((i * 7U) + 3U);
+    }
+
+    full = Measure(PICC_STACK_MAX_SIZE);
+    small = Measure(BENCH_SMALL_SIZE);
+
+    printf("engine %u (%s): %u B frame %.0f ns (%.2f ns/B), %u B frame %.0f ns\n",
+           (unsigned)PICC_CRC16_ENGINE, names[PICC_CRC16_ENGINE],
+           (unsigned)PICC_STACK_MAX_SIZE, full, full / (double)PICC_STACK_MAX_SIZE,
+           (unsigned)BENCH_SMALL_SIZE, small);
+    return (g_hostErrors != 0) ? 1 : 0;
+}
@@ -0,0 +1,383 @@
+/**
+ * @file bench_picc_stack_masking.c
+ * @brief Host measurement: longest interrupt-masked window of the PICC stack Tx path
+ *
+ * Runs a fixed producer workload (mixed message sizes, 10 ms period flush on
+ * a simulated tick, full-window flushes) through PICC_StackAddMessageToChannel()
+ * and times every outermost taskENTER_CRITICAL() / taskEXIT_CRITICAL() pair
+ * with the host clock. IPCF is simulated with the pools of a managed channel
+ * in ipcf_Ip_Cfg.c; the remote consumes a frame as soon as it is sent.
+ *
+ * The workload is replayed identically several times and each critical
+ * section keeps its shortest time over all runs, so host preemption does not
+ * show up as a masked window; the worst case is the longest of those.
+ *
+ * Build and run against a source tree T (this tree: T=../..) from this directory:
+ *   gcc -std=gnu99 -O2 -Wall -DIPCF_TYPES -DCPU_TYPE=64 -DDISABLE_MCAL_INTERMODULE_ASR_CHECK -Istub \
+ *       -I$T/PICC/Picc_Deamon -I$T/IPCF/src/common -I$T/generate/include \
+ *       bench_picc_stack_masking.c $T/PICC/Picc_Deamon/picc_stack.c \
+ *       $T/PICC/Picc_Deamon/picc_protocol.c -o bench_picc_stack_masking
+ *   ./bench_picc_stack_masking
+ *
+ * For a before/after comparison build the same file against a second
+ * checkout (git worktree add <dir> <revision>) and compare the reports.
+ * Host times are only comparable with each other, not with the M7.
+ *
+ * Copyright 2024 NXP
+ * All Rights Reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "picc_stack.h"
+#include "ipc-shm.h"
+#include "FreeRTOS.h"
+
+/*==================================================================================================
+ *                                         Workload
+ *==================================================================================================*/
+
+#define BENCH_CHANNEL_ID        (1U)
+#define BENCH_MESSAGES          (200000UL)
+#define BENCH_RUNS              (5U)
+#define BENCH_MSGS_PER_TICK     (8U)
+#define BENCH_IPCF_POOLS        (3U)
+#define BENCH_IPCF_MAX_BUFS     (30U)
+
+int g_hostErrors = 0;
+volatile TickType_t g_hostTick = 0U;
+
+static uint32 g_seed = 12345U;
+
+static uint32 g_nesting = 0U;
+static struct timespec g_enterTime;
+static uint32 *g_sectionNs = NULL;      /* Shortest time per critical section over all runs */
+static uint32 g_sectionCap = 0U;
+static uint32 g_sections = 0U;          /* Critical sections in current run */
+static uint32 g_run = 0U;
+
+/* Pools of a managed channel, smallest first (ipcf_Ip_Cfg.c) */
+static const uint32 g_poolBufSize[BENCH_IPCF_POOLS] = {64U, 256U, 4096U};
+static const uint32 g_poolNumBufs[BENCH_IPCF_POOLS] = {30U, 20U, 10U};
+static uint8 g_pool0[30U][64U];
+static uint8 g_pool1[20U][256U];
+static uint8 g_pool2[10U][4096U];
+static uint8 *const g_poolMem[BENCH_IPCF_POOLS] = {&g_pool0[0][0], &g_pool1[0][0], &g_pool2[0][0]};
+static boolean g_ipcfUsed[BENCH_IPCF_POOLS][BENCH_IPCF_MAX_BUFS];
+
+/*==================================================================================================
+ *                                         Host Stand-ins
+ *==================================================================================================*/
+
+void HostEnterCritical(void)
+{
+    if (g_nesting++ == 0U) {
+        (void)clock_gettime(CLOCK_MONOTONIC, &g_enterTime);
+    }
+}
+
+void HostExitCritical(void)
+{
+    struct timespec now;
+    uint64_t ns;
+
+    if (--g_nesting == 0U) {
+        (void)clock_gettime(CLOCK_MONOTONIC, &now);
+        ns = (uint64_t)(now.tv_sec - g_enterTime.tv_sec) * 1000000000ULL +
+             (uint64_t)now.tv_nsec - (uint64_t)g_enterTime.tv_nsec;
+        if (g_sections == g_sectionCap) {
+            g_sectionCap = (g_sectionCap == 0U) ? 65536U : (g_sectionCap * 2U);
+            g_sectionNs = (uint32 *)realloc(g_sectionNs, g_sectionCap * sizeof(uint32));
+            if (g_sectionNs == NULL) {
+                abort();
+            }
+        }
+        if ((g_run == 0U) || (ns < g_sectionNs[g_sections])) {
+            g_sectionNs[g_sections] = (uint32)ns;
+        }
+        g_sections++;
+    }
+}
+
+/* Pool and index of a simulated IPCF buffer, FALSE if not one */
+static boolean BenchFindBuf(const void *buf, uint32 *pool, uint32 *idx)
+{
+    uint32 p;
+    const uint8 *b = (const uint8 *)buf;
+
+    for (p = 0U; p < BENCH_IPCF_POOLS; p++) {
+        if ((b >= g_poolMem[p]) && (b < &g_poolMem[p][g_poolNumBufs[p] * g_poolBufSize[p]])) {
+            *pool = p;
+            *idx = (uint32)(b - g_poolMem[p]) / g_poolBufSize[p];
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+void *ipc_shm_acquire_buf(const uint8 instance, uint8 chan_id, uint32 mem_size)
+{
+    uint32 p;
+    uint32 i;
+
+    (void)instance;
+    (void)chan_id;
+    for (p = 0U; p < BENCH_IPCF_POOLS; p++) {
+        if (mem_size > g_poolBufSize[p]) {
+            continue;
+        }
+        for (i = 0U; i < g_poolNumBufs[p]; i++) {
+            if (g_ipcfUsed[p][i] == FALSE) {
+                g_ipcfUsed[p][i] = TRUE;
+                return &g_poolMem[p][i * g_poolBufSize[p]];
+            }
+        }
+    }
+    return NULL;
+}
+
+sint8 ipc_shm_release_buf(const uint8 instance, uint8 chan_id, const void *buf)
+{
+    uint32 p;
+    uint32 i;
+
+    (void)instance;
+    (void)chan_id;
+    if (BenchFindBuf(buf, &p, &i) == FALSE) {
+        return -1;
+    }
+    g_ipcfUsed[p][i] = FALSE;
+    return 0;
+}
+
+sint8 ipc_shm_return_buf(const uint8 instance, uint8 chan_id, const void *buf)
+{
+    return ipc_shm_release_buf(instance, chan_id, buf);
+}
+
+uint32 ipc_shm_buf_size(const uint8 instance, uint8 chan_id, const void *buf)
+{
+    uint32 p;
+    uint32 i;
+
+    (void)instance;
+    (void)chan_id;
+    return (BenchFindBuf(buf, &p, &i) != FALSE) ? g_poolBufSize[p] : 0U;
+}
+
+uint32 ipc_shm_max_buf_size(const uint8 instance, uint8 chan_id)
+{
+    (void)instance;
+    (void)chan_id;
+    return g_poolBufSize[BENCH_IPCF_POOLS - 1U];
+}
+
+sint8 ipc_shm_tx(const uint8 instance, uint8 chan_id, void *buf, uint32 size)
+{
+    (void)size;
+    /* Remote consumes the frame at once */
+    return ipc_shm_release_buf(instance, chan_id, buf);
+}
+
+uint32 ipc_shm_tx_credits(const uint8 instance, uint8 chan_id, uint32 mem_size)
+{
+    uint32 p;
+    uint32 i;
+    uint32 credits = 0U;
+
+    (void)instance;
+    (void)chan_id;
+    for (p = 0U; p < BENCH_IPCF_POOLS; p++) {
+        for (i = 0U; (mem_size <= g_poolBufSize[p]) && (i < g_poolNumBufs[p]); i++) {
+            credits += (g_ipcfUsed[p][i] == FALSE) ? 1U : 0U;
+        }
+    }
+    return credits;
+}
+
+sint8 ipc_shm_register_credit_cb(const uint8 instance, uint8 chan_id,
+        void (*credit_cb)(void *cb_arg, const uint8 instance,
+            uint8 chan_id, uint32 credits),
+        void *cb_arg)
+{
+    (void)instance;
+    (void)chan_id;
+    (void)credit_cb;
+    (void)cb_arg;
+    return 0;
+}
+
+sint8 ipc_shm_is_remote_ready(const uint8 instance)
+{
+    (void)instance;
+    return 0;
+}
+
+/* Layers above / beside the stack: not part of the measurement */
+sint8 PICC_HeartbeatHandlePing(uint8 instanceId, uint8 channelId)
+{
+    (void)instanceId;
+    (void)channelId;
+    return 0;
+}
+
+void PICC_HeartbeatNotifyRx(uint8 instanceId, uint8 channelId, uint8 hbFlags)
+{
+    (void)instanceId;
+    (void)channelId;
+    (void)hbFlags;
+}
+
+void PICC_HeartbeatReset(uint8 instanceId, uint8 channelId)
+{
+    (void)instanceId;
+    (void)channelId;
+}
+
+boolean PICC_HeartbeatIsPing(const uint8 *data, uint32 len)
+{
+    (void)data;
+    (void)len;
+    return FALSE;
+}
+
+boolean PICC_HeartbeatIsPong(const uint8 *data, uint32 len)
+{
+    (void)data;
+    (void)len;
+    return FALSE;
+}
+
+void PICC_TraceTx(uint8 channelId, const uint8 *data, uint32 len)
+{
+    (void)channelId;
+    (void)data;
+    (void)len;
+}
+
+void PICC_TraceRx(uint8 channelId, const uint8 *data, uint32 len)
+{
+    (void)channelId;
+    (void)data;
+    (void)len;
+}
+
+/* Fallback window buffers (only used when no IPCF buffer is free) */
+void *PICC_ArenaAlloc(uint32 size, int owner)
+{
+    (void)owner;
+    return malloc(size);
+}
+
+void PICC_ArenaFree(void *block)
+{
+    free(block);
+}
+
+/*==================================================================================================
+ *                                         Measurement
+ *==================================================================================================*/
+
+static uint32 BenchRand(void)
+{
+    g_seed = (g_seed * 1103515245U) + 12345U;
+    return (g_seed >> 8U);
+}
+
+/**
+ * @brief Payload size mix: mostly events, some mid-size responses, few bulk transfers
+ */
+static uint32 BenchPayloadLen(void)
+{
+    uint32 r = BenchRand() % 100U;
+
+    if (r < 70U) {
+        return 1U + (BenchRand() % 56U);
+    }
+    if (r < 95U) {
+        return 57U + (BenchRand() % 456U);
+    }
+    return 513U + (BenchRand() % 1536U);
+}
+
+static void BenchRun(uint32 *failed)
+{
+    static uint8 msg[PICC_HEADER_SIZE + 2048U];
+    static uint8 payload[2048U];
+    PICC_MsgHeader_t header = {0};
+    uint32 payloadLen;
+    uint32 len;
+    uint32 n;
+
+    header.providerId = 0x10U;
+    header.methodId   = 0x20U;
+    header.consumerId = 0x01U;
+    header.msgType    = (uint8)PICC_MSG_NOTIFICATION_WITHOUT_ACK;
+
+    for (n = 0U; n < BENCH_MESSAGES; n++) {
+        payloadLen = BenchPayloadLen();
+        len = PICC_PackMessage(msg, sizeof(msg), &header, payload,
+                               (uint16)payloadLen);
+        if (PICC_StackAddMessageToChannel(BENCH_CHANNEL_ID, msg, len) != 0) {
+            (*failed)++;
+        }
+
+        if ((n % BENCH_MSGS_PER_TICK) == (BENCH_MSGS_PER_TICK - 1U)) {
+            g_hostTick++;
+            if ((g_hostTick % PICC_STACK_SEND_PERIOD_MS) == 0U) {
+                PICC_StackProcess();
+            }
+        }
+    }
+    (void)PICC_StackFlushChannel(BENCH_CHANNEL_ID);
+}
+
+int main(void)
+{
+    PICC_StackConfig_t config = {0};
+    uint64_t totalNs = 0U;
+    uint32 worstNs = 0U;
+    uint32 sections = 0U;
+    uint32 failed = 0U;
+    uint32 i;
+
+    config.channelId = BENCH_CHANNEL_ID;
+    config.maxSize = PICC_STACK_SHM_PAYLOAD_MAX_SIZE;
+    config.periodMs = PICC_STACK_SEND_PERIOD_MS;
+    config.crcEnabled = TRUE;
+
+    for (g_run = 0U; g_run < BENCH_RUNS; g_run++) {
+        /* Same start state for every replay */
+        if (PICC_StackInitChannel(&config) != 0) {
+            printf("bench_picc_stack_masking: stack init failed\n");
+            return 1;
+        }
+        g_seed = 12345U;
+        g_sections = 0U;
+        BenchRun(&failed);
+        if ((g_run != 0U) && (g_sections != sections)) {
+            printf("bench_picc_stack_masking: run %u not identical\n", (unsigned)g_run);
+            return 1;
+        }
+        sections = g_sections;
+        PICC_StackDeinitChannel(BENCH_CHANNEL_ID);
+    }
+
+    for (i = 0U; i < sections; i++) {
+        totalNs += g_sectionNs[i];
+        if (g_sectionNs[i] > worstNs) {
+            worstNs = g_sectionNs[i];
+        }
+    }
+
+    printf("messages            : %lu (replayed %u times)\n", (unsigned long)BENCH_MESSAGES,
+           (unsigned)BENCH_RUNS);
+    printf("rejected messages   : %u\n", (unsigned)(failed / BENCH_RUNS));
+    printf("critical sections   : %.2f per message\n", (double)sections / (double)BENCH_MESSAGES);
+    printf("mean masked window  : %.0f ns\n", (double)totalNs / (double)sections);
+    printf("worst masked window : %u ns\n", (unsigned)worstNs);
+    free(g_sectionNs);
+    return 0;
+}
@@ -0,0 +1,42 @@
+/**
+ * @file FreeRTOS.h
+ * @brief Host test stand-in for the FreeRTOS kernel header
+ *
+ * Single-threaded host builds: a task is the caller itself, the tick is
+ * simulated by the test (g_hostTick, 1 ms per tick) and critical sections
+ * are forwarded to the test so it can time them.
+ *
+ * Copyright 2024 NXP
+ * All Rights Reserved.
+ */
+
+#ifndef INC_FREERTOS_H
+#define INC_FREERTOS_H
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef long     BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef void *   TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+#define pdFALSE                 ((BaseType_t)0)
+#define pdTRUE                  ((BaseType_t)1)
+#define pdPASS                  (pdTRUE)
+#define pdFAIL                  (pdFALSE)
+#define portMAX_DELAY           ((TickType_t)0xFFFFFFFFUL)
+#define configTICK_RATE_HZ      ((TickType_t)1000)
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(ms))
+#define configMAX_PRIORITIES    (8)
+#define configSUPPORT_DYNAMIC_ALLOCATION    (1)
+#define configSUPPORT_STATIC_ALLOCATION     (0)
+
+/** Simulated tick, advanced by the test */
+extern volatile TickType_t g_hostTick;
+
+/** Critical section hooks implemented by the test */
+void HostEnterCritical(void);
+void HostExitCritical(void);
+
+#endif /* INC_FREERTOS_H */
@@ -0,0 +1,29 @@
+/**
+ * @file S32G399A_M7_COMMON.h
+ * @brief Host stand-in for the S32G399A device header (interrupt numbers)
+ *
+ * Only the MSCM inter-core interrupts used by ipc-hw-s32g3xx.c. Only used by
+ * IPCF host tests built with -DS32G3XX (-Istub/ipcf).
+ *
+ * Copyright 2024 NXP
+ * All Rights Reserved.
+ */
+#ifndef S32G399A_M7_COMMON_H
+#define S32G399A_M7_COMMON_H
+
+typedef enum {
+    MSCM_INT0_IRQn = 1,
+    MSCM_INT1_IRQn = 2,
+    MSCM_INT2_IRQn = 3,
+    MSCM_INT3_IRQn = 4,
+    MSCM_INT4_IRQn = 5,
+    MSCM_INT5_IRQn = 6,
+    MSCM_INT6_IRQn = 7,
+    MCSCM_INT7_IRQn = 8,
+    MCSCM_INT8_IRQn = 9,
+    MCSCM_INT9_IRQn = 10,
+    MCSCM_INT10_IRQn = 11,
+    MCSCM_INT11_IRQn = 12
+} IRQn_Type;
+
+#endif /* S32G399A_M7_COMMON_H */
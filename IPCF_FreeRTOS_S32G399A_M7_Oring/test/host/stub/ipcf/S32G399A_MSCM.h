@@ -0,0 +1,27 @@
+/**
+ * @file S32G399A_MSCM.h
+ * @brief Host stand-in for the S32G399A MSCM header
+ *
+ * IP_MSCM points to g_hostMscm, defined by the test: processor number and
+ * interrupt routing registers. The inter-core interrupt status registers are
+ * addressed by ipc-hw-platform.h at their fixed address, which the test maps.
+ *
+ * Copyright 2024 NXP
+ * All Rights Reserved.
+ */
+#ifndef S32G399A_MSCM_H
+#define S32G399A_MSCM_H
+
+#define MSCM_CPXNUM_CPN_MASK    (0xFFU)
+#define MSCM_IRSPRC_COUNT       (240U)
+
+typedef struct {
+    volatile uint32 CPXNUM;                         /**< Processor number */
+    volatile uint16 IRSPRC[MSCM_IRSPRC_COUNT];      /**< Interrupt routing control */
+} MSCM_Type;
+
+extern MSCM_Type g_hostMscm;
+
+#define IP_MSCM                 (&g_hostMscm)
+
+#endif /* S32G399A_MSCM_H */
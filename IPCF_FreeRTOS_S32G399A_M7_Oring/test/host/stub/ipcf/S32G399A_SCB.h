@@ -0,0 +1,14 @@
+/**
+ * @file S32G399A_SCB.h
+ * @brief Host stand-in for the S32G399A SCB header
+ *
+ * Empty: the SCB is only used for cache maintenance (IPC_D_CACHE_ENABLE),
+ * which host builds leave off.
+ *
+ * Copyright 2024 NXP
+ * All Rights Reserved.
+ */
+#ifndef S32G399A_SCB_H
+#define S32G399A_SCB_H
+
+#endif /* S32G399A_SCB_H */
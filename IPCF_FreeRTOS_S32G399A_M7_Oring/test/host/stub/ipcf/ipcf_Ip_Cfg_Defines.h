@@ -0,0 +1,36 @@
+/**
+ * @file ipcf_Ip_Cfg_Defines.h
+ * @brief Host stand-in for the generated IPCF configuration defines
+ *
+ * Same limits as generate/include/ipcf_Ip_Cfg_Defines.h, but with more
+ * instances, so IPCF host tests can run both ends of a shared memory
+ * instance in one process. Only used by IPCF host tests (-Istub/ipcf).
+ *
+ * Copyright 2024 NXP
+ * All Rights Reserved.
+ */
+#ifndef IPCF_IP_CFG_DEFINES_H
+#define IPCF_IP_CFG_DEFINES_H
+
+#define IPCF_IP_CFG_DEFINES_VENDOR_ID                    43
+#define IPCF_IP_CFG_DEFINES_MODULE_ID                    255
+#define IPCF_IP_CFG_DEFINES_AR_RELEASE_MAJOR_VERSION     4
+#define IPCF_IP_CFG_DEFINES_AR_RELEASE_MINOR_VERSION     4
+#define IPCF_IP_CFG_DEFINES_AR_RELEASE_REVISION_VERSION  0
+#define IPCF_IP_CFG_DEFINES_SW_MAJOR_VERSION             4
+#define IPCF_IP_CFG_DEFINES_SW_MINOR_VERSION             10
+#define IPCF_IP_CFG_DEFINES_SW_PATCH_VERSION             0
+
+#define IPCF_INSTANCE0           0U
+
+#ifndef IPC_SHM_MAX_INSTANCES
+#define IPC_SHM_MAX_INSTANCES       2U
+#endif
+
+#define IPC_SHM_MAX_CHANNELS       3U
+
+#define IPC_SHM_MAX_POOLS       3U
+
+#define IPC_SHM_MAX_BUFS_PER_POOL       30U
+
+#endif /* IPCF_IP_CFG_DEFINES_H */
@@ -0,0 +1,36 @@
+/**
+ * @file task.h
+ * @brief Host test stand-in for the FreeRTOS task API
+ *
+ * Copyright 2024 NXP
+ * All Rights Reserved.
+ */
+
+#ifndef INC_TASK_H
+#define INC_TASK_H
+
+#include "FreeRTOS.h"
+
+#define taskENTER_CRITICAL()            HostEnterCritical()
+#define taskEXIT_CRITICAL()             HostExitCritical()
+
+#define xTaskGetTickCount()             (g_hostTick)
+#define xTaskGetCurrentTaskHandle()     ((TaskHandle_t)0)
+#define xTaskNotifyGive(task)           ((void)(task), pdPASS)
+#define ulTaskNotifyTake(clear, ticks)  ((void)(clear), (void)(ticks), 0U)
+#define vTaskDelay(ticks)               (g_hostTick += (TickType_t)(ticks))
+#define taskYIELD()                     ((void)0)
+
+/* Task creation always succeeds, the created task never runs */
+#define xTaskCreate(fn, name, depth, param, prio, handle) \
+    ((void)(fn), (void)(name), (void)(depth), (void)(param), (void)(prio), \
+     (*(handle) = (TaskHandle_t)1), pdPASS)
+#define vTaskDelete(task)               ((void)(task))
+
+/* Interrupt context: not nested on the host, no critical section needed */
+#define taskENTER_CRITICAL_FROM_ISR()   ((UBaseType_t)0)
+#define taskEXIT_CRITICAL_FROM_ISR(s)   ((void)(s))
+#define vTaskNotifyGiveFromISR(task, woken) ((void)(task), (void)(woken))
+#define portYIELD_FROM_ISR(woken)       ((void)(woken))
+
+#endif /* INC_TASK_H */
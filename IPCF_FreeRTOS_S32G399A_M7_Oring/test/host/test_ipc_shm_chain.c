@@ -0,0 +1,317 @@
+/**
+ * @file test_ipc_shm_chain.c
+ * @brief Host test: chained buffers of managed channels (ipc-shm.c)
+ *
+ * Runs both ends of a shared memory link in one process: instance 1 is the
+ * sender and instance 0 the receiver, the local shared memory of one is the
+ * remote shared memory of the other. Single and chained messages are sent
+ * interleaved and must reach the receiver in order, a chain must be received
+ * whole through rx_chain_cb or dropped without one, and every buffer must
+ * come back to the sender. A credit callback armed by the sender must also be
+ * delivered by its own credit query when it receives nothing.
+ *
+ * Build and run from this directory:
+ *   gcc -std=gnu99 -Wall -DIPCF_TYPES -DCPU_TYPE=64 -DDISABLE_MCAL_INTERMODULE_ASR_CHECK \
+ *       -Istub/ipcf -Istub -I../../IPCF/src/common -I../../IPCF/src/os -I../../IPCF/src/hw \
+ *       -I../../generate/include test_ipc_shm_chain.c ../../IPCF/src/common/ipc-shm.c \
+ *       ../../IPCF/src/common/ipc-queue.c ../../IPCF/src/common/ipc-util.c -o test_ipc_shm_chain
+ *   ./test_ipc_shm_chain
+ *
+ * Copyright 2024 NXP
+ * All Rights Reserved.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "ipc-shm.h"
+#include "ipc-os.h"
+#include "ipc-hw.h"
+
+#define TEST_RX             (0U)    /* Receiver instance */
+#define TEST_TX             (1U)    /* Sender instance */
+#define TEST_CHAN_CHAIN     (0U)    /* Channel with rx_chain_cb */
+#define TEST_CHAN_PLAIN     (1U)    /* Channel without rx_chain_cb */
+#define TEST_SHM_SIZE       (0x10000U)
+#define TEST_LOG_LEN        (32U)
+#define TEST_CHAIN_SIZE     (1500U)
+#define TEST_BUDGET         (64U)
+
+static int g_failures = 0;
+
+/** Shared memory of both instances */
+static uint64 g_shm[2][TEST_SHM_SIZE / sizeof(uint64)];
+
+/** Receive log: first byte of every message, in delivery order */
+static uint8 g_log[TEST_LOG_LEN];
+static uint32 g_logLen = 0U;
+static uint32 g_chainBufs = 0U;
+static uint32 g_chainOk = 0U;
+static uint32 g_creditCalls = 0U;
+static uint32 g_credits = 0U;
+
+static uint32 (*g_rxCb[2])(const uint8, uint32);
+
+/*==================================================================================================
+ *                                         OS / HW Stand-ins
+ *==================================================================================================*/
+
+sint8 ipc_os_init(const uint8 instance, const struct ipc_shm_cfg *cfg,
+        uint32 (*rx_cb)(const uint8, uint32))
+{
+    (void)cfg;
+    g_rxCb[instance] = rx_cb;
+    return IPC_SHM_E_OK;
+}
+
+void ipc_os_free(const uint8 instance)
+{
+    g_rxCb[instance] = NULL;
+}
+
+uintptr ipc_os_get_local_shm(const uint8 instance)
+{
+    return (uintptr)g_shm[instance];
+}
+
+uintptr ipc_os_get_remote_shm(const uint8 instance)
+{
+    return (uintptr)g_shm[1U - instance];
+}
+
+sint8 ipc_os_poll_channels(const uint8 instance)
+{
+    return (sint8)g_rxCb[instance](instance, TEST_BUDGET);
+}
+
+sint8 ipc_hw_init(const uint8 instance, const struct ipc_shm_cfg *cfg)
+{
+    (void)instance;
+    (void)cfg;
+    return IPC_SHM_E_OK;
+}
+
+void ipc_hw_free(const uint8 instance) { (void)instance; }
+void ipc_hw_irq_enable(const uint8 instance) { (void)instance; }
+void ipc_hw_irq_disable(const uint8 instance) { (void)instance; }
+void ipc_hw_irq_notify(const uint8 instance) { (void)instance; }
+void ipc_hw_irq_clear(const uint8 instance) { (void)instance; }
+void ipc_hw_flush_cache_local(const uint8 instance) { (void)instance; }
+void ipc_hw_flush_cache_remote(const uint8 instance) { (void)instance; }
+
+/*==================================================================================================
+ *                                         Receive Callbacks
+ *==================================================================================================*/
+
+static void Log(uint8 id)
+{
+    if (g_logLen < TEST_LOG_LEN) {
+        g_log[g_logLen] = id;
+        g_logLen++;
+    }
+}
+
+static void TestRxCb(void *arg, const uint8 instance, uint8 chan_id, void *buf, uint32 size)
+{
+    (void)arg;
+    (void)size;
+    Log(*(const uint8 *)buf);
+    (void)ipc_shm_release_buf(instance, chan_id, buf);
+}
+
+static void TestRxBatchCb(void *arg, const uint8 instance, uint8 chan_id,
+        const struct ipc_shm_buf *bufs, uint32 num_bufs)
+{
+    uint32 i;
+
+    (void)arg;
+    for (i = 0U; i < num_bufs; i++) {
+        Log(*(const uint8 *)bufs[i].buf);
+    }
+    (void)ipc_shm_release_bufs(instance, chan_id, bufs, num_bufs);
+}
+
+static void TestRxChainCb(void *arg, const uint8 instance, uint8 chan_id,
+        const struct ipc_shm_chain *chain)
+{
+    static uint8 data[TEST_CHAIN_SIZE];
+    uint32 i;
+
+    (void)arg;
+    g_chainBufs = chain->num_bufs;
+    g_chainOk = (chain->total_size == TEST_CHAIN_SIZE) ? 1U : 0U;
+    if (ipc_shm_chain_gather(chain, 0U, data, TEST_CHAIN_SIZE) != TEST_CHAIN_SIZE) {
+        g_chainOk = 0U;
+    }
+    for (i = 1U; i < TEST_CHAIN_SIZE; i++) {
+        if (data[i] != (uint8)i) {
+            g_chainOk = 0U;
+        }
+    }
+    Log(data[0]);
+    (void)ipc_shm_release_chain(instance, chan_id, chain);
+}
+
+static void TestCreditCb(void *arg, const uint8 instance, uint8 chan_id, uint32 credits)
+{
+    (void)arg;
+    (void)instance;
+    (void)chan_id;
+    g_creditCalls++;
+    g_credits = credits;
+}
+
+/*==================================================================================================
+ *                                         Configuration
+ *==================================================================================================*/
+
+static struct ipc_shm_pool_cfg g_pools[3] = {
+    { .num_bufs = 8U, .buf_size = 64U },
+    { .num_bufs = 8U, .buf_size = 256U },
+    { .num_bufs = 4U, .buf_size = 1024U },
+};
+
+static struct ipc_shm_channel_cfg g_channels[2] = {
+    {
+        .type = IPC_SHM_MANAGED,
+        .ch = { .managed = { .num_pools = 3U, .pools = g_pools, .rx_cb = TestRxCb,
+                             .rx_batch_cb = TestRxBatchCb, .rx_chain_cb = TestRxChainCb } },
+    },
+    {
+        .type = IPC_SHM_MANAGED,
+        .ch = { .managed = { .num_pools = 3U, .pools = g_pools, .rx_cb = TestRxCb,
+                             .rx_batch_cb = TestRxBatchCb } },
+    },
+};
+
+static struct ipc_shm_cfg g_shmCfg[2];
+
+/*==================================================================================================
+ *                                         Test
+ *==================================================================================================*/
+
+static void Check(int cond, const char *what)
+{
+    if (!cond) {
+        printf("FAIL %s\n", what);
+        g_failures++;
+    }
+}
+
+static void SendSingle(uint8 chanId, uint8 id, uint32 size)
+{
+    uint8 *buf = (uint8 *)ipc_shm_acquire_buf(TEST_TX, chanId, size);
+
+    Check(buf != NULL, "acquire single");
+    if (buf != NULL) {
+        buf[0] = id;
+        Check(ipc_shm_tx(TEST_TX, chanId, buf, size) == IPC_SHM_E_OK, "tx single");
+    }
+}
+
+static void SendChain(uint8 chanId, uint8 id)
+{
+    static uint8 data[TEST_CHAIN_SIZE];
+    struct ipc_shm_chain chain;
+    uint32 i;
+
+    data[0] = id;
+    for (i = 1U; i < TEST_CHAIN_SIZE; i++) {
+        data[i] = (uint8)i;
+    }
+    Check(ipc_shm_acquire_chain(TEST_TX, chanId, TEST_CHAIN_SIZE, &chain) > 1U, "acquire chain");
+    Check(ipc_shm_chain_scatter(&chain, 0U, data, TEST_CHAIN_SIZE) == TEST_CHAIN_SIZE, "scatter");
+    Check(ipc_shm_tx_chain(TEST_TX, chanId, &chain) == IPC_SHM_E_OK, "tx chain");
+}
+
+static void ExpectLog(const uint8 *ids, uint32 num, const char *what)
+{
+    uint32 i;
+
+    if ((g_logLen != num) || (memcmp(g_log, ids, num) != 0)) {
+        printf("FAIL %s: got", what);
+        for (i = 0U; i < g_logLen; i++) {
+            printf(" %u", (unsigned)g_log[i]);
+        }
+        printf("\n");
+        g_failures++;
+    }
+    g_logLen = 0U;
+}
+
+int main(void)
+{
+    static const uint8 inOrder[] = {1U, 2U, 3U, 4U, 5U};
+    static const uint8 chainDropped[] = {1U, 3U};
+    static const uint8 large[] = {6U, 7U, 8U, 9U};
+    uint8 *big[4];
+    struct ipc_shm_instances_cfg instCfg = { .num_instances = 2U, .shm_cfg = g_shmCfg };
+    struct ipc_shm_chain chain;
+    uint32 credits;
+    uint8 i;
+
+    for (i = 0U; i < 2U; i++) {
+        g_shmCfg[i].local_shm_addr = (uintptr)g_shm[i];
+        g_shmCfg[i].remote_shm_addr = (uintptr)g_shm[1U - i];
+        g_shmCfg[i].shm_size = TEST_SHM_SIZE;
+        g_shmCfg[i].num_channels = 2U;
+        g_shmCfg[i].channels = g_channels;
+    }
+    Check(ipc_shm_init(&instCfg) == IPC_SHM_E_OK, "init");
+    Check(ipc_shm_is_remote_ready(TEST_TX) == IPC_SHM_E_OK, "remote ready");
+    credits = ipc_shm_tx_credits(TEST_TX, TEST_CHAN_CHAIN, 1U);
+    Check(credits == 20U, "initial credits");
+
+    /* Batched singles before and after a chain: delivered in send order */
+    SendSingle(TEST_CHAN_CHAIN, 1U, 40U);
+    SendSingle(TEST_CHAN_CHAIN, 2U, 200U);
+    SendChain(TEST_CHAN_CHAIN, 3U);
+    SendSingle(TEST_CHAN_CHAIN, 4U, 40U);
+    SendSingle(TEST_CHAN_CHAIN, 5U, 40U);
+    (void)ipc_shm_poll_channels(TEST_RX);
+    ExpectLog(inOrder, (uint32)sizeof(inOrder), "order around chain");
+    Check((g_chainOk != 0U) && (g_chainBufs == 2U), "chain contents");
+    Check(ipc_shm_tx_credits(TEST_TX, TEST_CHAN_CHAIN, 1U) == credits, "credits back (chain cb)");
+
+    /* No rx_chain_cb: chain dropped and released, no piece delivered */
+    SendSingle(TEST_CHAN_PLAIN, 1U, 40U);
+    SendChain(TEST_CHAN_PLAIN, 2U);
+    SendSingle(TEST_CHAN_PLAIN, 3U, 40U);
+    (void)ipc_shm_poll_channels(TEST_RX);
+    ExpectLog(chainDropped, (uint32)sizeof(chainDropped), "chain dropped");
+    Check(ipc_shm_tx_credits(TEST_TX, TEST_CHAN_PLAIN, 1U) == credits, "credits back (dropped)");
+
+    /* Message larger than all free buffers: nothing acquired */
+    Check(ipc_shm_acquire_chain(TEST_TX, TEST_CHAN_CHAIN, 8U * 1024U, &chain) == 0U,
+          "chain above free buffers");
+    Check(chain.num_bufs == 0U, "empty chain");
+    Check(ipc_shm_tx_credits(TEST_TX, TEST_CHAN_CHAIN, 1U) == credits, "credits unchanged");
+
+    /* Credit callback of a sender that receives nothing: delivered by its query */
+    Check(ipc_shm_register_credit_cb(TEST_TX, TEST_CHAN_CHAIN, TestCreditCb, NULL) == IPC_SHM_E_OK,
+          "register credit cb");
+    for (i = 0U; i < 4U; i++) {
+        big[i] = (uint8 *)ipc_shm_acquire_buf(TEST_TX, TEST_CHAN_CHAIN, 1000U);
+        Check(big[i] != NULL, "acquire large");
+    }
+    Check(ipc_shm_acquire_buf(TEST_TX, TEST_CHAN_CHAIN, 1000U) == NULL, "large exhausted");
+    for (i = 0U; i < 4U; i++) {
+        big[i][0] = (uint8)(6U + i);
+        Check(ipc_shm_tx(TEST_TX, TEST_CHAN_CHAIN, big[i], 1000U) == IPC_SHM_E_OK, "tx large");
+    }
+    (void)ipc_shm_poll_channels(TEST_RX);
+    ExpectLog(large, (uint32)sizeof(large), "large released");
+    Check(g_creditCalls == 0U, "no callback before the sender looks");
+    Check(ipc_shm_tx_credits(TEST_TX, TEST_CHAN_CHAIN, 40U) != 0U, "small credits");
+    Check((g_creditCalls == 1U) && (g_credits == 4U), "credit callback from query");
+    (void)ipc_shm_tx_credits(TEST_TX, TEST_CHAN_CHAIN, 40U);
+    Check(g_creditCalls == 1U, "credit callback once per arming");
+
+    ipc_shm_free();
+
+    if (g_failures != 0) {
+        printf("test_ipc_shm_chain: %d failure(s)\n", g_failures);
+        return 1;
+    }
+    printf("test_ipc_shm_chain: OK\n");
+    return 0;
+}
@@ -0,0 +1,229 @@
+/**
+ * @file test_picc_arena.c
+ * @brief Host test: scratch arena (size-class free lists, owner quotas)
+ *
+ * Random allocate / free / handoff churn over all owners, checking that live
+ * blocks never overlap and that the statistics add up. Once everything is
+ * freed, the neighbours must have merged again: every owner in turn gets its
+ * whole quota, and the default arena holds a fragment buffer, the stack
+ * fallback windows and a Method response at the same time.
+ *
+ * Build and run from this directory:
+ *   gcc -std=gnu99 -Wall -DIPCF_TYPES -DCPU_TYPE=64 -DDISABLE_MCAL_INTERMODULE_ASR_CHECK -Istub \
+ *       -I../../PICC/Picc_Deamon -I../../IPCF/src/common -I../../generate/include \
+ *       test_picc_arena.c ../../PICC/Picc_Deamon/picc_arena.c -o test_picc_arena
+ *   ./test_picc_arena
+ *
+ * Copyright 2024 NXP
+ * All Rights Reserved.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "picc_arena.h"
+#include "picc_frag.h"
+#include "FreeRTOS.h"
+
+#define TEST_BLOCKS     (64U)
+#define TEST_STEPS      (200000UL)
+
+int g_hostErrors = 0;
+volatile TickType_t g_hostTick = 0U;
+
+static int g_failures = 0;
+static uint32 g_seed = 4711U;
+
+typedef struct {
+    uint8  *ptr;
+    uint32  size;
+    PICC_ArenaOwner_e owner;
+    uint8   fill;
+} TestBlock_t;
+
+static TestBlock_t g_blocks[TEST_BLOCKS];
+
+static const uint32 g_quota[PICC_ARENA_OWNER_NUM] = {
+    0U, PICC_ARENA_QUOTA_STACK, PICC_ARENA_QUOTA_FRAG_TX,
+    PICC_ARENA_QUOTA_FRAG_RX, PICC_ARENA_QUOTA_SERVICE
+};
+
+void HostEnterCritical(void)
+{
+}
+
+void HostExitCritical(void)
+{
+}
+
+static uint32 TestRand(void)
+{
+    g_seed = (g_seed * 1103515245U) + 12345U;
+    return (g_seed >> 8U);
+}
+
+static void Check(int cond, const char *what)
+{
+    if (!cond) {
+        printf("FAIL %s\n", what);
+        g_failures++;
+    }
+}
+
+/**
+ * @brief Request size mix: mostly small, some up to the largest block
+ */
+static uint32 TestSize(void)
+{
+    uint32 r = TestRand() % 100U;
+
+    if (r < 60U) {
+        return 1U + (TestRand() % 64U);
+    }
+    if (r < 90U) {
+        return 65U + (TestRand() % 4032U);
+    }
+    return 4097U + (TestRand() % 12288U);
+}
+
+/**
+ * @brief Live blocks keep their contents and never overlap
+ */
+static void CheckBlocks(void)
+{
+    uint32 i;
+    uint32 j;
+    uint32 k;
+
+    for (i = 0U; i < TEST_BLOCKS; i++) {
+        if (g_blocks[i].ptr == NULL) {
+            continue;
+        }
+        for (k = 0U; k < g_blocks[i].size; k++) {
+            if (g_blocks[i].ptr[k] != g_blocks[i].fill) {
+                Check(0, "block contents overwritten");
+                return;
+            }
+        }
+        for (j = i + 1U; j < TEST_BLOCKS; j++) {
+            if ((g_blocks[j].ptr != NULL) &&
+                (g_blocks[i].ptr < (g_blocks[j].ptr + g_blocks[j].size)) &&
+                (g_blocks[j].ptr < (g_blocks[i].ptr + g_blocks[i].size))) {
+                Check(0, "blocks overlap");
+                return;
+            }
+        }
+    }
+}
+
+static void FreeBlock(TestBlock_t *b)
+{
+    PICC_ArenaFree(b->ptr);
+    b->ptr = NULL;
+}
+
+int main(void)
+{
+    PICC_ArenaStats_t stats;
+    void *full[PICC_ARENA_OWNER_NUM];
+    uint32 usedBy[PICC_ARENA_OWNER_NUM];
+    uint32 used;
+    uint32 n;
+    uint32 i;
+    TestBlock_t *b;
+
+    Check(PICC_ArenaAlloc(0U, PICC_ARENA_OWNER_STACK) == NULL, "zero size");
+    Check(PICC_ArenaAlloc(16U, PICC_ARENA_OWNER_FREE) == NULL, "owner FREE");
+    Check(PICC_ArenaAlloc(PICC_ARENA_QUOTA_STACK, PICC_ARENA_OWNER_STACK) == NULL,
+          "block above quota");
+
+    for (n = 0U; n < TEST_STEPS; n++) {
+        b = &g_blocks[TestRand() % TEST_BLOCKS];
+        if (b->ptr != NULL) {
+            if ((b->owner == PICC_ARENA_OWNER_FRAG_RX) && ((TestRand() % 4U) == 0U)) {
+                /* Reassembled message delivered to the service layer */
+                Check(PICC_ArenaHandoff(b->ptr, PICC_ARENA_OWNER_FRAG_RX,
+                                        PICC_ARENA_OWNER_SERVICE) == 0, "handoff");
+                b->owner = PICC_ARENA_OWNER_SERVICE;
+            } else {
+                FreeBlock(b);
+            }
+        } else {
+            b->size = TestSize();
+            b->owner = (PICC_ArenaOwner_e)(1U + (TestRand() % (PICC_ARENA_OWNER_NUM - 1U)));
+            b->fill = (uint8)TestRand();
+            b->ptr = (uint8 *)PICC_ArenaAlloc(b->size, b->owner);
+            if (b->ptr != NULL) {
+                Check(((uintptr)b->ptr % PICC_ARENA_ALIGN) == 0U, "alignment");
+                memset(b->ptr, b->fill, b->size);
+            }
+        }
+
+        if ((n % 1000U) == 0U) {
+            CheckBlocks();
+            (void)PICC_ArenaGetStats(&stats);
+            memset(usedBy, 0, sizeof(usedBy));
+            used = 0U;
+            for (i = 0U; i < TEST_BLOCKS; i++) {
+                if (g_blocks[i].ptr != NULL) {
+                    usedBy[g_blocks[i].owner] += PICC_ARENA_BLOCK_SIZE(g_blocks[i].size);
+                    used += PICC_ARENA_BLOCK_SIZE(g_blocks[i].size);
+                }
+            }
+            /* A block may be a few bytes larger than asked (unsplit rest) */
+            Check(stats.used >= used, "used bytes");
+            Check(stats.used <= PICC_ARENA_SIZE, "used within arena");
+            for (i = 1U; i < PICC_ARENA_OWNER_NUM; i++) {
+                Check(stats.usedBy[i] >= usedBy[i], "used bytes per owner");
+                Check(stats.chargedTo[i] <= g_quota[i], "quota");
+            }
+        }
+    }
+
+    CheckBlocks();
+    for (i = 0U; i < TEST_BLOCKS; i++) {
+        if (g_blocks[i].ptr != NULL) {
+            FreeBlock(&g_blocks[i]);
+        }
+    }
+    (void)PICC_ArenaGetStats(&stats);
+    Check(stats.used == 0U, "all freed");
+    Check(stats.overQuota != 0U, "quota refusals exercised");
+
+    /* Every owner alone gets its whole quota (neighbours merged again) */
+    for (i = 1U; i < PICC_ARENA_OWNER_NUM; i++) {
+        full[i] = PICC_ArenaAlloc(g_quota[i] - PICC_ARENA_BLOCK_OVERHEAD, (PICC_ArenaOwner_e)i);
+        Check(full[i] != NULL, "full quota after churn");
+        PICC_ArenaFree(full[i]);
+    }
+
+    /* Shared arena: fragment buffer, fallback windows and a response at once */
+    full[PICC_ARENA_OWNER_FRAG_RX] = PICC_ArenaAlloc(PICC_FRAG_MAX_SIZE, PICC_ARENA_OWNER_FRAG_RX);
+    full[PICC_ARENA_OWNER_STACK] = PICC_ArenaAlloc(PICC_ARENA_QUOTA_STACK - PICC_ARENA_BLOCK_OVERHEAD,
+                                                   PICC_ARENA_OWNER_STACK);
+    full[PICC_ARENA_OWNER_SERVICE] = PICC_ArenaAlloc(PICC_MAX_PAYLOAD_SIZE, PICC_ARENA_OWNER_SERVICE);
+    Check((full[PICC_ARENA_OWNER_FRAG_RX] != NULL) && (full[PICC_ARENA_OWNER_STACK] != NULL) &&
+          (full[PICC_ARENA_OWNER_SERVICE] != NULL), "default arena use case");
+    (void)PICC_ArenaGetStats(&stats);
+    n = stats.failures;
+    Check(PICC_ArenaAlloc(PICC_MAX_PAYLOAD_SIZE, PICC_ARENA_OWNER_FRAG_TX) == NULL, "arena full");
+    (void)PICC_ArenaGetStats(&stats);
+    Check(stats.failures == (n + 1U), "refused by the arena, not by the quota");
+    PICC_ArenaFree(full[PICC_ARENA_OWNER_FRAG_RX]);
+    PICC_ArenaFree(full[PICC_ARENA_OWNER_STACK]);
+    PICC_ArenaFree(full[PICC_ARENA_OWNER_SERVICE]);
+
+    /* Foreign and double frees are rejected */
+    PICC_ArenaFree(&g_seed);
+    Check(g_hostErrors == 1, "foreign free");
+    full[1] = PICC_ArenaAlloc(100U, PICC_ARENA_OWNER_STACK);
+    PICC_ArenaFree(full[1]);
+    PICC_ArenaFree(full[1]);
+    Check(g_hostErrors == 2, "double free");
+
+    if (g_failures != 0) {
+        printf("test_picc_arena: %d failure(s)\n", g_failures);
+        return 1;
+    }
+    printf("test_picc_arena: OK\n");
+    return 0;
+}
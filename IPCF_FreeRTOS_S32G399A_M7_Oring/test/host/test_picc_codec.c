@@ -0,0 +1,221 @@
+/**
+ * @file test_picc_codec.c
+ * @brief Host test: generated payload codecs (picc_codec.h)
+ *
+ * Expands the generator for a test service using every field kind and for
+ * the power service description (picc_pwr_svc.h), runs the generated
+ * <Svc>_SelfTest() round trips and checks TAIL truncation: a power ack
+ * longer than PWR_MAX_PAYLOAD_LEN is still decoded and handled.
+ *
+ * Build and run from this directory:
+ *   gcc -std=gnu99 -Wall -DIPCF_TYPES -DCPU_TYPE=64 -DDISABLE_MCAL_INTERMODULE_ASR_CHECK -Istub \
+ *       -I../../PICC/Picc_Deamon -I../../IPCF/src/common -I../../generate/include \
+ *       test_picc_codec.c -o test_picc_codec
+ *   ./test_picc_codec
+ *
+ * Copyright 2024 NXP
+ * All Rights Reserved.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+/* Test build: generate <Svc>_SelfTest() */
+#define PICC_CODEC_SELFTEST_ENABLE  (1)
+#include "picc_pwr_svc.h"
+
+int g_hostErrors = 0;
+
+static int g_failures = 0;
+static uint8 g_lastMethod = 0U;
+static uint16 g_lastInfoLen = 0U;
+static uint16 g_lastInfoWireLen = 0U;
+
+/*==================================================================================================
+ *                                         Test Service (every field kind)
+ *==================================================================================================*/
+
+#define Tst_PROVIDER_ID             (0x7EU)
+
+#define Tst_MESSAGES(X) \
+    X(Tst, Fixed, EVENT,  1U) \
+    X(Tst, Mixed, METHOD, 2U) \
+    X(Tst, Tail,  METHOD, 3U)
+
+#define Tst_Fixed_FIELDS(U8, U16, U32, ARR, VAR, TAIL) \
+    U8(a)      \
+    U16(b)     \
+    U32(c)     \
+    ARR(d, 3U)
+
+#define Tst_Mixed_FIELDS(U8, U16, U32, ARR, VAR, TAIL) \
+    U16(a)     \
+    VAR(v, 5U) \
+    U8(b)
+
+#define Tst_Tail_FIELDS(U8, U16, U32, ARR, VAR, TAIL) \
+    U32(a)     \
+    TAIL(t, 4U)
+
+PICC_CODEC_DECLARE_SERVICE(Tst)
+PICC_CODEC_DEFINE_SERVICE(Tst)
+PICC_CODEC_DEFINE_SERVICE(Pwr)
+
+/*==================================================================================================
+ *                                         Host Stand-ins
+ *==================================================================================================*/
+
+sint8 PICC_SendEvent(uint8 providerId, uint8 eventId, uint8 consumerId,
+                     const uint8 *data, uint16 len, PICC_EventType_e withAck, uint8 channelId)
+{
+    (void)providerId;
+    (void)eventId;
+    (void)consumerId;
+    (void)data;
+    (void)len;
+    (void)withAck;
+    (void)channelId;
+    return 0;
+}
+
+sint8 PICC_RegisterMethodIdHandlerEx(uint8 localProviderId, uint8 methodId,
+                                     PICC_MethodCallback_t callback, uint8 flags)
+{
+    (void)localProviderId;
+    (void)methodId;
+    (void)callback;
+    (void)flags;
+    return 0;
+}
+
+sint8 PICC_SetMethodResponseSize(uint8 localProviderId, uint8 methodId, uint16 maxRspLen)
+{
+    (void)localProviderId;
+    (void)methodId;
+    (void)maxRspLen;
+    return 0;
+}
+
+uint8 Tst_Mixed_Handle(uint8 consumerId, const Tst_Mixed_t *req)
+{
+    (void)consumerId;
+    (void)req;
+    g_lastMethod = Tst_Mixed_ID;
+    return (uint8)PICC_RET_OK;
+}
+
+uint8 Tst_Tail_Handle(uint8 consumerId, const Tst_Tail_t *req)
+{
+    (void)consumerId;
+    g_lastMethod = Tst_Tail_ID;
+    g_lastInfoLen = req->tLen;
+    g_lastInfoWireLen = req->tWireLen;
+    return (uint8)PICC_RET_OK;
+}
+
+uint8 Pwr_StateAck_Handle(uint8 consumerId, const Pwr_StateAck_t *req)
+{
+    (void)consumerId;
+    g_lastMethod = Pwr_StateAck_ID;
+    g_lastInfoLen = req->infoLen;
+    g_lastInfoWireLen = req->infoWireLen;
+    return (uint8)PICC_RET_OK;
+}
+
+uint8 Pwr_EventDone_Handle(uint8 consumerId, const Pwr_EventDone_t *req)
+{
+    (void)consumerId;
+    (void)req;
+    g_lastMethod = Pwr_EventDone_ID;
+    return (uint8)PICC_RET_OK;
+}
+
+uint8 Pwr_CtrlAck_Handle(uint8 consumerId, const Pwr_CtrlAck_t *req)
+{
+    (void)consumerId;
+    (void)req;
+    g_lastMethod = Pwr_CtrlAck_ID;
+    return (uint8)PICC_RET_OK;
+}
+
+/*==================================================================================================
+ *                                         Test
+ *==================================================================================================*/
+
+static void Check(int cond, const char *what)
+{
+    if (!cond) {
+        printf("FAIL %s\n", what);
+        g_failures++;
+    }
+}
+
+int main(void)
+{
+    static const uint8 fixedWire[] = {0x11U, 0x22U, 0x33U, 0x44U, 0x55U, 0x66U, 0x77U,
+                                      0x01U, 0x02U, 0x03U};
+    static const uint8 longAck[] = {PWR_CORE_A, 0x03U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 9U, 10U};
+    Tst_Fixed_t fixed = {0};
+    Tst_Mixed_t mixed = {0};
+    Pwr_StateAck_t ack;
+    uint8 buf[32];
+    uint8 rsp[1];
+    uint16 rspLen = 0xFFFFU;
+
+    /* Generated round trips */
+    Check(Tst_SelfTest() == 0, "Tst_SelfTest");
+    Check(Pwr_SelfTest() == 0, "Pwr_SelfTest");
+
+    /* Wire layout: big-endian, list order */
+    fixed.a = 0x11U;
+    fixed.b = 0x2233U;
+    fixed.c = 0x44556677UL;
+    fixed.d[0] = 1U;
+    fixed.d[1] = 2U;
+    fixed.d[2] = 3U;
+    Check(Tst_Fixed_Encode(&fixed, buf, (uint16)sizeof(buf)) == (sint32)sizeof(fixedWire),
+          "fixed encode length");
+    Check(memcmp(buf, fixedWire, sizeof(fixedWire)) == 0, "fixed wire layout");
+    Check(Tst_Fixed_Encode(&fixed, buf, (uint16)(Tst_Fixed_MIN_SIZE - 1U)) < 0,
+          "fixed encode buffer too small");
+
+    /* VAR longer than its maximum is rejected both ways */
+    mixed.vLen = 6U;
+    Check(Tst_Mixed_Encode(&mixed, buf, (uint16)sizeof(buf)) < 0, "VAR encode above max");
+    buf[0] = 0U;
+    buf[1] = 0U;
+    buf[2] = 0U;
+    buf[3] = 6U;
+    Check(Tst_Mixed_Decode(&mixed, buf, 11U) < 0, "VAR decode above max");
+
+    /* TAIL longer than its maximum is truncated, not rejected */
+    Check(Pwr_StateAck_Decode(&ack, longAck, (uint16)sizeof(longAck)) == (sint32)sizeof(longAck),
+          "long ack consumed");
+    Check((ack.infoLen == (PWR_MAX_PAYLOAD_LEN - 2U)) &&
+          (ack.infoWireLen == (uint16)(sizeof(longAck) - 2U)), "long ack truncated");
+    Check((ack.info[0] == 1U) && (ack.info[5] == 6U), "long ack data");
+
+    /* ... and still reaches its handler */
+    g_lastMethod = 0U;
+    Check(Pwr_ServiceDispatch(PWR_CONSUMER_ID, (uint8)Pwr_StateAck_ID, longAck,
+                              (uint16)sizeof(longAck), rsp, &rspLen) == (uint8)PICC_RET_OK,
+          "long ack dispatch");
+    Check((g_lastMethod == Pwr_StateAck_ID) && (rspLen == 0U), "long ack handled");
+    Check((g_lastInfoLen == (PWR_MAX_PAYLOAD_LEN - 2U)) &&
+          (g_lastInfoWireLen == (uint16)(sizeof(longAck) - 2U)), "long ack lengths");
+
+    /* Short of the fixed fields, or unknown MethodID: PICC_RET_NOT_OK */
+    g_lastMethod = 0U;
+    Check(Pwr_ServiceDispatch(PWR_CONSUMER_ID, (uint8)Pwr_StateAck_ID, longAck, 1U,
+                              rsp, &rspLen) == (uint8)PICC_RET_NOT_OK, "short ack");
+    Check(Pwr_ServiceDispatch(PWR_CONSUMER_ID, 0xEEU, longAck, (uint16)sizeof(longAck),
+                              rsp, &rspLen) == (uint8)PICC_RET_NOT_OK, "unknown method");
+    Check(g_lastMethod == 0U, "no handler for rejected requests");
+
+    if (g_failures != 0) {
+        printf("test_picc_codec: %d failure(s)\n", g_failures);
+        return 1;
+    }
+    printf("test_picc_codec: OK\n");
+    return 0;
+}
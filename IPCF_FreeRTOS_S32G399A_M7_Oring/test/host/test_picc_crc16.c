@@ -0,0 +1,118 @@
+/**
+ * @file test_picc_crc16.c
+ * @brief Host test: CRC16 known answers for every engine (PICC_CalculateCRC16)
+ *
+ * Known-answer vectors of CRC-16/CCITT-FALSE, then random buffers (length,
+ * alignment and split point) checked against a bitwise reference. Run once
+ * per engine, PICC_CRC16_ENGINE = 0 (nibble), 1 (table), 4 and 8 (slicing).
+ *
+ * Build and run from this directory:
+ *   for e in 0 1 4 8; do
+ *     gcc -std=gnu99 -Wall -DIPCF_TYPES -DCPU_TYPE=64 -DDISABLE_MCAL_INTERMODULE_ASR_CHECK -Istub \
+ *         -I../../PICC/Picc_Deamon -I../../IPCF/src/common -I../../generate/include \
+ *         -DPICC_CRC16_ENGINE=$e test_picc_crc16.c ../../PICC/Picc_Deamon/picc_protocol.c \
+ *         -o test_picc_crc16 && ./test_picc_crc16
+ *   done
+ *
+ * Copyright 2024 NXP
+ * All Rights Reserved.
+ */
+
+#include <stdio.h>
+#include "picc_protocol.h"
+
+#define TEST_BUF_SIZE   (600U)
+#define TEST_RUNS       (20000UL)
+
+int g_hostErrors = 0;
+
+static int g_failures = 0;
+static uint32 g_seed = 12345U;
+
+static uint32 TestRand(void)
+{
+    g_seed = (g_seed * 1103515245U) + 12345U;
+    return (g_seed >> 8U);
+}
+
+static void Check(int cond, const char *what)
+{
+    if (!cond) {
+        printf("FAIL %s\n", what);
+        g_failures++;
+    }
+}
+
+/**
+ * @brief Bitwise CRC-CCITT reference (poly 0x1021, MSB first)
+ */
+static uint16 RefCrc16(uint16 crc, const uint8 *data, uint32 len)
+{
+    uint32 i;
+    uint8 bit;
+
+    for (i = 0U; i < len; i++) {
+        crc ^= (uint16)((uint16)data[i] << 8U);
+        for (bit = 0U; bit < 8U; bit++) {
+            crc = ((crc & 0x8000U) != 0U) ? (uint16)((crc << 1U) ^ 0x1021U) : (uint16)(crc << 1U);
+        }
+    }
+    return crc;
+}
+
+int main(void)
+{
+    static const uint8 check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    static const uint8 one = 'A';
+    static uint8 buf[TEST_BUF_SIZE];
+    uint32 n;
+    uint32 i;
+    uint32 off;
+    uint32 len;
+    uint32 split;
+    uint16 crc;
+    uint16 ref;
+
+    /* Known answers */
+    Check(PICC_CRC16(check, (uint32)sizeof(check)) == 0x29B1U, "check \"123456789\"");
+    Check(PICC_CRC16(check, 0U) == PICC_CRC16_START_VALUE, "empty");
+    Check(PICC_CRC16(&one, 1U) == 0xB915U, "one byte 'A'");
+    Check(PICC_CRC16(&buf[0], 1U) == 0xE1F0U, "one byte 0x00");
+    Check(PICC_CalculateCRC16(&check[4], 5U, FALSE, PICC_CRC16(check, 4U)) == 0x29B1U,
+          "check in two parts");
+
+    /* Random buffers against the bitwise reference */
+    for (n = 0U; n < TEST_RUNS; n++) {
+        for (i = 0U; i < TEST_BUF_SIZE; i++) {
+            buf[i] = (uint8)TestRand();
+        }
+        off = TestRand() % 8U;
+        len = TestRand() % (TEST_BUF_SIZE - off);
+        split = (len != 0U) ? (TestRand() % len) : 0U;
+
+        ref = RefCrc16(PICC_CRC16_START_VALUE, &buf[off], len);
+        if (PICC_CRC16(&buf[off], len) != ref) {
+            printf("FAIL random: offset %u length %u\n", (unsigned)off, (unsigned)len);
+            g_failures++;
+            break;
+        }
+
+        crc = PICC_CRC16(&buf[off], split);
+        crc = PICC_CalculateCRC16(&buf[off + split], len - split, FALSE, crc);
+        if (crc != ref) {
+            printf("FAIL random split: offset %u length %u split %u\n",
+                   (unsigned)off, (unsigned)len, (unsigned)split);
+            g_failures++;
+            break;
+        }
+    }
+
+    Check(g_hostErrors == 0, "no errors raised");
+
+    if (g_failures != 0) {
+        printf("test_picc_crc16 (engine %u): %d failure(s)\n", (unsigned)PICC_CRC16_ENGINE, g_failures);
+        return 1;
+    }
+    printf("test_picc_crc16 (engine %u): OK\n", (unsigned)PICC_CRC16_ENGINE);
+    return 0;
+}
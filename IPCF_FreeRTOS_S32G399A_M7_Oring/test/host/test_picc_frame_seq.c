@@ -0,0 +1,83 @@
+/**
+ * @file test_picc_frame_seq.c
+ * @brief Host test: received frame counter tracking (PICC_FrameSeqTrack)
+ *
+ * Build and run from this directory:
+ *   gcc -std=gnu99 -Wall -DIPCF_TYPES -DCPU_TYPE=64 -DDISABLE_MCAL_INTERMODULE_ASR_CHECK -Istub \
+ *       -I../../PICC/Picc_Deamon -I../../IPCF/src/common -I../../generate/include \
+ *       test_picc_frame_seq.c ../../PICC/Picc_Deamon/picc_protocol.c -o test_picc_frame_seq
+ *   ./test_picc_frame_seq
+ *
+ * Copyright 2024 NXP
+ * All Rights Reserved.
+ */
+
+#include <stdio.h>
+#include "picc_protocol.h"
+
+int g_hostErrors = 0;
+
+static int g_failures = 0;
+
+/**
+ * @brief Feed one counter and compare classification / missing frames
+ */
+static void Expect(PICC_FrameSeq_t *seq, uint16 counter,
+                   PICC_FrameSeqResult_e result, uint16 missing)
+{
+    uint16 gotMissing;
+    PICC_FrameSeqResult_e got = PICC_FrameSeqTrack(seq, counter, &gotMissing);
+
+    if ((got != result) || (gotMissing != missing)) {
+        printf("FAIL counter %u: result %d missing %u, expected %d missing %u\n",
+               (unsigned)counter, (int)got, (unsigned)gotMissing, (int)result, (unsigned)missing);
+        g_failures++;
+    }
+}
+
+int main(void)
+{
+    PICC_FrameSeq_t seq = {0};
+
+    /* Late frame and repeated frame after a gap */
+    Expect(&seq, 7U,  PICC_FRAME_SEQ_FIRST, 0U);
+    Expect(&seq, 9U,  PICC_FRAME_SEQ_GAP, 1U);
+    Expect(&seq, 10U, PICC_FRAME_SEQ_NEXT, 0U);
+    Expect(&seq, 8U,  PICC_FRAME_SEQ_LATE, 0U);
+    Expect(&seq, 9U,  PICC_FRAME_SEQ_DUPLICATE, 0U);
+    Expect(&seq, 8U,  PICC_FRAME_SEQ_DUPLICATE, 0U);
+    Expect(&seq, 10U, PICC_FRAME_SEQ_DUPLICATE, 0U);
+
+    /* Wrap: 0 is skipped, steps across it count one frame */
+    seq = (PICC_FrameSeq_t){0};
+    Expect(&seq, 0xFFFDU, PICC_FRAME_SEQ_FIRST, 0U);
+    Expect(&seq, 0xFFFFU, PICC_FRAME_SEQ_GAP, 1U);
+    Expect(&seq, 1U,      PICC_FRAME_SEQ_NEXT, 0U);
+    Expect(&seq, 3U,      PICC_FRAME_SEQ_GAP, 1U);
+    Expect(&seq, 0xFFFEU, PICC_FRAME_SEQ_LATE, 0U);
+    Expect(&seq, 0xFFFFU, PICC_FRAME_SEQ_DUPLICATE, 0U);
+    Expect(&seq, 1U,      PICC_FRAME_SEQ_DUPLICATE, 0U);
+    Expect(&seq, 2U,      PICC_FRAME_SEQ_LATE, 0U);
+    Expect(&seq, 0xFFFDU, PICC_FRAME_SEQ_DUPLICATE, 0U);
+
+    /* Same late / repeat pattern right after the wrap */
+    seq = (PICC_FrameSeq_t){0};
+    Expect(&seq, 0xFFFFU, PICC_FRAME_SEQ_FIRST, 0U);
+    Expect(&seq, 2U,      PICC_FRAME_SEQ_GAP, 1U);
+    Expect(&seq, 3U,      PICC_FRAME_SEQ_NEXT, 0U);
+    Expect(&seq, 1U,      PICC_FRAME_SEQ_LATE, 0U);
+    Expect(&seq, 2U,      PICC_FRAME_SEQ_DUPLICATE, 0U);
+
+    /* Remote restart: far behind the newest frame */
+    seq = (PICC_FrameSeq_t){0};
+    Expect(&seq, 1000U, PICC_FRAME_SEQ_FIRST, 0U);
+    Expect(&seq, 1U,    PICC_FRAME_SEQ_RESYNC, 0U);
+    Expect(&seq, 2U,    PICC_FRAME_SEQ_NEXT, 0U);
+
+    if (g_failures != 0) {
+        printf("test_picc_frame_seq: %d failure(s)\n", g_failures);
+        return 1;
+    }
+    printf("test_picc_frame_seq: OK\n");
+    return 0;
+}